@@ -57,6 +57,7 @@ macro(USE_COMPAT)
     check_function_exists(timegm HAVE_TIMEGM)
     check_symbol_exists(strptime "time.h" HAVE_STRPTIME)
     check_symbol_exists(mmap "sys/mman.h" HAVE_MMAP)
+    check_symbol_exists(writev "sys/uio.h" HAVE_WRITEV)
     check_symbol_exists(setenv "stdlib.h" HAVE_SETENV)
 
     list(REMOVE_ITEM CMAKE_REQUIRED_DEFINITIONS -D_POSIX_C_SOURCE=200809L)
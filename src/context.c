@@ -47,6 +47,7 @@
 #include "tree_schema.h"
 #include "tree_schema_free.h"
 #include "tree_schema_internal.h"
+#include "xpath.h"
 
 #include "../models/ietf-datastores@2018-02-14.h"
 #include "../models/ietf-inet-types@2013-07-15.h"
@@ -115,6 +116,9 @@ ly_ctx_set_searchdir(struct ly_ctx *ctx, const char *search_dir)
             return LY_EMEM;
         }
 
+        /* search dirs changed */
+        lys_search_index_free(ctx);
+
         /* new searchdir - reset latests flags (possibly new revisions available) */
         for (uint32_t v = 0; v < ctx->list.count; ++v) {
             struct lys_module *mod = ctx->list.objs[v];
@@ -165,6 +169,9 @@ ly_ctx_unset_searchdir(struct ly_ctx *ctx, const char *value)
         return LY_SUCCESS;
     }
 
+    /* search dirs changed */
+    lys_search_index_free(ctx);
+
     if (value) {
         /* remove specific search directory */
         uint32_t index;
@@ -194,6 +201,11 @@ ly_ctx_unset_searchdir_last(struct ly_ctx *ctx, uint32_t count)
 {
     LY_CHECK_ARG_RET(ctx, ctx, LY_EINVAL);
 
+    if (count && ctx->search_paths.count) {
+        /* search dirs changed */
+        lys_search_index_free(ctx);
+    }
+
     for ( ; count > 0 && ctx->search_paths.count; --count) {
         LY_CHECK_RET(ly_set_rm_index(&ctx->search_paths, ctx->search_paths.count - 1, free))
     }
@@ -284,6 +296,7 @@ ly_ctx_new(const char *search_dir, uint16_t options, struct ly_ctx **new_ctx)
     LY_ERR rc = LY_SUCCESS;
     struct lys_glob_unres unres = {0};
     ly_bool builtin_plugins_only;
+    pthread_mutexattr_t attr;
 
     LY_CHECK_ARG_RET(NULL, new_ctx, LY_EINVAL);
 
@@ -309,6 +322,18 @@ ly_ctx_new(const char *search_dir, uint16_t options, struct ly_ctx **new_ctx)
     /* init LYB hash lock */
     pthread_mutex_init(&ctx->lyb_hash_lock, NULL);
 
+    /* init compilation lock, recursive because it is held while compiling nested types and implemented modules */
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&ctx->compile_lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+
+    /* compile serially unless allowed otherwise */
+    ctx->compile_threads = 1;
+
+    /* init re-match() pattern cache lock */
+    pthread_mutex_init(&ctx->re_cache.lock, NULL);
+
     /* models list */
     ctx->flags = options;
     if (search_dir) {
@@ -373,6 +398,70 @@ cleanup:
     return rc;
 }
 
+/**
+ * @brief Parse the modules listed in yang library data from the search dirs in advance, in parallel if allowed.
+ *
+ * Modules not found in the search dirs, in YIN, or already in the context are skipped and loaded normally.
+ *
+ * @param[in] ctx Context to load the modules into.
+ * @param[in] yltree Yang library data tree.
+ * @param[in] xpath XPath selecting all the module list instances in @p yltree.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+ly_ctx_new_yl_preparse(struct ly_ctx *ctx, const struct lyd_node *yltree, const char *xpath)
+{
+    LY_ERR ret = LY_SUCCESS;
+    struct lyd_node *node;
+    struct ly_set *set = NULL;
+    struct lysp_preparsed *item;
+    const char *name, *revision;
+    char *path;
+    LYS_INFORMAT format;
+    uint32_t i;
+
+    if (ctx->compile_threads == 1) {
+        /* serial, the modules are parsed when loaded */
+        return LY_SUCCESS;
+    } else if ((ctx->flags & LY_CTX_DISABLE_SEARCHDIRS) || (ctx->imp_clb && !(ctx->flags & LY_CTX_PREFER_SEARCHDIRS))) {
+        /* the modules are not going to be loaded from the search dirs */
+        return LY_SUCCESS;
+    }
+
+    LY_CHECK_RET(lyd_find_xpath(yltree, xpath, &set));
+    for (i = 0; i < set->count; ++i) {
+        name = NULL;
+        revision = NULL;
+        LY_LIST_FOR(lyd_child(set->dnodes[i]), node) {
+            if (!strcmp(node->schema->name, "name")) {
+                name = lyd_get_value(node);
+            } else if (!strcmp(node->schema->name, "revision")) {
+                revision = lyd_get_value(node);
+            }
+        }
+        if (!name || ly_ctx_get_module(ctx, name, revision)) {
+            continue;
+        }
+
+        /* find the file the same way as when loading the module */
+        LY_CHECK_GOTO(ret = lys_search_localfile_ctx(ctx, name, revision, &path, &format), cleanup);
+        if (!path) {
+            continue;
+        } else if (format != LYS_IN_YANG) {
+            free(path);
+            continue;
+        }
+
+        LY_ARRAY_NEW_GOTO(ctx, ctx->preparsed, item, ret, cleanup);
+        item->path = path;
+    }
+    lys_preparse(ctx);
+
+cleanup:
+    ly_set_free(set, NULL);
+    return ret;
+}
+
 static LY_ERR
 ly_ctx_new_yl_legacy(struct ly_ctx *ctx, const struct lyd_node *yltree)
 {
@@ -388,6 +477,12 @@ ly_ctx_new_yl_legacy(struct ly_ctx *ctx, const struct lyd_node *yltree)
 
     LY_CHECK_RET(ret = lyd_find_xpath(yltree, "/ietf-yang-library:yang-library/modules-state/module", &set));
 
+    /* parse all the modules in advance in parallel, if allowed, including the imported ones */
+    if (set->count) {
+        LY_CHECK_GOTO(ret = ly_ctx_new_yl_preparse(ctx, yltree, "/ietf-yang-library:yang-library/modules-state/module"),
+                cleanup);
+    }
+
     /* process the data tree */
     for (i = 0; i < set->count; ++i) {
         module = set->dnodes[i];
@@ -525,6 +620,10 @@ ly_ctx_new_yldata(const char *search_dir, const struct lyd_node *tree, int optio
         /* perhaps a legacy data tree? */
         LY_CHECK_GOTO(ret = ly_ctx_new_yl_legacy(ctx_new, tree), cleanup);
     } else {
+        /* parse all the modules in advance in parallel, if allowed, including the import-only ones */
+        LY_CHECK_GOTO(ret = ly_ctx_new_yl_preparse(ctx_new, tree, "/ietf-yang-library:yang-library/module-set[1]/module | "
+                "/ietf-yang-library:yang-library/module-set[1]/import-only-module"), cleanup);
+
         /* process the data tree */
         for (i = 0; i < set->count; ++i) {
             module = set->dnodes[i];
@@ -577,6 +676,9 @@ ly_ctx_new_yldata(const char *search_dir, const struct lyd_node *tree, int optio
 cleanup:
     ly_set_free(set, NULL);
     ly_set_erase(&features, NULL);
+    if (ctx_new) {
+        lys_preparsed_free(ctx_new);
+    }
     if (*ctx == NULL) {
         *ctx = ctx_new;
         if (ret) {
@@ -609,6 +711,38 @@ cleanup:
     return ret;
 }
 
+LIBYANG_API_DEF LY_ERR
+ly_ctx_free_parsed(struct ly_ctx *ctx)
+{
+    struct lysf_ctx fctx = {.ctx = ctx};
+    struct lys_module *mod;
+    uint32_t i;
+
+    LY_CHECK_ARG_RET(ctx, ctx, LY_EINVAL);
+
+    if (ctx->flags & LY_CTX_SET_PRIV_PARSED) {
+        LOGERR(ctx, LY_EDENIED, "Unable to free parsed modules referenced by compiled nodes (LY_CTX_SET_PRIV_PARSED).");
+        return LY_EDENIED;
+    }
+    for (i = 0; i < ctx->list.count; ++i) {
+        mod = ctx->list.objs[i];
+        if (mod->to_compile) {
+            LOGERR(ctx, LY_EDENIED, "Unable to free parsed modules, module \"%s\" was not compiled yet.", mod->name);
+            return LY_EDENIED;
+        }
+    }
+
+    /* free the statements of all the modules */
+    for (i = 0; i < ctx->list.count; ++i) {
+        mod = ctx->list.objs[i];
+        lysp_module_free_stmts(&fctx, mod->parsed);
+    }
+    lysf_ctx_erase(&fctx);
+
+    ctx->parsed_freed = 1;
+    return LY_SUCCESS;
+}
+
 LIBYANG_API_DEF uint16_t
 ly_ctx_get_options(const struct ly_ctx *ctx)
 {
@@ -635,6 +769,11 @@ ly_ctx_set_options(struct ly_ctx *ctx, uint16_t option)
         return LY_EINVAL;
     }
 
+    if (!(ctx->flags & LY_CTX_SET_PRIV_PARSED) && (option & LY_CTX_SET_PRIV_PARSED) && ctx->parsed_freed) {
+        LOGERR(ctx, LY_EDENIED, "Unable to set LY_CTX_SET_PRIV_PARSED in a context with freed parsed modules.");
+        return LY_EDENIED;
+    }
+
     if (!(ctx->flags & LY_CTX_LEAFREF_LINKING) && (option & LY_CTX_LEAFREF_LINKING)) {
         ctx->leafref_links_ht = lyht_new(1, sizeof(struct lyd_leafref_links_rec), ly_ctx_ht_leafref_links_equal_cb, NULL, 1);
         LY_CHECK_ERR_RET(!ctx->leafref_links_ht, LOGARG(ctx, option), LY_EMEM);
@@ -651,6 +790,10 @@ ly_ctx_set_options(struct ly_ctx *ctx, uint16_t option)
         }
         lyrc = ly_ctx_compile(ctx);
         if (lyrc) {
+            /* do not leave the modules marked for recompilation */
+            for (i = 0; i < ctx->list.count; ++i) {
+                ((struct lys_module *)ctx->list.objs[i])->to_compile = 0;
+            }
             ly_ctx_unset_options(ctx, LY_CTX_SET_PRIV_PARSED);
         }
     }
@@ -759,6 +902,25 @@ ly_ctx_get_modules_hash(const struct ly_ctx *ctx)
     return hash;
 }
 
+LIBYANG_API_DEF void
+ly_ctx_get_re_cache_stats(const struct ly_ctx *ctx, uint32_t *hits, uint32_t *misses)
+{
+    struct ly_ctx_re_cache *cache;
+
+    LY_CHECK_ARG_RET(ctx, ctx, );
+
+    cache = (struct ly_ctx_re_cache *)&ctx->re_cache;
+
+    pthread_mutex_lock(&cache->lock);
+    if (hits) {
+        *hits = cache->hits;
+    }
+    if (misses) {
+        *misses = cache->misses;
+    }
+    pthread_mutex_unlock(&cache->lock);
+}
+
 LIBYANG_API_DEF ly_module_imp_clb
 ly_ctx_get_module_imp_clb(const struct ly_ctx *ctx, void **user_data)
 {
@@ -805,6 +967,104 @@ ly_ctx_set_ext_data_clb(struct ly_ctx *ctx, ly_ext_data_clb clb, void *user_data
     return prev;
 }
 
+LIBYANG_API_DEF void
+ly_ctx_set_compile_threads(struct ly_ctx *ctx, uint32_t threads)
+{
+    LY_CHECK_ARG_RET(ctx, ctx, );
+
+    ctx->compile_threads = threads;
+}
+
+LIBYANG_API_DEF LY_ERR
+ly_ctx_set_index(struct ly_ctx *ctx, const char *data_path, ly_bool output)
+{
+    LY_ERR ret = LY_SUCCESS;
+    const struct lysc_node *leaf, *list, *top;
+    struct ly_ctx_index *index = NULL;
+    struct lys_glob_unres *unres;
+    char *path = NULL;
+    LY_ARRAY_COUNT_TYPE u;
+
+    LY_CHECK_ARG_RET(ctx, ctx, data_path, LY_EINVAL);
+    unres = &ctx->unres;
+
+    leaf = lys_find_path(ctx, NULL, data_path, output);
+    if (!leaf) {
+        /* error logged */
+        return LY_ENOTFOUND;
+    } else if (leaf->nodetype != LYS_LEAF) {
+        LOGERR(ctx, LY_EINVAL, "Node \"%s\" is not a leaf.", leaf->name);
+        return LY_EINVAL;
+    }
+
+    list = lysc_data_parent(leaf);
+    if (!list || (list->nodetype != LYS_LIST)) {
+        LOGERR(ctx, LY_EINVAL, "Leaf \"%s\" is not a child of a list.", leaf->name);
+        return LY_EINVAL;
+    } else if (lysc_is_key(leaf)) {
+        LOGERR(ctx, LY_EINVAL, "Leaf \"%s\" is a list key, list instances are always found by their keys.", leaf->name);
+        return LY_EINVAL;
+    }
+
+    /* the canonical path of the leaf, any equivalent path is then a duplicate */
+    path = lysc_path(leaf, LYSC_PATH_DATA, NULL, 0);
+    LY_CHECK_ERR_RET(!path, LOGMEM(ctx), LY_EMEM);
+    LY_ARRAY_FOR(ctx->indexes, u) {
+        if ((ctx->indexes[u].output == output) && !strcmp(ctx->indexes[u].path, path)) {
+            /* already indexed, whether compiled or waiting for compilation */
+            ret = LY_EEXIST;
+            goto cleanup;
+        }
+    }
+    if (lys_find_path(ctx, NULL, path, output) != leaf) {
+        /* for example, the leaf is in an extension instance */
+        LOGERR(ctx, LY_EINVAL, "Leaf \"%s\" cannot be indexed.", leaf->name);
+        ret = LY_EINVAL;
+        goto cleanup;
+    }
+
+    if (ctx->parsed_freed) {
+        LOGERR(ctx, LY_EDENIED, "Unable to change module \"%s\" in a context with freed parsed modules.",
+                leaf->module->name);
+        ret = LY_EDENIED;
+        goto cleanup;
+    }
+
+    /* the compiled tree of the leaf */
+    for (top = leaf; top->parent; top = top->parent) {}
+
+    /* remember the leaf so that it is flagged on every compilation */
+    LY_ARRAY_NEW_GOTO(ctx, ctx->indexes, index, ret, cleanup);
+    index->mod = top->module;
+    index->path = path;
+    index->output = output;
+    path = NULL;
+
+    /* the module needs to be recompiled, which frees leaf */
+    index->mod->to_compile = 1;
+
+    if (!(ctx->flags & LY_CTX_EXPLICIT_COMPILE)) {
+        /* create dep set for the module and mark all the modules that will be (re)compiled */
+        ret = lys_unres_dep_sets_create(ctx, &unres->dep_sets, index->mod);
+
+        /* (re)compile the whole dep set */
+        if (!ret) {
+            ret = lys_compile_depset_all(ctx, unres);
+        }
+        if (ret) {
+            /* forget the index before any recompilation of the reverted modules */
+            free(index->path);
+            LY_ARRAY_DECREMENT_FREE(ctx->indexes);
+            lys_unres_glob_revert(ctx, unres);
+        }
+        lys_unres_glob_erase(unres);
+    }
+
+cleanup:
+    free(path);
+    return ret;
+}
+
 LIBYANG_API_DEF struct lys_module *
 ly_ctx_get_module_iter(const struct ly_ctx *ctx, uint32_t *index)
 {
@@ -1342,6 +1602,7 @@ LIBYANG_API_DEF void
 ly_ctx_destroy(struct ly_ctx *ctx)
 {
     struct lysf_ctx fctx = {.ctx = ctx};
+    LY_ARRAY_COUNT_TYPE u;
 
     if (!ctx) {
         return;
@@ -1366,10 +1627,17 @@ ly_ctx_destroy(struct ly_ctx *ctx)
 
     /* search paths list */
     ly_set_erase(&ctx->search_paths, free);
+    lys_search_index_free(ctx);
 
     /* leftover unres */
     lys_unres_glob_erase(&ctx->unres);
 
+    /* secondary indexes */
+    LY_ARRAY_FOR(ctx->indexes, u) {
+        free(ctx->indexes[u].path);
+    }
+    LY_ARRAY_FREE(ctx->indexes);
+
     /* clean the leafref links hash table */
     if (ctx->leafref_links_ht) {
         lyht_free(ctx->leafref_links_ht, ly_ctx_ht_leafref_links_rec_free);
@@ -1384,6 +1652,13 @@ ly_ctx_destroy(struct ly_ctx *ctx)
     /* LYB hash lock */
     pthread_mutex_destroy(&ctx->lyb_hash_lock);
 
+    /* compilation lock */
+    pthread_mutex_destroy(&ctx->compile_lock);
+
+    /* re-match() pattern cache */
+    lyxp_re_cache_clean(&ctx->re_cache);
+    pthread_mutex_destroy(&ctx->re_cache.lock);
+
     /* context specific plugins */
     ly_set_erase(&ctx->plugins_types, NULL);
     ly_set_erase(&ctx->plugins_extensions, NULL);
@@ -84,6 +84,12 @@ struct lys_module;
  * functions for instance data have \b lyd_ prefix. Details about data formats or handling data without the appropriate
  * YANG module in context can be found on @ref howtoData page.
  *
+ * A compiled context is a set of ordinary heap allocations referencing each other, plugin callbacks, and compiled
+ * regular expressions, so it cannot be placed into a shared memory segment and attached by other processes. A context
+ * created before forking is shared by the processes only as any other memory is, copy-on-write. Even read-only work
+ * with data writes into the context (strings are stored in its dictionary, compiled patterns are cached, errors
+ * are recorded, ...) so each process gradually gets its own copy of the affected pages.
+ *
  * Besides the YANG modules, context holds also [error information](@ref howtoErrors) and
  * [database of strings](@ref howtoContextDict), both connected with the processed YANG modules and data.
  *
@@ -108,6 +114,8 @@ struct lys_module;
  * - ::ly_ctx_unset_options()
  *
  * - ::ly_ctx_set_module_imp_clb()
+ * - ::ly_ctx_set_compile_threads()
+ * - ::ly_ctx_set_index()
  * - ::ly_ctx_get_module_imp_clb()
  *
  * - ::ly_ctx_load_module()
@@ -127,6 +135,8 @@ struct lys_module;
  *
  * - ::ly_ctx_get_change_count()
  * - ::ly_ctx_internal_modules_count()
+ * - ::ly_ctx_get_re_cache_stats()
+ * - ::ly_ctx_free_parsed()
  *
  * - ::lys_search_localfile()
  * - ::lys_set_implemented()
@@ -292,6 +302,23 @@ LIBYANG_API_DECL LY_ERR ly_ctx_new_ylmem(const char *search_dir, const char *dat
 LIBYANG_API_DECL LY_ERR ly_ctx_new_yldata(const char *search_dir, const struct lyd_node *tree, int options,
         struct ly_ctx **ctx);
 
+/**
+ * @brief Free the parsed statements of all the modules in the context to save memory.
+ *
+ * Only the compiled modules are needed for working with data so the parsed modules (::lys_module.parsed) can be reduced
+ * to their headers, linkage, revisions, extensions, features, and identities once the context is complete. These are still
+ * available and also ::ly_ctx_get_yanglib_data() works. However, the modules cannot be printed in any other format
+ * than ::LYS_OUT_YANG_COMPILED and the context cannot be changed anymore - no modules can be added, implemented,
+ * or have their features changed.
+ *
+ * Cannot be used with ::LY_CTX_SET_PRIV_PARSED.
+ *
+ * @param[in] ctx Context to use.
+ * @return LY_SUCCESS on success.
+ * @return LY_EDENIED if the parsed modules are still needed.
+ */
+LIBYANG_API_DECL LY_ERR ly_ctx_free_parsed(struct ly_ctx *ctx);
+
 /**
  * @brief Compile (recompile) the context applying all the performed changes after the last context compilation.
  * Should be used only if ::LY_CTX_EXPLICIT_COMPILE option is set, has no effect otherwise.
@@ -360,6 +387,7 @@ LIBYANG_API_DECL uint16_t ly_ctx_get_options(const struct ly_ctx *ctx);
  * @param[in] option Combination of the context's options to be set, see @ref contextoptions.
  * If there is to be a change to ::LY_CTX_SET_PRIV_PARSED, the context will be recompiled
  * and all ::lysc_node.priv in the modules will be overwritten, see ::LY_CTX_SET_PRIV_PARSED.
+ * It cannot be set after ::ly_ctx_free_parsed() and ::LY_EDENIED is returned.
  * @return LY_ERR value.
  */
 LIBYANG_API_DECL LY_ERR ly_ctx_set_options(struct ly_ctx *ctx, uint16_t option);
@@ -392,6 +420,18 @@ LIBYANG_API_DECL uint16_t ly_ctx_get_change_count(const struct ly_ctx *ctx);
  */
 LIBYANG_API_DECL uint32_t ly_ctx_get_modules_hash(const struct ly_ctx *ctx);
 
+/**
+ * @brief Get the statistics of the context cache of compiled XPath re-match() patterns.
+ *
+ * Every distinct pattern is compiled only once and then reused by all the evaluations until it is evicted
+ * from the cache, which happens only if the cache is full and the pattern was not used for the longest time.
+ *
+ * @param[in] ctx Context to be examined.
+ * @param[out] hits Optional number of pattern lookups served from the cache.
+ * @param[out] misses Optional number of pattern lookups that required the pattern to be compiled.
+ */
+LIBYANG_API_DECL void ly_ctx_get_re_cache_stats(const struct ly_ctx *ctx, uint32_t *hits, uint32_t *misses);
+
 /**
  * @brief Callback for freeing returned module data in #ly_module_imp_clb.
  *
@@ -472,6 +512,52 @@ typedef LY_ERR (*ly_ext_data_clb)(const struct lysc_ext_instance *ext, void *use
  */
 LIBYANG_API_DECL ly_ext_data_clb ly_ctx_set_ext_data_clb(struct ly_ctx *ctx, ly_ext_data_clb clb, void *user_data);
 
+/**
+ * @brief Set the maximum number of threads compiling the modules of a context.
+ *
+ * Modules that do not depend on each other (are in different dependency sets) can be compiled in parallel
+ * by several threads, which speeds up compiling contexts with many independent modules. Compilation is serial
+ * by default because the compile callbacks of extension plugins (::lyplg_ext_compile_clb) of different modules
+ * may then be called concurrently. Allow it only if all the extension plugins used by the context are thread-safe,
+ * which all the plugins included in libyang are. Resolving references between the modules (leafrefs, must and
+ * when conditions, default values, ...) including any type plugin callbacks is always performed serially.
+ *
+ * The same number of threads parse the modules in advance when they are loaded into the context by
+ * ::ly_ctx_new_yldata() (or ::ly_ctx_new_ylpath(), ::ly_ctx_new_ylmem()).
+ *
+ * @param[in] ctx Context to change.
+ * @param[in] threads Maximum number of threads, 1 for serial compilation (the default), 0 for one per online CPU.
+ */
+LIBYANG_API_DECL void ly_ctx_set_compile_threads(struct ly_ctx *ctx, uint32_t threads);
+
+/**
+ * @brief Create a secondary index of list instances based on the value of one of their leaves.
+ *
+ * The index is maintained for all the data instances of the list whose siblings have a hash table and used by
+ * ::lyd_find_sibling_leaf_val() as well as by XPath evaluation of equality predicates on the leaf. The hash table
+ * exists only for the children of a parent with at least ::LYD_HT_MIN_ITEMS children. Fewer list instances are
+ * searched by traversing all of them, which is cheap for so few nodes. Top-level list instances are never indexed
+ * and are always traversed, ::lyd_top_ht_new() is the only way to search top-level siblings using hashes.
+ *
+ * The index is a property of the context, the module of the leaf is recompiled (or marked for recompilation
+ * if ::LY_CTX_EXPLICIT_COMPILE is set) and the leaf remains indexed after any further recompilation.
+ *
+ * @warning The recompilation frees all the compiled nodes of the module and possibly of other modules depending
+ * on it, so any pointers to them become invalid. All the data trees of the context must be freed before calling
+ * this function.
+ *
+ * @param[in] ctx Context to use.
+ * @param[in] data_path Schema path of the leaf in a list to index in the data path format, cannot be a key.
+ * @param[in] output Whether to search in the output of an RPC or action instead of the input.
+ * @return LY_SUCCESS on success.
+ * @return LY_EEXIST if the leaf is already indexed, even if not yet compiled.
+ * @return LY_ENOTFOUND if @p data_path does not match any schema node.
+ * @return LY_EINVAL if @p data_path is not a non-key leaf of a list.
+ * @return LY_EDENIED if the parsed modules were freed by ::ly_ctx_free_parsed().
+ * @return LY_ERR on other errors during module compilation.
+ */
+LIBYANG_API_DECL LY_ERR ly_ctx_set_index(struct ly_ctx *ctx, const char *data_path, ly_bool output);
+
 /**
  * @brief Get YANG module of the given name and revision.
  *
@@ -479,6 +479,109 @@ lyd_diff_add(const struct lyd_node *node, enum lyd_diff_op op, const char *orig_
     return LY_SUCCESS;
 }
 
+/**
+ * @brief Record of the userord instance index hash table.
+ */
+struct lyd_diff_userord_rec {
+    const struct lyd_node *node;    /**< First tree instance. */
+    uint32_t idx;                   /**< Index of the instance in the instance array. */
+};
+
+/**
+ * @brief Callback for checking userord instance index record equality.
+ */
+static ly_bool
+lyd_diff_userord_ht_equal_cb(void *val1_p, void *val2_p, ly_bool UNUSED(mod), void *UNUSED(cb_data))
+{
+    struct lyd_diff_userord_rec *rec1 = val1_p, *rec2 = val2_p;
+
+    return rec1->node == rec2->node;
+}
+
+/**
+ * @brief Get hash of a userord instance for the instance index hash table.
+ *
+ * @param[in] node Instance to hash.
+ * @return Instance hash.
+ */
+static uint32_t
+lyd_diff_userord_hash(const struct lyd_node *node)
+{
+    uint32_t hash;
+
+    hash = lyht_hash_multi(0, (const char *)&node, sizeof node);
+    return lyht_hash_multi(hash, NULL, 0);
+}
+
+/**
+ * @brief Get the number of remaining (not yet ordered nor deleted) instances before an instance.
+ *
+ * @param[in] userord_item Userord item.
+ * @param[in] idx Index of the instance.
+ * @return Number of remaining instances with a lower index.
+ */
+static uint32_t
+lyd_diff_userord_rem_before(const struct lyd_diff_userord *userord_item, uint32_t idx)
+{
+    uint32_t i, count = 0;
+
+    for (i = idx; i; i -= i & -i) {
+        count += userord_item->rem_cnt[i - 1];
+    }
+
+    return count;
+}
+
+/**
+ * @brief Find the remaining instance with the specific rank.
+ *
+ * @param[in] userord_item Userord item.
+ * @param[in] rank Rank of the instance, number of remaining instances before it.
+ * @return Index of the instance.
+ */
+static uint32_t
+lyd_diff_userord_rem_find(const struct lyd_diff_userord *userord_item, uint32_t rank)
+{
+    uint32_t count, bit, idx = 0;
+
+    count = LY_ARRAY_COUNT(userord_item->inst);
+    bit = 1;
+    while (bit <= count / 2) {
+        bit <<= 1;
+    }
+
+    /* binary lifting, find the last index with at most rank remaining instances before and including it */
+    for ( ; bit; bit >>= 1) {
+        if ((idx + bit <= count) && (userord_item->rem_cnt[idx + bit - 1] <= rank)) {
+            idx += bit;
+            rank -= userord_item->rem_cnt[idx - 1];
+        }
+    }
+
+    assert(idx < count);
+    return idx;
+}
+
+/**
+ * @brief Remove an instance from the remaining instances.
+ *
+ * @param[in] userord_item Userord item.
+ * @param[in] idx Index of the instance.
+ */
+static void
+lyd_diff_userord_rem_remove(struct lyd_diff_userord *userord_item, uint32_t idx)
+{
+    uint32_t i, count;
+
+    assert(userord_item->inst[idx]);
+    userord_item->inst[idx] = NULL;
+
+    count = LY_ARRAY_COUNT(userord_item->inst);
+    for (i = idx + 1; i <= count; i += i & -i) {
+        --userord_item->rem_cnt[i - 1];
+    }
+}
+
 /**
  * @brief Get a userord entry for a specific user-ordered list/leaf-list. Create if does not exist yet.
  *
@@ -491,9 +594,11 @@ static struct lyd_diff_userord *
 lyd_diff_userord_get(const struct lyd_node *first, const struct lysc_node *schema, struct lyd_diff_userord **userord)
 {
     struct lyd_diff_userord *item;
+    struct lyd_diff_userord_rec rec;
     struct lyd_node *iter;
     const struct lyd_node **node;
     LY_ARRAY_COUNT_TYPE u;
+    uint32_t i, count;
 
     LY_ARRAY_FOR(*userord, u) {
         if ((*userord)[u].schema == schema) {
@@ -507,15 +612,43 @@ lyd_diff_userord_get(const struct lyd_node *first, const struct lysc_node *schem
     item->schema = schema;
     item->pos = 0;
     item->inst = NULL;
+    item->rem_cnt = NULL;
+    item->inst_ht = NULL;
+    item->head = 0;
+    item->last = NULL;
+
+    if (!first) {
+        return item;
+    }
 
     /* store all the instance pointers in the current order */
-    if (first) {
-        LYD_LIST_FOR_INST(lyd_first_sibling(first), first->schema, iter) {
-            LY_ARRAY_NEW_RET(schema->module->ctx, item->inst, node, NULL);
-            *node = iter;
+    LYD_LIST_FOR_INST(lyd_first_sibling(first), first->schema, iter) {
+        LY_ARRAY_NEW_RET(schema->module->ctx, item->inst, node, NULL);
+        *node = iter;
+    }
+    count = LY_ARRAY_COUNT(item->inst);
+
+    /* all the instances are remaining, build the tree in linear time */
+    item->rem_cnt = malloc(count * sizeof *item->rem_cnt);
+    LY_CHECK_RET(!item->rem_cnt, NULL);
+    for (i = 1; i <= count; ++i) {
+        item->rem_cnt[i - 1] = 1;
+    }
+    for (i = 1; i <= count; ++i) {
+        if (i + (i & -i) <= count) {
+            item->rem_cnt[i + (i & -i) - 1] += item->rem_cnt[i - 1];
         }
     }
 
+    /* index all the instances */
+    item->inst_ht = lyht_new(lyht_get_fixed_size(count), sizeof rec, lyd_diff_userord_ht_equal_cb, NULL, 1);
+    LY_CHECK_RET(!item->inst_ht, NULL);
+    for (i = 0; i < count; ++i) {
+        rec.node = item->inst[i];
+        rec.idx = i;
+        LY_CHECK_RET(lyht_insert(item->inst_ht, &rec, lyd_diff_userord_hash(rec.node), NULL), NULL);
+    }
+
     return item;
 }
 
@@ -546,8 +679,10 @@ lyd_diff_userord_attrs(const struct lyd_node *first, const struct lyd_node *seco
 {
     LY_ERR rc = LY_SUCCESS;
     const struct lysc_node *schema;
+    const struct lyd_node *first_prev;
+    struct lyd_diff_userord_rec rec, *rec_p;
     size_t buflen, bufused;
-    uint32_t first_pos, second_pos, comp_opts;
+    uint32_t first_idx, first_rank, first_pos, second_pos, comp_opts;
 
     assert(first || second);
 
@@ -564,18 +699,27 @@ lyd_diff_userord_attrs(const struct lyd_node *first, const struct lyd_node *seco
 
     /* find user-ordered first position */
     if (first) {
-        for (first_pos = 0; first_pos < LY_ARRAY_COUNT(userord_item->inst); ++first_pos) {
-            if (userord_item->inst[first_pos] == first) {
-                break;
-            }
+        rec.node = first;
+        if (!userord_item->inst_ht ||
+                lyht_find(userord_item->inst_ht, &rec, lyd_diff_userord_hash(first), (void **)&rec_p)) {
+            LOGINT_RET(schema->module->ctx);
         }
-        assert(first_pos < LY_ARRAY_COUNT(userord_item->inst));
+        first_idx = rec_p->idx;
+        assert(userord_item->inst[first_idx]);
+        first_rank = lyd_diff_userord_rem_before(userord_item, first_idx);
+        first_pos = userord_item->pos + first_rank;
     } else {
+        first_idx = 0;
+        first_rank = 0;
         first_pos = 0;
     }
 
     /* prepare position of the next instance */
-    second_pos = userord_item->pos++;
+    if (second) {
+        second_pos = userord_item->pos++;
+    } else {
+        second_pos = 0;
+    }
 
     /* learn operation first */
     if (!second) {
@@ -583,19 +727,39 @@ lyd_diff_userord_attrs(const struct lyd_node *first, const struct lyd_node *seco
     } else if (!first) {
         *op = LYD_DIFF_OP_CREATE;
     } else {
+        /* find the instance in first on the second position */
+        while (!userord_item->inst[userord_item->head]) {
+            ++userord_item->head;
+        }
+
         comp_opts = lysc_is_dup_inst_list(second->schema) ? LYD_COMPARE_FULL_RECURSION : 0;
-        if (lyd_compare_single(second, userord_item->inst[second_pos], comp_opts)) {
+        if (lyd_compare_single(second, userord_item->inst[userord_item->head], comp_opts)) {
             /* in first, there is a different instance on the second position, we are going to move 'first' node */
             *op = LYD_DIFF_OP_REPLACE;
-        } else if ((options & LYD_DIFF_DEFAULTS) && ((first->flags & LYD_DEFAULT) != (second->flags & LYD_DEFAULT))) {
-            /* default flag change */
-            *op = LYD_DIFF_OP_NONE;
         } else {
-            /* no changes */
-            return LY_ENOT;
+            /* the instance stays on its position */
+            userord_item->last = userord_item->inst[userord_item->head];
+            lyd_diff_userord_rem_remove(userord_item, userord_item->head);
+
+            if ((options & LYD_DIFF_DEFAULTS) && ((first->flags & LYD_DEFAULT) != (second->flags & LYD_DEFAULT))) {
+                /* default flag change */
+                *op = LYD_DIFF_OP_NONE;
+            } else {
+                /* no changes */
+                return LY_ENOT;
+            }
         }
     }
 
+    /* learn the instance preceding the first position */
+    if (!first_pos) {
+        first_prev = NULL;
+    } else if (first_rank) {
+        first_prev = userord_item->inst[lyd_diff_userord_rem_find(userord_item, first_rank - 1)];
+    } else {
+        first_prev = userord_item->last;
+    }
+
     /*
      * set each attribute correctly based on the operation and node type
      */
@@ -613,7 +777,7 @@ lyd_diff_userord_attrs(const struct lyd_node *first, const struct lyd_node *seco
     if ((schema->nodetype == LYS_LEAFLIST) && !lysc_is_dup_inst_list(schema) &&
             ((*op == LYD_DIFF_OP_REPLACE) || (*op == LYD_DIFF_OP_CREATE))) {
         if (second_pos) {
-            *value = strdup(lyd_get_value(userord_item->inst[second_pos - 1]));
+            *value = strdup(lyd_get_value(userord_item->last));
             LY_CHECK_ERR_GOTO(!*value, LOGMEM(schema->module->ctx); rc = LY_EMEM, cleanup);
         } else {
             *value = strdup("");
@@ -625,7 +789,7 @@ lyd_diff_userord_attrs(const struct lyd_node *first, const struct lyd_node *seco
     if ((schema->nodetype == LYS_LEAFLIST) && !lysc_is_dup_inst_list(schema) &&
             ((*op == LYD_DIFF_OP_REPLACE) || (*op == LYD_DIFF_OP_DELETE))) {
         if (first_pos) {
-            *orig_value = strdup(lyd_get_value(userord_item->inst[first_pos - 1]));
+            *orig_value = strdup(lyd_get_value(first_prev));
             LY_CHECK_ERR_GOTO(!*orig_value, LOGMEM(schema->module->ctx); rc = LY_EMEM, cleanup);
         } else {
             *orig_value = strdup("");
@@ -638,7 +802,7 @@ lyd_diff_userord_attrs(const struct lyd_node *first, const struct lyd_node *seco
             ((*op == LYD_DIFF_OP_REPLACE) || (*op == LYD_DIFF_OP_CREATE))) {
         if (second_pos) {
             buflen = bufused = 0;
-            LY_CHECK_GOTO(rc = lyd_path_list_predicate(userord_item->inst[second_pos - 1], key, &buflen, &bufused, 0), cleanup);
+            LY_CHECK_GOTO(rc = lyd_path_list_predicate(userord_item->last, key, &buflen, &bufused, 0), cleanup);
         } else {
             *key = strdup("");
             LY_CHECK_ERR_GOTO(!*key, LOGMEM(schema->module->ctx); rc = LY_EMEM, cleanup);
@@ -650,7 +814,7 @@ lyd_diff_userord_attrs(const struct lyd_node *first, const struct lyd_node *seco
             ((*op == LYD_DIFF_OP_REPLACE) || (*op == LYD_DIFF_OP_DELETE))) {
         if (first_pos) {
             buflen = bufused = 0;
-            LY_CHECK_GOTO(rc = lyd_path_list_predicate(userord_item->inst[first_pos - 1], orig_key, &buflen, &bufused, 0), cleanup);
+            LY_CHECK_GOTO(rc = lyd_path_list_predicate(first_prev, orig_key, &buflen, &bufused, 0), cleanup);
         } else {
             *orig_key = strdup("");
             LY_CHECK_ERR_GOTO(!*orig_key, LOGMEM(schema->module->ctx); rc = LY_EMEM, cleanup);
@@ -690,27 +854,14 @@ lyd_diff_userord_attrs(const struct lyd_node *first, const struct lyd_node *seco
      */
     if (*op == LYD_DIFF_OP_CREATE) {
         /* insert the instance */
-        LY_ARRAY_CREATE_GOTO(schema->module->ctx, userord_item->inst, 1, rc, cleanup);
-        if (second_pos < LY_ARRAY_COUNT(userord_item->inst)) {
-            memmove(userord_item->inst + second_pos + 1, userord_item->inst + second_pos,
-                    (LY_ARRAY_COUNT(userord_item->inst) - second_pos) * sizeof *userord_item->inst);
-        }
-        LY_ARRAY_INCREMENT(userord_item->inst);
-        userord_item->inst[second_pos] = second;
-
+        userord_item->last = second;
     } else if (*op == LYD_DIFF_OP_DELETE) {
         /* remove the instance */
-        if (first_pos + 1 < LY_ARRAY_COUNT(userord_item->inst)) {
-            memmove(userord_item->inst + first_pos, userord_item->inst + first_pos + 1,
-                    (LY_ARRAY_COUNT(userord_item->inst) - first_pos - 1) * sizeof *userord_item->inst);
-        }
-        LY_ARRAY_DECREMENT(userord_item->inst);
-
+        lyd_diff_userord_rem_remove(userord_item, first_idx);
     } else if (*op == LYD_DIFF_OP_REPLACE) {
-        /* move the instances */
-        memmove(userord_item->inst + second_pos + 1, userord_item->inst + second_pos,
-                (first_pos - second_pos) * sizeof *userord_item->inst);
-        userord_item->inst[second_pos] = first;
+        /* move the instance */
+        lyd_diff_userord_rem_remove(userord_item, first_idx);
+        userord_item->last = first;
     }
 
 cleanup:
@@ -1066,6 +1217,8 @@ cleanup:
     lyd_dup_inst_free(dup_inst_second);
     LY_ARRAY_FOR(userord, u) {
         LY_ARRAY_FREE(userord[u].inst);
+        free(userord[u].rem_cnt);
+        lyht_free(userord[u].inst_ht, NULL);
     }
     LY_ARRAY_FREE(userord);
     return ret;
@@ -19,15 +19,25 @@
 
 #include "log.h"
 
+struct ly_ht;
 struct lyd_node;
 
 /**
  * @brief Internal structure for storing current (virtual) user-ordered instances order.
+ *
+ * The virtual order always consists of the first @p pos instances already ordered as in the second tree
+ * followed by all the remaining first tree instances in their original order.
  */
 struct lyd_diff_userord {
     const struct lysc_node *schema; /**< User-ordered list/leaf-list schema node. */
-    uint64_t pos;                   /**< Current position in the second tree. */
-    const struct lyd_node **inst;   /**< Sized array of current instance order. */
+    uint64_t pos;                   /**< Current position in the second tree, number of ordered instances. */
+    const struct lyd_node **inst;   /**< Sized array of first tree instances in their original order, ordered and
+                                         deleted instances are set to NULL. */
+    uint32_t *rem_cnt;              /**< Binary indexed tree (Fenwick tree) of remaining instances in @p inst,
+                                         1-based with LY_ARRAY_COUNT(inst) items. */
+    struct ly_ht *inst_ht;          /**< Hash table of indices of the instances in @p inst. */
+    uint32_t head;                  /**< Index of the first remaining instance in @p inst. */
+    const struct lyd_node *last;    /**< Last ordered instance, on position @p pos - 1. */
 };
 
 /**
@@ -55,14 +55,17 @@ lyht_hash(const char *key, size_t len)
     return lyht_hash_multi(hash, NULL, len);
 }
 
-static LY_ERR
-lyht_init_hlists_and_records(struct ly_ht *ht)
+/**
+ * @brief Chain all the records as free and empty all the hlists.
+ *
+ * @param[in] ht Hash table with allocated records and hlists.
+ */
+static void
+lyht_reset_hlists_and_records(struct ly_ht *ht)
 {
     struct ly_ht_rec *rec;
     uint32_t i;
 
-    ht->recs = calloc(ht->size, ht->rec_size);
-    LY_CHECK_ERR_RET(!ht->recs, LOGMEM(NULL), LY_EMEM);
     for (i = 0; i < ht->size; i++) {
         rec = lyht_get_rec(ht->recs, ht->rec_size, i);
         if (i != ht->size) {
@@ -72,13 +75,23 @@ lyht_init_hlists_and_records(struct ly_ht *ht)
         }
     }
 
-    ht->hlists = malloc(sizeof(ht->hlists[0]) * ht->size);
-    LY_CHECK_ERR_RET(!ht->hlists, free(ht->recs); LOGMEM(NULL), LY_EMEM);
     for (i = 0; i < ht->size; i++) {
         ht->hlists[i].first = LYHT_NO_RECORD;
         ht->hlists[i].last = LYHT_NO_RECORD;
     }
     ht->first_free_rec = 0;
+}
+
+static LY_ERR
+lyht_init_hlists_and_records(struct ly_ht *ht)
+{
+    ht->recs = calloc(ht->size, ht->rec_size);
+    LY_CHECK_ERR_RET(!ht->recs, LOGMEM(NULL), LY_EMEM);
+
+    ht->hlists = malloc(sizeof(ht->hlists[0]) * ht->size);
+    LY_CHECK_ERR_RET(!ht->hlists, free(ht->recs); LOGMEM(NULL), LY_EMEM);
+
+    lyht_reset_hlists_and_records(ht);
 
     return LY_SUCCESS;
 }
@@ -147,12 +160,46 @@ lyht_dup(const struct ly_ht *orig)
         return NULL;
     }
 
-    memcpy(ht->hlists, orig->hlists, sizeof(ht->hlists[0]) * orig->size);
-    memcpy(ht->recs, orig->recs, (size_t)orig->size * orig->rec_size);
-    ht->used = orig->used;
+    lyht_copy(ht, orig);
     return ht;
 }
 
+LY_ERR
+lyht_copy(struct ly_ht *trg, const struct ly_ht *orig)
+{
+    void *ptr;
+
+    assert(trg->rec_size == orig->rec_size);
+
+    if (trg->size < orig->size) {
+        /* only ever enlarge the memory, the table stays consistent if any allocation fails */
+        ptr = realloc(trg->recs, (size_t)orig->size * orig->rec_size);
+        LY_CHECK_ERR_RET(!ptr, LOGMEM(NULL), LY_EMEM);
+        trg->recs = ptr;
+
+        ptr = realloc(trg->hlists, sizeof(trg->hlists[0]) * orig->size);
+        LY_CHECK_ERR_RET(!ptr, LOGMEM(NULL), LY_EMEM);
+        trg->hlists = ptr;
+    }
+
+    trg->size = orig->size;
+    trg->val_equal = orig->val_equal;
+    trg->cb_data = orig->cb_data;
+    trg->resize = orig->resize;
+    memcpy(trg->hlists, orig->hlists, sizeof(trg->hlists[0]) * orig->size);
+    memcpy(trg->recs, orig->recs, (size_t)orig->size * orig->rec_size);
+    trg->used = orig->used;
+    trg->first_free_rec = orig->first_free_rec;
+    return LY_SUCCESS;
+}
+
+void
+lyht_clear(struct ly_ht *ht)
+{
+    lyht_reset_hlists_and_records(ht);
+    ht->used = 0;
+}
+
 LIBYANG_API_DEF void
 lyht_free(struct ly_ht *ht, void (*val_free)(void *val_p))
 {
@@ -113,6 +113,23 @@ lyht_get_rec(unsigned char *recs, uint16_t rec_size, uint32_t idx)
     for (hlist_idx = 0; hlist_idx < ht->size; hlist_idx++)           \
         LYHT_ITER_HLIST_RECS(ht, hlist_idx, rec_idx, rec)
 
+/**
+ * @brief Copy all the values of a hash table into another one, replacing its whole content.
+ *
+ * @param[in] trg Hash table to copy into, its memory is reused if large enough. Must have the same record size
+ * as @p orig.
+ * @param[in] orig Hash table to copy.
+ * @return LY_ERR value, @p trg is left unmodified on error.
+ */
+LY_ERR lyht_copy(struct ly_ht *trg, const struct ly_ht *orig);
+
+/**
+ * @brief Remove all the values from a hash table but keep its memory so that it can be reused.
+ *
+ * @param[in] ht Hash table to clear.
+ */
+void lyht_clear(struct ly_ht *ht);
+
 /**
  * @brief Dictionary hash table record.
  */
@@ -155,6 +155,10 @@ extern "C" {
  * Thread-safe functions include any ones working with data trees (only context dictionary is accessed) and all
  * the `ly_ctx_get_*()` functions. Generally, they are the functions with `const` context parameter.
  *
+ * Modules are compiled by a single thread unless allowed otherwise by ::ly_ctx_set_compile_threads(). Then, compile
+ * callbacks of extension plugins (::lyplg_ext_compile_clb) may be called concurrently for different modules
+ * so custom extension plugins must be thread-safe to be used with parallel compilation.
+ *
  * @section data Data Trees
  *
  * Data trees are not internally synchronized so the general safe practice of a single writer **or** several concurrent
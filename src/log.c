@@ -198,20 +198,21 @@ ly_err_get_rec(const struct ly_ctx *ctx)
 }
 
 /**
- * @brief Insert new error record to error hash table of a context for the current thread.
+ * @brief Insert new error record to error hash table of a context for a thread.
  *
  * @param[in] ctx Context to use.
+ * @param[in] tid Thread ID of the record.
  * @return Thread error record.
  */
 static struct ly_ctx_err_rec *
-ly_err_new_rec(const struct ly_ctx *ctx)
+ly_err_new_rec(const struct ly_ctx *ctx, pthread_t tid)
 {
     struct ly_ctx_err_rec new, *rec;
     LY_ERR r;
 
     /* insert a new record */
     new.err = NULL;
-    new.tid = pthread_self();
+    new.tid = tid;
 
     /* reuse lock */
     /* LOCK */
@@ -268,7 +269,7 @@ ly_err_move(struct ly_ctx *src_ctx, struct ly_ctx *trg_ctx)
 
     /* set them for trg */
     if (!(rec = ly_err_get_rec(trg_ctx))) {
-        if (!(rec = ly_err_new_rec(trg_ctx))) {
+        if (!(rec = ly_err_new_rec(trg_ctx, pthread_self()))) {
             LOGINT(NULL);
             ly_err_free(err);
             return;
@@ -278,6 +279,59 @@ ly_err_move(struct ly_ctx *src_ctx, struct ly_ctx *trg_ctx)
     rec->err = err;
 }
 
+LY_ERR
+ly_err_thread_rec(const struct ly_ctx *ctx, pthread_t tid)
+{
+    struct ly_ctx_err_rec rec;
+
+    rec.tid = tid;
+    if (!lyht_find(ctx->err_ht, &rec, lyht_hash((void *)&rec.tid, sizeof rec.tid), NULL)) {
+        /* already exists */
+        return LY_SUCCESS;
+    }
+
+    return ly_err_new_rec(ctx, tid) ? LY_SUCCESS : LY_EMEM;
+}
+
+void
+ly_err_thread_rec_free(const struct ly_ctx *ctx, pthread_t tid)
+{
+    struct ly_ctx_err_rec rec, *match;
+    uint32_t hash;
+
+    rec.tid = tid;
+    hash = lyht_hash((void *)&rec.tid, sizeof rec.tid);
+    if (lyht_find(ctx->err_ht, &rec, hash, (void **)&match)) {
+        /* no record */
+        return;
+    }
+    ly_err_free(match->err);
+
+    /* reuse lock */
+    /* LOCK */
+    pthread_mutex_lock((pthread_mutex_t *)&ctx->lyb_hash_lock);
+
+    lyht_remove(ctx->err_ht, &rec, hash);
+
+    /* UNLOCK */
+    pthread_mutex_unlock((pthread_mutex_t *)&ctx->lyb_hash_lock);
+}
+
+struct ly_err_item *
+ly_err_take(const struct ly_ctx *ctx)
+{
+    struct ly_ctx_err_rec *rec;
+    struct ly_err_item *err;
+
+    if (!(rec = ly_err_get_rec(ctx))) {
+        return NULL;
+    }
+
+    err = rec->err;
+    rec->err = NULL;
+    return err;
+}
+
 LIBYANG_API_DEF void
 ly_err_free(void *ptr)
 {
@@ -469,7 +523,7 @@ log_store(const struct ly_ctx *ctx, LY_LOG_LEVEL level, LY_ERR err, LY_VECODE ve
     assert(ctx && (level < LY_LLVRB));
 
     if (!(rec = ly_err_get_rec(ctx))) {
-        if (!(rec = ly_err_new_rec(ctx))) {
+        if (!(rec = ly_err_new_rec(ctx, pthread_self()))) {
             goto mem_fail;
         }
     }
@@ -638,6 +638,20 @@ ly_munmap(void *addr, size_t length)
 
 #endif
 
+uint32_t
+ly_cpu_count(void)
+{
+#ifdef _SC_NPROCESSORS_ONLN
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+    if (cpus > 1) {
+        return cpus;
+    }
+#endif
+
+    return 1;
+}
+
 LY_ERR
 ly_strcat(char **dest, const char *format, ...)
 {
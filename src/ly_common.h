@@ -33,6 +33,8 @@
 struct ly_ctx;
 struct ly_in;
 struct lysc_node;
+struct lysp_preparsed;
+struct lys_search_index;
 
 #if __STDC_VERSION__ >= 201112 && !defined __STDC_NO_THREADS__
 # define THREAD_LOCAL _Thread_local
@@ -115,6 +117,35 @@ void ly_vlog(const struct ly_ctx *ctx, const char *apptag, LY_VECODE code, const
  */
 void ly_err_move(struct ly_ctx *src_ctx, struct ly_ctx *trg_ctx);
 
+/**
+ * @brief Create the error record of a thread in a context in advance.
+ *
+ * Creating the record modifies the context so it must not be done by threads logging concurrently.
+ *
+ * @param[in] ctx Context to use.
+ * @param[in] tid Thread ID of the record.
+ * @return LY_ERR value.
+ */
+LY_ERR ly_err_thread_rec(const struct ly_ctx *ctx, pthread_t tid);
+
+/**
+ * @brief Remove all the error items of the current thread from a context.
+ *
+ * @param[in] ctx Context to use.
+ * @return Removed error items, if any.
+ */
+struct ly_err_item *ly_err_take(const struct ly_ctx *ctx);
+
+/**
+ * @brief Remove the error record of a finished thread from a context, with all its error items.
+ *
+ * Removing the record modifies the context so it must not be done by threads logging concurrently.
+ *
+ * @param[in] ctx Context to use.
+ * @param[in] tid Thread ID of the record.
+ */
+void ly_err_thread_rec_free(const struct ly_ctx *ctx, pthread_t tid);
+
 /**
  * @brief Logger location data setter.
  *
@@ -336,6 +367,26 @@ struct ly_ctx_err_rec {
     pthread_t tid;                    /** pthread thread ID */
 };
 
+/**
+ * @brief Context secondary index of list instances, see ::ly_ctx_set_index().
+ */
+struct ly_ctx_index {
+    struct lys_module *mod;           /**< module with the compiled tree of the indexed leaf */
+    char *path;                       /**< data path of the indexed leaf */
+    ly_bool output;                   /**< whether the leaf is in the output of an RPC/action */
+};
+
+/**
+ * @brief Context cache of compiled XPath re-match() patterns.
+ */
+struct ly_ctx_re_cache {
+    pthread_mutex_t lock;             /**< lock for accessing the cache */
+    struct ly_ht *ht;                 /**< hash table of cached patterns (struct lyxp_re_cache_rec *), created on first use */
+    uint32_t clock;                   /**< logical time incremented on every cache access, used for LRU eviction */
+    uint32_t hits;                    /**< number of lookups that found a compiled pattern */
+    uint32_t misses;                  /**< number of lookups that had to compile the pattern */
+};
+
 /**
  * @brief Context of the YANG schemas
  */
@@ -355,9 +406,22 @@ struct ly_ctx {
     void *ext_clb_data;               /**< optional private data for ::ly_ctx.ext_clb */
     struct ly_ht *err_ht;             /**< hash table of thread-specific list of errors related to the context */
     pthread_mutex_t lyb_hash_lock;    /**< lock for storing LYB schema hashes in schema nodes */
+    pthread_mutex_t compile_lock;     /**< recursive lock for compiled typedefs, extension definitions, and groupings
+                                           shared by dependency sets compiled in parallel, see ::lys_compile_depset_all() */
+    uint32_t compile_threads;         /**< maximum number of threads compiling dependency sets, 0 for one per online CPU,
+                                           see ::ly_ctx_set_compile_threads() */
     struct ly_ht *leafref_links_ht;   /**< hash table of leafref links between term data nodes */
     struct ly_set plugins_types;      /**< context specific set of type plugins */
     struct ly_set plugins_extensions; /**< contets specific set of extension plugins */
+    struct ly_ctx_re_cache re_cache;  /**< cache of compiled XPath re-match() patterns */
+    uint32_t ident_count;             /**< number of identities created in the context, next ::lysc_ident.index */
+    struct lysp_preparsed *preparsed; /**< sized array of modules parsed in advance, used only while creating
+                                           the context */
+    struct lys_search_index *search_index; /**< index of the (sub)module files in the search dirs, created on first use */
+    ly_bool parsed_freed;             /**< whether the parsed statements were freed by ::ly_ctx_free_parsed(), the schemas
+                                           cannot be changed then */
+    struct ly_ctx_index *indexes;     /**< sized array of secondary indexes of list instances, the indexed leaves are
+                                           flagged whenever their module is (re)compiled */
 };
 
 /**
@@ -661,6 +725,13 @@ LY_ERR ly_mmap(struct ly_ctx *ctx, int fd, size_t *length, void **addr);
  */
 LY_ERR ly_munmap(void *addr, size_t length);
 
+/**
+ * @brief Get the number of online CPUs to use for parallel processing.
+ *
+ * @return Number of CPUs, 1 if it cannot be learned.
+ */
+uint32_t ly_cpu_count(void);
+
 /**
  * @brief Concatenate formating string to the @p dest.
  *
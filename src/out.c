@@ -40,6 +40,21 @@
 #define REALLOC_CHUNK(NEW_SIZE) \
     NEW_SIZE + (1024 - (NEW_SIZE % 1024))
 
+/**
+ * @brief Maximum number of pending chunks of the scatter-gather outputs, well below the usual IOV_MAX.
+ */
+#define LY_OUT_IOV_COUNT 128
+
+/**
+ * @brief Size of the buffer for the copied chunks of the scatter-gather outputs.
+ */
+#define LY_OUT_IOV_BUF_SIZE 16384
+
+/**
+ * @brief Minimal length of a chunk to be referenced instead of copied by the scatter-gather outputs.
+ */
+#define LY_OUT_IOV_REF_MIN 64
+
 LIBYANG_API_DEF ly_bool
 lyd_node_should_print(const struct lyd_node *node, uint32_t options)
 {
@@ -148,17 +163,207 @@ ly_out_clb_arg(struct ly_out *out, void *arg)
 {
     void *prev_arg;
 
-    LY_CHECK_ARG_RET(NULL, out, out->type == LY_OUT_CALLBACK, NULL);
+    LY_CHECK_ARG_RET(NULL, out, (out->type == LY_OUT_CALLBACK) || (out->type == LY_OUT_CALLBACK_IOV), NULL);
 
-    prev_arg = out->method.clb.arg;
-
-    if (arg) {
-        out->method.clb.arg = arg;
+    if (out->type == LY_OUT_CALLBACK_IOV) {
+        prev_arg = out->method.iov.arg;
+        if (arg) {
+            out->method.iov.arg = arg;
+        }
+    } else {
+        prev_arg = out->method.clb.arg;
+        if (arg) {
+            out->method.clb.arg = arg;
+        }
     }
 
     return prev_arg;
 }
 
+/**
+ * @brief Write all the pending chunks of a scatter-gather output.
+ *
+ * The pending chunks are dropped even in case of an error.
+ *
+ * @param[in] out Scatter-gather output.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+ly_out_iov_flush(struct ly_out *out)
+{
+    LY_ERR ret = LY_SUCCESS;
+    struct iovec *vec = out->method.iov.vec;
+    int count = out->method.iov.count;
+    size_t total = 0;
+    ssize_t r;
+    int i;
+
+    if (out->type == LY_OUT_CALLBACK_IOV) {
+        if (!count) {
+            return LY_SUCCESS;
+        }
+
+        for (i = 0; i < count; ++i) {
+            total += vec[i].iov_len;
+        }
+        r = out->method.iov.func(out->method.iov.arg, vec, count);
+        if (r < 0) {
+            LOGERR(NULL, LY_ESYS, "%s: writing data failed (%s).", __func__, strerror(errno));
+            ret = LY_ESYS;
+        } else if ((size_t)r != total) {
+            LOGERR(NULL, LY_ESYS, "%s: writing data failed (unable to write %" PRIu32 " from %" PRIu32 " data).", __func__,
+                    (uint32_t)(total - r), (uint32_t)total);
+            ret = LY_ESYS;
+        }
+    } else {
+        while (count) {
+#ifdef HAVE_WRITEV
+            r = writev(out->method.iov.fd, vec, count);
+#else
+            r = write(out->method.iov.fd, vec->iov_base, vec->iov_len);
+#endif
+            if (r < 0) {
+                if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR)) {
+                    continue;
+                }
+                LOGERR(NULL, LY_ESYS, "%s: writing data failed (%s).", __func__, strerror(errno));
+                ret = LY_ESYS;
+                break;
+            }
+
+            /* skip the written chunks, the last one may be written only partially */
+            while (count && ((size_t)r >= vec->iov_len)) {
+                r -= vec->iov_len;
+                ++vec;
+                --count;
+            }
+            if (count) {
+                vec->iov_base = (char *)vec->iov_base + r;
+                vec->iov_len -= r;
+            }
+        }
+    }
+
+    out->method.iov.count = 0;
+    out->method.iov.len = 0;
+    return ret;
+}
+
+/**
+ * @brief Add a chunk referencing data to a scatter-gather output.
+ *
+ * @param[in] out Scatter-gather output.
+ * @param[in] buf Data to reference, must not change until the pending chunks are written.
+ * @param[in] len Length of @p buf.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+ly_out_iov_ref(struct ly_out *out, const char *buf, size_t len)
+{
+    struct iovec *vec;
+
+    if (out->method.iov.count == LY_OUT_IOV_COUNT) {
+        LY_CHECK_RET(ly_out_iov_flush(out));
+    }
+
+    vec = &out->method.iov.vec[out->method.iov.count++];
+    vec->iov_base = (void *)buf;
+    vec->iov_len = len;
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Add a chunk with copied data to a scatter-gather output.
+ *
+ * @param[in] out Scatter-gather output.
+ * @param[in] buf Data to copy.
+ * @param[in] len Length of @p buf.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+ly_out_iov_copy(struct ly_out *out, const char *buf, size_t len)
+{
+    struct iovec *last;
+    char *dst;
+
+    if (!len) {
+        return LY_SUCCESS;
+    }
+
+    if ((out->method.iov.count == LY_OUT_IOV_COUNT) || (len > LY_OUT_IOV_BUF_SIZE - out->method.iov.len)) {
+        /* the buffer must not be rewritten before its chunks are written */
+        LY_CHECK_RET(ly_out_iov_flush(out));
+        if (len > LY_OUT_IOV_BUF_SIZE) {
+            /* too long to copy, write it right away */
+            LY_CHECK_RET(ly_out_iov_ref(out, buf, len));
+            return ly_out_iov_flush(out);
+        }
+    }
+
+    dst = out->method.iov.buf + out->method.iov.len;
+    memcpy(dst, buf, len);
+    out->method.iov.len += len;
+
+    last = out->method.iov.count ? &out->method.iov.vec[out->method.iov.count - 1] : NULL;
+    if (last && ((char *)last->iov_base + last->iov_len == dst)) {
+        /* continue the previous chunk */
+        last->iov_len += len;
+        return LY_SUCCESS;
+    }
+    return ly_out_iov_ref(out, dst, len);
+}
+
+/**
+ * @brief Create a scatter-gather printer handler.
+ *
+ * @param[in] type Type of the handler.
+ * @param[out] out Created printer handler.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+ly_out_new_iov(LY_OUT_TYPE type, struct ly_out **out)
+{
+    *out = calloc(1, sizeof **out);
+    LY_CHECK_ERR_RET(!*out, LOGMEM(NULL), LY_EMEM);
+
+    (*out)->type = type;
+    (*out)->method.iov.vec = malloc(LY_OUT_IOV_COUNT * sizeof *(*out)->method.iov.vec);
+    (*out)->method.iov.buf = malloc(LY_OUT_IOV_BUF_SIZE);
+    if (!(*out)->method.iov.vec || !(*out)->method.iov.buf) {
+        LOGMEM(NULL);
+        free((*out)->method.iov.vec);
+        free((*out)->method.iov.buf);
+        free(*out);
+        *out = NULL;
+        return LY_EMEM;
+    }
+
+    return LY_SUCCESS;
+}
+
+LIBYANG_API_DEF LY_ERR
+ly_out_new_clb_iov(ly_writev_clb writevclb, void *user_data, struct ly_out **out)
+{
+    LY_CHECK_ARG_RET(NULL, out, writevclb, LY_EINVAL);
+
+    LY_CHECK_RET(ly_out_new_iov(LY_OUT_CALLBACK_IOV, out));
+    (*out)->method.iov.func = writevclb;
+    (*out)->method.iov.arg = user_data;
+
+    return LY_SUCCESS;
+}
+
+LIBYANG_API_DEF LY_ERR
+ly_out_new_fd_iov(int fd, struct ly_out **out)
+{
+    LY_CHECK_ARG_RET(NULL, out, fd != -1, LY_EINVAL);
+
+    LY_CHECK_RET(ly_out_new_iov(LY_OUT_FD_IOV, out));
+    (*out)->method.iov.fd = fd;
+
+    return LY_SUCCESS;
+}
+
 LIBYANG_API_DEF LY_ERR
 ly_out_new_fd(int fd, struct ly_out **out)
 {
@@ -177,10 +382,12 @@ ly_out_fd(struct ly_out *out, int fd)
 {
     int prev_fd;
 
-    LY_CHECK_ARG_RET(NULL, out, out->type <= LY_OUT_FDSTREAM, -1);
+    LY_CHECK_ARG_RET(NULL, out, (out->type <= LY_OUT_FDSTREAM) || (out->type == LY_OUT_FD_IOV), -1);
 
     if (out->type == LY_OUT_FDSTREAM) {
         prev_fd = out->method.fdstream.fd;
+    } else if (out->type == LY_OUT_FD_IOV) {
+        prev_fd = out->method.iov.fd;
     } else { /* LY_OUT_FD */
         prev_fd = out->method.fd;
     }
@@ -206,6 +413,12 @@ ly_out_fd(struct ly_out *out, int fd)
             fclose(out->method.fdstream.f);
             out->method.fdstream.f = stream;
             out->method.fdstream.fd = streamfd;
+        } else if (out->type == LY_OUT_FD_IOV) {
+            /* the pending data belong to the previous file descriptor */
+            if (ly_out_iov_flush(out)) {
+                return -1;
+            }
+            out->method.iov.fd = fd;
         } else { /* LY_OUT_FD */
             out->method.fd = fd;
         }
@@ -328,7 +541,20 @@ ly_out_reset(struct ly_out *out)
         out->printed = 0;
         out->method.mem.len = 0;
         break;
+    case LY_OUT_FD_IOV:
+        /* write the pending data, the output may not be seekable */
+        LY_CHECK_RET(ly_out_iov_flush(out));
+        if ((lseek(out->method.iov.fd, 0, SEEK_SET) == -1) && (errno != ESPIPE)) {
+            LOGERR(NULL, LY_ESYS, "Seeking output file descriptor failed (%s).", strerror(errno));
+            return LY_ESYS;
+        }
+        if ((errno != ESPIPE) && (ftruncate(out->method.iov.fd, 0) == -1)) {
+            LOGERR(NULL, LY_ESYS, "Truncating output file failed (%s).", strerror(errno));
+            return LY_ESYS;
+        }
+        break;
     case LY_OUT_CALLBACK:
+    case LY_OUT_CALLBACK_IOV:
         /* nothing to do (not seekable) */
         break;
     }
@@ -420,6 +646,19 @@ ly_out_free(struct ly_out *out, void (*clb_arg_destructor)(void *arg), ly_bool d
         free(out->method.fpath.filepath);
         fclose(out->method.fpath.f);
         break;
+    case LY_OUT_FD_IOV:
+    case LY_OUT_CALLBACK_IOV:
+        ly_out_iov_flush(out);
+        if (out->type == LY_OUT_CALLBACK_IOV) {
+            if (clb_arg_destructor) {
+                clb_arg_destructor(out->method.iov.arg);
+            }
+        } else if (destroy) {
+            close(out->method.iov.fd);
+        }
+        free(out->method.iov.vec);
+        free(out->method.iov.buf);
+        break;
     case LY_OUT_ERROR:
         LOGINT(NULL);
     }
@@ -473,6 +712,15 @@ ly_vprint_(struct ly_out *out, const char *format, va_list ap)
         written = out->method.clb.func(out->method.clb.arg, msg, written);
         free(msg);
         break;
+    case LY_OUT_FD_IOV:
+    case LY_OUT_CALLBACK_IOV:
+        if ((written = vasprintf(&msg, format, ap)) < 0) {
+            break;
+        }
+        ret = ly_out_iov_copy(out, msg, written);
+        free(msg);
+        LY_CHECK_RET(ret);
+        break;
     case LY_OUT_ERROR:
         LOGINT(NULL);
         return LY_EINT;
@@ -543,6 +791,11 @@ ly_print_flush(struct ly_out *out)
     case LY_OUT_CALLBACK:
         /* nothing to do */
         break;
+    case LY_OUT_FD_IOV:
+    case LY_OUT_CALLBACK_IOV:
+        /* errors are logged */
+        ly_out_iov_flush(out);
+        break;
     case LY_OUT_ERROR:
         LOGINT(NULL);
     }
@@ -585,6 +838,10 @@ repeat:
     case LY_OUT_MEMORY:
         new_mem_size = out->method.mem.len + len + 1;
         if (new_mem_size > out->method.mem.size) {
+            if (new_mem_size < 2 * out->method.mem.size) {
+                /* grow geometrically so that the printed data are not copied over and over again */
+                new_mem_size = 2 * out->method.mem.size;
+            }
             new_mem_size = REALLOC_CHUNK(new_mem_size);
             *out->method.mem.buf = ly_realloc(*out->method.mem.buf, new_mem_size);
             if (!*out->method.mem.buf) {
@@ -633,6 +890,12 @@ repeat:
         }
         break;
     }
+    case LY_OUT_FD_IOV:
+    case LY_OUT_CALLBACK_IOV:
+        /* errors are logged when writing the pending chunks */
+        LY_CHECK_RET(ly_out_iov_copy(out, buf, len));
+        written = len;
+        break;
     case LY_OUT_ERROR:
         LOGINT(NULL);
         return LY_EINT;
@@ -662,6 +925,70 @@ repeat:
     return ret;
 }
 
+LY_ERR
+ly_write_ref_(struct ly_out *out, const char *buf, size_t len)
+{
+    if (((out->type != LY_OUT_FD_IOV) && (out->type != LY_OUT_CALLBACK_IOV)) || out->hole_count ||
+            (len < LY_OUT_IOV_REF_MIN)) {
+        /* copying short data is cheaper than writing another chunk */
+        return ly_write_(out, buf, len);
+    }
+
+    LY_CHECK_RET(ly_out_iov_ref(out, buf, len));
+
+    out->printed += len;
+    out->func_printed += len;
+    return LY_SUCCESS;
+}
+
+LY_ERR
+ly_write_strs_(struct ly_out *out, uint32_t indent, uint32_t count, ...)
+{
+    LY_ERR ret;
+    va_list ap;
+    char stack_buf[256], *buf;
+    const char *str;
+    size_t len, str_len;
+    uint32_t i;
+
+    /* learn the length */
+    len = indent;
+    va_start(ap, count);
+    for (i = 0; i < count; ++i) {
+        str = va_arg(ap, const char *);
+        len += str ? strlen(str) : 0;
+    }
+    va_end(ap);
+
+    if (len <= sizeof stack_buf) {
+        buf = stack_buf;
+    } else {
+        buf = malloc(len);
+        LY_CHECK_ERR_RET(!buf, LOGMEM(NULL), LY_EMEM);
+    }
+
+    /* assemble the strings */
+    memset(buf, ' ', indent);
+    len = indent;
+    va_start(ap, count);
+    for (i = 0; i < count; ++i) {
+        str = va_arg(ap, const char *);
+        if (str) {
+            str_len = strlen(str);
+            memcpy(buf + len, str, str_len);
+            len += str_len;
+        }
+    }
+    va_end(ap);
+
+    ret = ly_write_(out, buf, len);
+
+    if (buf != stack_buf) {
+        free(buf);
+    }
+    return ret;
+}
+
 LIBYANG_API_DEF LY_ERR
 ly_write(struct ly_out *out, const char *buf, size_t len)
 {
@@ -703,6 +1030,8 @@ ly_write_skip(struct ly_out *out, size_t count, size_t *position)
     case LY_OUT_FILEPATH:
     case LY_OUT_FILE:
     case LY_OUT_CALLBACK:
+    case LY_OUT_FD_IOV:
+    case LY_OUT_CALLBACK_IOV:
         /* buffer the hole */
         if (out->buf_len + count > out->buf_size) {
             out->buffered = ly_realloc(out->buffered, out->buf_len + count);
@@ -752,6 +1081,8 @@ ly_write_skipped(struct ly_out *out, size_t position, const char *buf, size_t co
     case LY_OUT_FILEPATH:
     case LY_OUT_FILE:
     case LY_OUT_CALLBACK:
+    case LY_OUT_FD_IOV:
+    case LY_OUT_CALLBACK_IOV:
         if (out->buf_len < position + count) {
             LOGMEM(NULL);
             return LY_EMEM;
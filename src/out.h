@@ -20,6 +20,18 @@
 #ifdef _MSC_VER
 #  define ssize_t SSIZE_T
 #endif
+#ifndef _WIN32
+#  include <sys/uio.h>
+#else
+
+/**
+ * @brief Chunk of data for scatter-gather output, as defined by POSIX.
+ */
+struct iovec {
+    void *iov_base;     /**< start of the chunk */
+    size_t iov_len;     /**< length of the chunk */
+};
+#endif
 
 #include "log.h"
 
@@ -40,6 +52,12 @@ extern "C" {
  * The API allows to alter the target of the data behind the handler by another target (of the same type). Also resetting
  * a seekable output is possible with ::ly_out_reset() to re-write the output.
  *
+ * The scatter-gather outputs created by ::ly_out_new_fd_iov() and ::ly_out_new_clb_iov() do not write each piece of
+ * the output separately. Small pieces are collected in an internal buffer, while long values of the printed data are
+ * only referenced, and all of them are written at once using writev(2) or passed to the callback as a single batch.
+ * The pending data are written whenever the internal buffers are full and on ::ly_print_flush(), which is called at
+ * the end of every printer function, or on ::ly_out_free().
+ *
  * @note
  * This mechanism was introduced in libyang 2.0. To simplify transition from libyang 1.0 to version 2.0 and also for
  * some simple use case where using the output handler would be an overkill, there are some basic printer functions
@@ -49,7 +67,9 @@ extern "C" {
  * Functions List
  * --------------
  * - ::ly_out_new_clb()
+ * - ::ly_out_new_clb_iov()
  * - ::ly_out_new_fd()
+ * - ::ly_out_new_fd_iov()
  * - ::ly_out_new_file()
  * - ::ly_out_new_filepath()
  * - ::ly_out_new_memory()
@@ -98,7 +118,9 @@ typedef enum LY_OUT_TYPE {
     LY_OUT_FILE,        /**< FILE stream printer */
     LY_OUT_FILEPATH,    /**< filepath printer */
     LY_OUT_MEMORY,      /**< memory printer */
-    LY_OUT_CALLBACK     /**< callback printer */
+    LY_OUT_CALLBACK,    /**< callback printer */
+    LY_OUT_FD_IOV,      /**< file descriptor printer using scatter-gather writes */
+    LY_OUT_CALLBACK_IOV /**< callback printer receiving the output in scatter-gather batches */
 } LY_OUT_TYPE;
 
 /**
@@ -166,6 +188,28 @@ LIBYANG_API_DECL ly_write_clb ly_out_clb(struct ly_out *out, ly_write_clb writec
  */
 LIBYANG_API_DECL void *ly_out_clb_arg(struct ly_out *out, void *arg);
 
+/**
+ * @brief Scatter-gather write callback for data printed by libyang.
+ *
+ * @param[in] user_data Optional caller-specific argument.
+ * @param[in] iov Chunks of data to write, valid only until the callback returns.
+ * @param[in] iovcnt Number of chunks in @p iov.
+ * @return Number of printed bytes, anything else than the total length of the chunks is an error.
+ * @return Negative value in case of error.
+ */
+typedef ssize_t (*ly_writev_clb)(void *user_data, const struct iovec *iov, int iovcnt);
+
+/**
+ * @brief Create printer handler using scatter-gather callback printer function.
+ *
+ * @param[in] writevclb Pointer to the printer callback function writing the data (see writev(2)).
+ * @param[in] user_data Optional caller-specific argument to be passed to the @p writevclb callback.
+ * @param[out] out Created printer handler supposed to be passed to different ly*_print() functions.
+ * @return LY_SUCCESS in case of success
+ * @return LY_EMEM in case allocating the @p out handler fails.
+ */
+LIBYANG_API_DECL LY_ERR ly_out_new_clb_iov(ly_writev_clb writevclb, void *user_data, struct ly_out **out);
+
 /**
  * @brief Create printer handler using file descriptor.
  *
@@ -176,9 +220,21 @@ LIBYANG_API_DECL void *ly_out_clb_arg(struct ly_out *out, void *arg);
  */
 LIBYANG_API_DECL LY_ERR ly_out_new_fd(int fd, struct ly_out **out);
 
+/**
+ * @brief Create printer handler using file descriptor written by scatter-gather writes.
+ *
+ * @param[in] fd File descriptor to use.
+ * @param[out] out Created printer handler supposed to be passed to different ly*_print() functions.
+ * @return LY_SUCCESS in case of success
+ * @return LY_ERR value in case of failure.
+ */
+LIBYANG_API_DECL LY_ERR ly_out_new_fd_iov(int fd, struct ly_out **out);
+
 /**
  * @brief Get or reset file descriptor printer handler.
  *
+ * Any pending data of ::LY_OUT_FD_IOV handler are written into the previous file descriptor before setting @p fd.
+ *
  * @param[in] out Printer handler.
  * @param[in] fd Optional value of a new file descriptor for the handler. If -1, only the current file descriptor value is returned.
  * @return Previous value of the file descriptor. Note that caller is responsible for closing the returned file descriptor in case of setting new descriptor @p fd.
@@ -267,6 +323,9 @@ LIBYANG_API_DECL LY_ERR ly_print(struct ly_out *out, const char *format, ...);
 
 /**
  * @brief Flush the output from any internal buffers and clean any auxiliary data.
+ *
+ * Errors writing the pending data of the scatter-gather outputs are only logged.
+ *
  * @param[in] out Output specification.
  */
 LIBYANG_API_DECL void ly_print_flush(struct ly_out *out);
@@ -294,9 +353,9 @@ LIBYANG_API_DECL size_t ly_out_printed(const struct ly_out *out);
 /**
  * @brief Free the printer handler.
  * @param[in] out Printer handler to free.
- * @param[in] clb_arg_destructor Freeing function for printer callback (LY_OUT_CALLBACK) argument.
+ * @param[in] clb_arg_destructor Freeing function for printer callback (LY_OUT_CALLBACK and LY_OUT_CALLBACK_IOV) argument.
  * @param[in] destroy Flag to free allocated buffer (for LY_OUT_MEMORY) or to
- * close stream/file descriptor (for LY_OUT_FD, LY_OUT_FDSTREAM and LY_OUT_FILE)
+ * close stream/file descriptor (for LY_OUT_FD, LY_OUT_FDSTREAM, LY_OUT_FD_IOV and LY_OUT_FILE)
  */
 LIBYANG_API_DECL void ly_out_free(struct ly_out *out, void (*clb_arg_destructor)(void *arg), ly_bool destroy);
 
@@ -46,6 +46,15 @@ struct ly_out {
             ssize_t (*func)(void *arg, const void *buf, size_t count); /**< callback function */
             void *arg;        /**< optional argument for the callback function */
         } clb;           /**< printer callback for LY_OUT_CALLBACK type */
+        struct {
+            int fd;           /**< file descriptor for LY_OUT_FD_IOV type */
+            ly_writev_clb func; /**< callback function for LY_OUT_CALLBACK_IOV type */
+            void *arg;        /**< optional argument for the callback function */
+            struct iovec *vec; /**< pending chunks of the output, ::LY_OUT_IOV_COUNT allocated */
+            int count;        /**< number of pending chunks */
+            char *buf;        /**< buffer for the copied chunks, ::LY_OUT_IOV_BUF_SIZE allocated */
+            size_t len;       /**< number of used bytes in the buffer */
+        } iov;           /**< scatter-gather output information for LY_OUT_FD_IOV and LY_OUT_CALLBACK_IOV types */
     } method;            /**< type-specific information about the output */
 
     /* LYB only */
@@ -81,6 +90,33 @@ LY_ERR ly_print_(struct ly_out *out, const char *format, ...);
  */
 LY_ERR ly_write_(struct ly_out *out, const char *buf, size_t len);
 
+/**
+ * @brief Generic printer of the given string buffer into the specified output, which does not have to copy it.
+ *
+ * Does not reset printed bytes. Adds to printed bytes. The scatter-gather outputs only reference long @p buf instead
+ * of copying it, so it must not be changed nor freed until ::ly_print_flush() is called. Other outputs just write it.
+ *
+ * @param[in] out Output specification.
+ * @param[in] buf Memory buffer with the data to print.
+ * @param[in] len Length of the data to print in the @p buf.
+ * @return LY_ERR value.
+ */
+LY_ERR ly_write_ref_(struct ly_out *out, const char *buf, size_t len);
+
+/**
+ * @brief Generic printer of indentation followed by several strings into the specified output.
+ *
+ * Does not reset printed bytes. Adds to printed bytes. Replaces ::ly_print_() with only "%*s" indentation
+ * and "%s" conversions, the strings are just copied into a buffer and written at once.
+ *
+ * @param[in] out Output specification.
+ * @param[in] indent Number of spaces to print first.
+ * @param[in] count Number of the strings to print.
+ * @param[in] ... Strings (const char *) to print, NULL is skipped.
+ * @return LY_ERR value.
+ */
+LY_ERR ly_write_strs_(struct ly_out *out, uint32_t indent, uint32_t count, ...);
+
 /**
  * @brief Create a hole in the output data that will be filled later.
  *
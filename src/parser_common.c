@@ -46,6 +46,7 @@
 #include "parser_data.h"
 #include "path.h"
 #include "plugins_exts/metadata.h"
+#include "plugins_types.h"
 #include "schema_compile_node.h"
 #include "schema_features.h"
 #include "set.h"
@@ -54,6 +55,7 @@
 #include "tree_data_internal.h"
 #include "tree_schema.h"
 #include "tree_schema_internal.h"
+#include "xpath.h"
 
 void
 lyd_ctx_free(struct lyd_ctx *lydctx)
@@ -430,6 +432,584 @@ lyd_parse_set_data_flags(struct lyd_node *node, struct lyd_meta **meta, struct l
     return LY_SUCCESS;
 }
 
+/**
+ * @brief Parse a name test for a parser filter.
+ *
+ * @param[in] ctx libyang context.
+ * @param[in] exp Parsed XPath expression.
+ * @param[in] tok_idx Index of the name test token.
+ * @param[out] mod Module of the name test, NULL if not prefixed.
+ * @param[out] name Name in the dictionary, NULL for any name.
+ * @return LY_SUCCESS on success.
+ * @return LY_ENOT if the name test is not supported by the filter.
+ * @return LY_ERR on error.
+ */
+static LY_ERR
+lyd_parser_filter_nametest(const struct ly_ctx *ctx, const struct lyxp_expr *exp, uint32_t tok_idx,
+        const struct lys_module **mod, const char **name)
+{
+    const char *tok = exp->expr + exp->tok_pos[tok_idx], *ptr;
+    size_t len = exp->tok_len[tok_idx];
+
+    *mod = NULL;
+    *name = NULL;
+
+    ptr = ly_strnchr(tok, ':', len);
+    if (ptr) {
+        /* JSON prefix, module name */
+        *mod = ly_ctx_get_module_implemented2(ctx, tok, ptr - tok);
+        if (!*mod) {
+            /* leave any errors to the full evaluation */
+            return LY_ENOT;
+        }
+
+        len -= (ptr - tok) + 1;
+        tok = ptr + 1;
+    }
+
+    if ((len == 1) && (tok[0] == '*')) {
+        /* any name */
+        return LY_SUCCESS;
+    }
+    return lydict_insert(ctx, tok, len, name);
+}
+
+/**
+ * @brief Parse a predicate of a parser filter step.
+ *
+ * Only equality comparisons of a child or the node itself with a literal, a number, or another such node joined
+ * by "and" are supported.
+ *
+ * @param[in] ctx libyang context.
+ * @param[in] exp Parsed XPath expression.
+ * @param[in,out] tok_idx Index of the predicate opening bracket, is moved after the predicate.
+ * @param[in,out] step Filter step to update.
+ * @return LY_SUCCESS on success.
+ * @return LY_ENOT if the predicate is not supported by the filter.
+ * @return LY_ERR on error.
+ */
+static LY_ERR
+lyd_parser_filter_predicate(const struct ly_ctx *ctx, const struct lyxp_expr *exp, uint32_t *tok_idx,
+        struct lyd_filter_step *step)
+{
+    const struct lys_module *mod;
+    const char **pred_name, *names[2];
+    struct lyd_filter_eq *eq;
+    uint32_t i = *tok_idx + 1, j, val_idx, node_refs;
+
+    assert(exp->tokens[*tok_idx] == LYXP_TOKEN_BRACK1);
+
+    while (1) {
+        /* operand '=' operand */
+        node_refs = 0;
+        val_idx = 0;
+        for (j = 0; j < 3; ++j, ++i) {
+            if (i == exp->used) {
+                return LY_ENOT;
+            } else if (j == 1) {
+                if (exp->tokens[i] != LYXP_TOKEN_OPER_EQUAL) {
+                    return LY_ENOT;
+                }
+                continue;
+            }
+
+            switch (exp->tokens[i]) {
+            case LYXP_TOKEN_LITERAL:
+            case LYXP_TOKEN_NUMBER:
+                val_idx = i;
+                break;
+            case LYXP_TOKEN_DOT:
+                step->pred_self = 1;
+                names[node_refs++] = NULL;
+                break;
+            case LYXP_TOKEN_NAMETEST:
+                LY_ARRAY_NEW_RET(ctx, step->pred_names, pred_name, LY_EMEM);
+                LY_CHECK_RET(lyd_parser_filter_nametest(ctx, exp, i, &mod, pred_name));
+                if (!*pred_name) {
+                    /* any child */
+                    return LY_ENOT;
+                }
+                names[node_refs++] = *pred_name;
+                break;
+            default:
+                return LY_ENOT;
+            }
+        }
+
+        if (!node_refs) {
+            /* constant comparison */
+            return LY_ENOT;
+        }
+
+        eq = realloc(step->eqs, (step->eq_count + 1) * sizeof *step->eqs);
+        LY_CHECK_ERR_RET(!eq, LOGMEM(ctx), LY_EMEM);
+        step->eqs = eq;
+        eq = &step->eqs[step->eq_count++];
+        memset(eq, 0, sizeof *eq);
+        if (names[0]) {
+            LY_CHECK_RET(lydict_insert(ctx, names[0], 0, &eq->name));
+        }
+        if (node_refs == 2) {
+            /* compared with other nodes */
+            if (names[1]) {
+                LY_CHECK_RET(lydict_insert(ctx, names[1], 0, &eq->name2));
+            }
+        } else if (exp->tokens[val_idx] == LYXP_TOKEN_LITERAL) {
+            LY_CHECK_RET(lydict_insert(ctx, exp->expr + exp->tok_pos[val_idx] + 1, exp->tok_len[val_idx] - 2,
+                    &eq->value));
+        } else {
+            LY_CHECK_RET(lydict_insert(ctx, exp->expr + exp->tok_pos[val_idx], exp->tok_len[val_idx], &eq->value));
+            eq->number = 1;
+            errno = 0;
+            eq->num = strtold(eq->value, NULL);
+            if (errno) {
+                return LY_ENOT;
+            }
+        }
+
+        if (i == exp->used) {
+            return LY_ENOT;
+        } else if (exp->tokens[i] == LYXP_TOKEN_BRACK2) {
+            break;
+        } else if ((exp->tokens[i] != LYXP_TOKEN_OPER_LOG) || (exp->tok_len[i] != 3)) {
+            /* only "and" */
+            return LY_ENOT;
+        }
+        ++i;
+    }
+
+    *tok_idx = i + 1;
+    return LY_SUCCESS;
+}
+
+LY_ERR
+lyd_parser_filter_new(const struct ly_ctx *ctx, const char *xpath, struct lyd_filter **filter)
+{
+    LY_ERR rc = LY_SUCCESS;
+    struct lyxp_expr *exp = NULL;
+    struct lyd_filter *f = NULL;
+    struct lyd_filter_step *step = NULL;
+    uint32_t i = 0;
+
+    *filter = NULL;
+
+    /* parse the expression, it must be valid in any case */
+    LY_CHECK_RET(lyxp_expr_parse(ctx, xpath, 0, 1, &exp));
+
+    f = calloc(1, sizeof *f);
+    LY_CHECK_ERR_GOTO(!f, LOGMEM(ctx); rc = LY_EMEM, cleanup);
+    f->ctx = ctx;
+
+    while (i < exp->used) {
+        /* '/' or '//' and a name test */
+        if (((exp->tokens[i] != LYXP_TOKEN_OPER_PATH) && (exp->tokens[i] != LYXP_TOKEN_OPER_RPATH)) ||
+                (i + 1 == exp->used) || (exp->tokens[i + 1] != LYXP_TOKEN_NAMETEST) ||
+                (LY_ARRAY_COUNT(f->steps) == LYD_FILTER_STEPS_MAX)) {
+            rc = LY_ENOT;
+            goto cleanup;
+        }
+
+        if (!step || step->last) {
+            /* first step of a path */
+            f->first |= (uint64_t)1 << LY_ARRAY_COUNT(f->steps);
+        }
+        LY_ARRAY_NEW_GOTO(ctx, f->steps, step, rc, cleanup);
+        step->desc = (exp->tokens[i] == LYXP_TOKEN_OPER_RPATH) ? 1 : 0;
+        ++i;
+
+        /* unprefixed names are matched in any module */
+        rc = lyd_parser_filter_nametest(ctx, exp, i, &step->mod, &step->name);
+        LY_CHECK_GOTO(rc, cleanup);
+        ++i;
+
+        /* predicates */
+        while ((i < exp->used) && (exp->tokens[i] == LYXP_TOKEN_BRACK1)) {
+            rc = lyd_parser_filter_predicate(ctx, exp, &i, step);
+            LY_CHECK_GOTO(rc, cleanup);
+        }
+
+        if ((i == exp->used) || (exp->tokens[i] == LYXP_TOKEN_OPER_UNI)) {
+            /* end of a path */
+            step->last = 1;
+            if (i < exp->used) {
+                ++i;
+            }
+        }
+    }
+
+cleanup:
+    lyxp_expr_free(ctx, exp);
+    if (rc == LY_ENOT) {
+        /* not supported, all the data will be parsed */
+        rc = LY_SUCCESS;
+        lyd_parser_filter_free(f);
+    } else if (rc) {
+        lyd_parser_filter_free(f);
+    } else {
+        *filter = f;
+    }
+    return rc;
+}
+
+void
+lyd_parser_filter_free(struct lyd_filter *filter)
+{
+    LY_ARRAY_COUNT_TYPE u, v;
+    uint32_t i;
+
+    if (!filter) {
+        return;
+    }
+
+    LY_ARRAY_FOR(filter->steps, u) {
+        lydict_remove(filter->ctx, filter->steps[u].name);
+        for (i = 0; i < filter->steps[u].eq_count; ++i) {
+            lydict_remove(filter->ctx, filter->steps[u].eqs[i].name);
+            lydict_remove(filter->ctx, filter->steps[u].eqs[i].name2);
+            lydict_remove(filter->ctx, filter->steps[u].eqs[i].value);
+            free(filter->steps[u].eqs[i].canon);
+        }
+        free(filter->steps[u].eqs);
+        LY_ARRAY_FOR(filter->steps[u].pred_names, v) {
+            lydict_remove(filter->ctx, filter->steps[u].pred_names[v]);
+        }
+        LY_ARRAY_FREE(filter->steps[u].pred_names);
+        lyht_free(filter->steps[u].desc_cache, NULL);
+    }
+    LY_ARRAY_FREE(filter->steps);
+    free(filter);
+}
+
+/**
+ * @brief Add the effect of a matched parser filter step to the state of the matching node.
+ *
+ * @param[in] filter Parser filter.
+ * @param[in] step_idx Index of the matched step.
+ * @param[in,out] state Filter state of the node to update.
+ */
+static void
+lyd_parser_filter_match(const struct lyd_filter *filter, uint32_t step_idx, struct lyd_filter_state *state)
+{
+    const struct lyd_filter_step *step = &filter->steps[step_idx];
+
+    if (step->last || step->pred_self) {
+        /* a possible result or its value is referenced in a predicate */
+        state->all = 1;
+    } else {
+        state->steps |= (uint64_t)1 << (step_idx + 1);
+    }
+}
+
+ly_bool
+lyd_parser_filter_node(struct lyd_filter *filter, struct lyd_filter_state *state, const struct lysc_node *snode)
+{
+    struct lyd_filter_step *step;
+    struct lyd_filter_state parent = *state;
+    LY_ARRAY_COUNT_TYPE u;
+    uint64_t bit;
+    uint32_t i;
+    ly_bool parse = 0;
+
+    memset(state, 0, sizeof *state);
+
+    if (parent.cond && !parent.pending) {
+        /* the parent is not needed */
+        return 0;
+    }
+
+    /* expect the pending steps of the parent to match */
+    for (i = 0; i < LY_ARRAY_COUNT(filter->steps); ++i) {
+        if (parent.pending & ((uint64_t)1 << i)) {
+            lyd_parser_filter_match(filter, i, &parent);
+        }
+    }
+
+    if (parent.all || !snode || (snode->module->ctx != filter->ctx)) {
+        /* descendant of a node that is parsed whole, opaque nodes and nodes from other contexts are unknown */
+        state->all = 1;
+        return 1;
+    }
+
+    if (lysc_is_key(snode)) {
+        /* list keys are always needed */
+        parse = 1;
+    }
+
+    for (i = 0; i < LY_ARRAY_COUNT(filter->steps); ++i) {
+        step = &filter->steps[i];
+        bit = (uint64_t)1 << i;
+
+        if (parent.preds & bit) {
+            LY_ARRAY_FOR(step->pred_names, u) {
+                if (step->pred_names[u] == snode->name) {
+                    /* referenced in a predicate of the parent */
+                    parse = 1;
+                    state->all = 1;
+                }
+            }
+        }
+
+        if (!(parent.steps & bit)) {
+            continue;
+        }
+
+        if ((!step->mod || (step->mod == snode->module)) && (!step->name || (step->name == snode->name))) {
+            if (step->eq_count) {
+                /* evaluated once the node is parsed */
+                state->pending |= bit;
+                if (step->pred_names) {
+                    state->preds |= bit;
+                }
+            } else {
+                parse = 1;
+                lyd_parser_filter_match(filter, i, state);
+            }
+        }
+
+        if (step->desc && lysc_node_desc_possible(snode, step->mod, step->name, &step->desc_cache)) {
+            /* a descendant may match the step */
+            parse = 1;
+            state->steps |= bit;
+        }
+    }
+
+    if (!parse && state->pending) {
+        /* needed only if a predicate is true */
+        state->cond = 1;
+        parse = 1;
+    }
+
+    if (parse && (snode->nodetype & LYD_NODE_ANY)) {
+        /* any content is unknown to the filter */
+        state->all = 1;
+    }
+
+    return parse;
+}
+
+/**
+ * @brief Check whether all the predicates of a parser filter step reference only keys of a list.
+ *
+ * @param[in] step Filter step.
+ * @param[in] snode Schema node of the list.
+ * @return Whether only the keys are referenced.
+ */
+static ly_bool
+lyd_parser_filter_keys_only(const struct lyd_filter_step *step, const struct lysc_node *snode)
+{
+    const struct lysc_node *skey;
+    LY_ARRAY_COUNT_TYPE u;
+
+    if (step->pred_self) {
+        return 0;
+    }
+
+    LY_ARRAY_FOR(step->pred_names, u) {
+        for (skey = lysc_node_child(snode); skey && lysc_is_key(skey); skey = skey->next) {
+            if (skey->name == step->pred_names[u]) {
+                break;
+            }
+        }
+        if (!skey || !lysc_is_key(skey)) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Compare a data node value with a parser filter equality comparison value, the same way XPath does.
+ *
+ * @param[in] ctx libyang context.
+ * @param[in,out] eq Equality comparison, its canonized value may be updated.
+ * @param[in] node Compared data node.
+ * @return Whether the values are equal, if unsure, they are.
+ */
+static ly_bool
+lyd_parser_filter_eq_value(const struct ly_ctx *ctx, struct lyd_filter_eq *eq, const struct lyd_node *node)
+{
+    const struct lysc_type *type;
+    struct lyd_value val;
+    struct ly_err_item *err = NULL;
+    const char *value;
+    long double num;
+    char *ptr;
+    LY_ERR r;
+
+    if (!node->schema || !(node->schema->nodetype & LYD_NODE_TERM)) {
+        /* string value of other nodes is not compared */
+        return 1;
+    }
+    value = lyd_get_value(node);
+
+    if (eq->number) {
+        /* compare as numbers, invalid number is NaN */
+        errno = 0;
+        num = strtold(value, &ptr);
+        return !errno && !*ptr && (num == eq->num);
+    }
+
+    type = ((struct lyd_node_term *)node)->value.realtype;
+    if (((type->basetype == LY_TYPE_STRING) && (type->plugin->store == lyplg_type_store_string)) ||
+            ((type->basetype == LY_TYPE_BOOL) && (type->plugin->store == lyplg_type_store_boolean)) ||
+            ((type->basetype == LY_TYPE_ENUM) && (type->plugin->store == lyplg_type_store_enum))) {
+        /* no canonization required */
+        return !strcmp(value, eq->value);
+    }
+
+    if (eq->type != type) {
+        /* canonize the value for this type, invalid value is compared as is */
+        free(eq->canon);
+        eq->canon = NULL;
+        eq->type = type;
+        r = type->plugin->store(ctx, type, eq->value, strlen(eq->value), 0, LY_VALUE_JSON, NULL, LYD_HINT_DATA,
+                node->schema, &val, NULL, &err);
+        ly_err_free(err);
+        if (!r || (r == LY_EINCOMPLETE)) {
+            eq->canon = strdup(lyd_value_get_canonical(ctx, &val));
+            type->plugin->free(ctx, &val);
+            if (!eq->canon) {
+                eq->type = NULL;
+                return 1;
+            }
+        }
+    }
+
+    return !strcmp(value, eq->canon ? eq->canon : eq->value);
+}
+
+/**
+ * @brief Get the next data node referenced by an operand of a parser filter equality comparison.
+ *
+ * @param[in] node Data node the predicate is evaluated on.
+ * @param[in] name Name of the referenced children in the dictionary, NULL for @p node itself.
+ * @param[in] prev Previously returned node, NULL to get the first one.
+ * @return Next referenced node, NULL if there are no more.
+ */
+static const struct lyd_node *
+lyd_parser_filter_operand_next(const struct lyd_node *node, const char *name, const struct lyd_node *prev)
+{
+    const struct lyd_node *iter;
+
+    if (!name) {
+        return prev ? NULL : node;
+    }
+
+    for (iter = prev ? prev->next : lyd_child(node); iter; iter = iter->next) {
+        if (iter->schema ? (iter->schema->name == name) : !strcmp(LYD_NAME(iter), name)) {
+            return iter;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Evaluate a parser filter equality comparison on a data node, the same way XPath does.
+ *
+ * @param[in] ctx libyang context.
+ * @param[in,out] eq Equality comparison, its canonized value may be updated.
+ * @param[in] node Data node the predicate is evaluated on.
+ * @return Whether the comparison is true, if unsure, it is.
+ */
+static ly_bool
+lyd_parser_filter_eq(const struct ly_ctx *ctx, struct lyd_filter_eq *eq, const struct lyd_node *node)
+{
+    struct lyd_filter_eq node_eq = {0};
+    const struct lyd_node *op1 = NULL, *op2;
+    ly_bool result = 0;
+
+    while (!result && (op1 = lyd_parser_filter_operand_next(node, eq->name, op1))) {
+        if (eq->value) {
+            /* node-set and a literal or a number */
+            result = lyd_parser_filter_eq_value(ctx, eq, op1);
+            continue;
+        }
+
+        /* node-set and node-set, compare the string value of every first node with all the second nodes */
+        if (!op1->schema || !(op1->schema->nodetype & LYD_NODE_TERM)) {
+            return 1;
+        }
+        node_eq.value = lyd_get_value(op1);
+        op2 = NULL;
+        while (!result && (op2 = lyd_parser_filter_operand_next(node, eq->name2, op2))) {
+            result = lyd_parser_filter_eq_value(ctx, &node_eq, op2);
+        }
+        free(node_eq.canon);
+        node_eq.type = NULL;
+        node_eq.canon = NULL;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Evaluate the predicates of a parser filter step on a data node.
+ *
+ * @param[in] filter Parser filter.
+ * @param[in] step Filter step.
+ * @param[in] node Data node matching the step.
+ * @return Whether the predicates are true, if unsure, they are.
+ */
+static ly_bool
+lyd_parser_filter_eval(struct lyd_filter *filter, struct lyd_filter_step *step, const struct lyd_node *node)
+{
+    uint32_t u;
+
+    for (u = 0; u < step->eq_count; ++u) {
+        if (!lyd_parser_filter_eq(filter->ctx, &step->eqs[u], node)) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+ly_bool
+lyd_parser_filter_check(struct lyd_filter *filter, struct lyd_filter_state *state, const struct lyd_node *node,
+        ly_bool keys)
+{
+    struct lyd_filter_step *step;
+    const struct lysc_node *skey;
+    const struct lyd_node *key;
+    uint64_t bit;
+    uint32_t i;
+    ly_bool result;
+
+    if (keys) {
+        if (!node->schema || (node->schema->nodetype != LYS_LIST)) {
+            return 1;
+        }
+
+        /* all the keys must be parsed */
+        key = lyd_child(node);
+        for (skey = lysc_node_child(node->schema); skey && lysc_is_key(skey); skey = skey->next) {
+            if (!key || (key->schema != skey)) {
+                return 1;
+            }
+            key = key->next;
+        }
+    }
+
+    for (i = 0; i < LY_ARRAY_COUNT(filter->steps); ++i) {
+        step = &filter->steps[i];
+        bit = (uint64_t)1 << i;
+        if (!(state->pending & bit) || (keys && !lyd_parser_filter_keys_only(step, node->schema))) {
+            continue;
+        }
+
+        result = lyd_parser_filter_eval(filter, step, node);
+        state->pending &= ~bit;
+        state->preds &= ~bit;
+        if (result) {
+            lyd_parser_filter_match(filter, i, state);
+            state->cond = 0;
+        }
+    }
+
+    return !state->cond || state->pending;
+}
+
 void
 lys_parser_fill_filepath(struct ly_ctx *ctx, struct ly_in *in, const char **filepath)
 {
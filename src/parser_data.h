@@ -59,6 +59,8 @@ struct ly_in;
  *     example the *:operational* datastore is not necessarily valid and results of the NETCONF's \<get\> or \<get-config\>
  *     oprations used with filters will be incomplete (and thus invalid). This can be allowed using ::LYD_PARSE_ONLY,
  *     the ::LYD_PARSE_NO_STATE should be used for the data returned by \<get-config\> operation.
+ * - ::lyd_parse_data_filter() is used for parsing only the parts of data trees selected by an XPath filter, the data
+ *   that cannot be selected are skipped in the input instead of being parsed and trimmed afterwards.
  * - ::lyd_parse_ext_data() is used for parsing configuration data trees defined inside extension instances, such as
  *   instances of yang-data extension specified in [RFC 8040](http://tools.ietf.org/html/rfc8040).
  * - ::lyd_parse_op() is used for parsing RPCs/actions, replies, and notifications. Even NETCONF rpc, rpc-reply, and
@@ -75,6 +77,7 @@ struct ly_in;
  * - ::lyd_parse_data_mem()
  * - ::lyd_parse_data_fd()
  * - ::lyd_parse_data_path()
+ * - ::lyd_parse_data_filter()
  * - ::lyd_parse_ext_data()
  * - ::lyd_parse_op()
  * - ::lyd_parse_ext_op()
@@ -298,6 +301,30 @@ LIBYANG_API_DECL LY_ERR lyd_parse_data_fd(const struct ly_ctx *ctx, int fd, LYD_
 LIBYANG_API_DECL LY_ERR lyd_parse_data_path(const struct ly_ctx *ctx, const char *path, LYD_FORMAT format,
         uint32_t parse_options, uint32_t validate_options, struct lyd_node **tree);
 
+/**
+ * @brief Parse data from the input handler as a YANG data tree and keep only the subtrees selected by an XPath filter.
+ *
+ * The result is the same as parsing the data with ::LYD_PARSE_ONLY and trimming them using ::lyd_trim_xpath().
+ * However, if @p xpath is a union of absolute location paths with child and descendant ('//') steps and predicates
+ * comparing children or the node itself with literals, numbers, or between themselves, such as
+ * `/mod:cont/list[key='value']//leaf`, the XML and JSON input data that cannot be selected are skipped without
+ * creating any nodes.
+ *
+ * Note that the skipped data are checked only for well-formedness and the filtered data are never validated,
+ * ::LYD_PARSE_ONLY is always used.
+ *
+ * @param[in] ctx Context to connect with the tree being built here.
+ * @param[in] in The input handle to provide the dumped data in the specified @p format to parse.
+ * @param[in] format Format of the input data to be parsed. Can be 0 to try to detect format from the input handler.
+ * @param[in] parse_options Options for parser, see @ref dataparseroptions.
+ * @param[in] xpath XPath filter selecting the subtrees to keep, with JSON prefixes.
+ * @param[out] tree Filtered parsed data tree, note that NULL can be a valid tree.
+ * @return LY_SUCCESS in case of successful parsing.
+ * @return LY_ERR value in case of error. Additional error information can be obtained from the context using ly_err* functions.
+ */
+LIBYANG_API_DECL LY_ERR lyd_parse_data_filter(const struct ly_ctx *ctx, struct ly_in *in, LYD_FORMAT format,
+        uint32_t parse_options, const char *xpath, struct lyd_node **tree);
+
 /**
  * @brief Parse (and validate) data from the input handler as an extension data tree following the schema tree of the given
  * extension instance.
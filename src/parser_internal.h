@@ -20,6 +20,7 @@
 #include "set.h"
 
 struct lyd_ctx;
+struct ly_ht;
 struct ly_in;
 struct lysp_ext_substmt;
 struct lysp_stmt;
@@ -95,6 +96,62 @@ struct lyd_ctx {
     } *data_ctx;                   /**< generic pointer supposed to map to and access (common part of) XML/JSON/... parser contexts */
 };
 
+/**
+ * @brief Maximum number of steps in all the paths of a parser filter.
+ */
+#define LYD_FILTER_STEPS_MAX 64
+
+/**
+ * @brief Equality comparison of a parser filter predicate evaluated directly on the data nodes.
+ */
+struct lyd_filter_eq {
+    const char *name;               /**< name of the compared children in the dictionary, NULL for the node itself */
+    const char *name2;              /**< name of the other compared children if not @p value, NULL for the node itself */
+    const char *value;              /**< compared literal or number in the dictionary, NULL if comparing nodes */
+    ly_bool number;                 /**< whether the value is a number */
+    long double num;                /**< number value, if a number */
+    const struct lysc_type *type;   /**< type the value was last canonized for */
+    char *canon;                    /**< value canonized for the type, NULL if it is not valid */
+};
+
+/**
+ * @brief Single step of a parser filter path.
+ */
+struct lyd_filter_step {
+    const struct lys_module *mod;   /**< module of the matching nodes, NULL for any */
+    const char *name;               /**< name of the matching nodes in the dictionary, NULL for any */
+    struct lyd_filter_eq *eqs;      /**< array of the equality comparisons of the predicates, not a sized array because
+                                         of the alignment of ::lyd_filter_eq.num */
+    uint32_t eq_count;              /**< number of items in @p eqs */
+    const char **pred_names;        /**< sized array of names of the children referenced in predicates, in the dictionary */
+    ly_bool pred_self;              /**< whether a predicate references the value of the node itself */
+    ly_bool desc;                   /**< whether the step matches any descendant ('//'), not only a child */
+    ly_bool last;                   /**< whether it is the last step of its path */
+    struct ly_ht *desc_cache;       /**< cache of schema nodes whose descendants may match the descendant step */
+};
+
+/**
+ * @brief Parser filter, compiled from a restricted XPath expression to skip the data that cannot affect its results.
+ *
+ * Sets of steps are represented by bitmasks of their indices.
+ */
+struct lyd_filter {
+    const struct ly_ctx *ctx;       /**< libyang context */
+    struct lyd_filter_step *steps;  /**< sized array of the steps of all the paths */
+    uint64_t first;                 /**< first steps of all the paths */
+};
+
+/**
+ * @brief Parser filter state of a data node and its children.
+ */
+struct lyd_filter_state {
+    uint64_t steps;                 /**< steps the children may match */
+    uint64_t preds;                 /**< steps whose predicates reference the children */
+    uint64_t pending;               /**< steps matched by the node whose predicates were not evaluated yet */
+    ly_bool all;                    /**< whether all the descendants are parsed */
+    ly_bool cond;                   /**< whether the node is needed only if a predicate of a pending step is true */
+};
+
 /**
  * @brief Internal context for XML data parser.
  */
@@ -116,6 +173,8 @@ struct lyd_xml_ctx {
     lyd_ctx_free_clb free;
 
     struct lyxml_ctx *xmlctx;      /**< XML context */
+    struct lyd_filter *filter;     /**< optional filter of the parsed data */
+    struct lyd_filter_state filter_state; /**< filter state of the children of the currently parsed node */
 };
 
 /**
@@ -140,6 +199,8 @@ struct lyd_json_ctx {
 
     struct lyjson_ctx *jsonctx;         /**< JSON context */
     const struct lysc_node *any_schema; /**< parent anyxml/anydata schema node if parsing nested data tree */
+    struct lyd_filter *filter;          /**< optional filter of the parsed data */
+    struct lyd_filter_state filter_state; /**< filter state of the children of the currently parsed node */
 };
 
 /**
@@ -249,6 +310,7 @@ LY_ERR yin_parse_submodule(struct lysp_yin_ctx **yin_ctx, struct ly_ctx *ctx, st
  * @param[in] parse_opts Options for parser, see @ref dataparseroptions.
  * @param[in] val_opts Options for the validation phase, see @ref datavalidationoptions.
  * @param[in] int_opts Internal data parser options.
+ * @param[in] filter Optional filter to skip the data that cannot affect its results.
  * @param[out] parsed Set to add all the parsed siblings into.
  * @param[out] subtree_sibling Set if ::LYD_PARSE_SUBTREE is used and another subtree is following in @p in.
  * @param[out] lydctx_p Data parser context to finish validation.
@@ -256,7 +318,7 @@ LY_ERR yin_parse_submodule(struct lysp_yin_ctx **yin_ctx, struct ly_ctx *ctx, st
  */
 LY_ERR lyd_parse_xml(const struct ly_ctx *ctx, const struct lysc_ext_instance *ext, struct lyd_node *parent,
         struct lyd_node **first_p, struct ly_in *in, uint32_t parse_opts, uint32_t val_opts, uint32_t int_opts,
-        struct ly_set *parsed, ly_bool *subtree_sibling, struct lyd_ctx **lydctx_p);
+        struct lyd_filter *filter, struct ly_set *parsed, ly_bool *subtree_sibling, struct lyd_ctx **lydctx_p);
 
 /**
  * @brief Parse XML string as a NETCONF message.
@@ -290,6 +352,7 @@ LY_ERR lyd_parse_xml_netconf(const struct ly_ctx *ctx, const struct lysc_ext_ins
  * @param[in] parse_opts Options for parser, see @ref dataparseroptions.
  * @param[in] val_opts Options for the validation phase, see @ref datavalidationoptions.
  * @param[in] int_opts Internal data parser options.
+ * @param[in] filter Optional filter to skip the data that cannot affect its results.
  * @param[out] parsed Set to add all the parsed siblings into.
  * @param[out] subtree_sibling Set if ::LYD_PARSE_SUBTREE is used and another subtree is following in @p in.
  * @param[out] lydctx_p Data parser context to finish validation.
@@ -297,7 +360,7 @@ LY_ERR lyd_parse_xml_netconf(const struct ly_ctx *ctx, const struct lysc_ext_ins
  */
 LY_ERR lyd_parse_json(const struct ly_ctx *ctx, const struct lysc_ext_instance *ext, struct lyd_node *parent,
         struct lyd_node **first_p, struct ly_in *in, uint32_t parse_opts, uint32_t val_opts, uint32_t int_opts,
-        struct ly_set *parsed, ly_bool *subtree_sibling, struct lyd_ctx **lydctx_p);
+        struct lyd_filter *filter, struct ly_set *parsed, ly_bool *subtree_sibling, struct lyd_ctx **lydctx_p);
 
 /**
  * @brief Parse JSON string as a RESTCONF message.
@@ -438,6 +501,53 @@ LY_ERR lyd_parse_check_keys(struct lyd_node *node);
 LY_ERR lyd_parse_set_data_flags(struct lyd_node *node, struct lyd_meta **meta, struct lyd_ctx *lydctx,
         struct lysc_ext_instance *ext);
 
+/**
+ * @brief Compile a parser filter from an XPath expression.
+ *
+ * Only unions of absolute location paths of child and descendant ('//') steps with name tests and predicates
+ * comparing children or the node itself with literals, numbers, or between themselves are supported.
+ *
+ * @param[in] ctx libyang context.
+ * @param[in] xpath XPath expression to compile.
+ * @param[out] filter Compiled filter, NULL if @p xpath is not supported.
+ * @return LY_ERR value.
+ */
+LY_ERR lyd_parser_filter_new(const struct ly_ctx *ctx, const char *xpath, struct lyd_filter **filter);
+
+/**
+ * @brief Free a parser filter.
+ *
+ * @param[in] filter Filter to free.
+ */
+void lyd_parser_filter_free(struct lyd_filter *filter);
+
+/**
+ * @brief Check whether a data node needs to be parsed according to a parser filter.
+ *
+ * A node is not needed if neither it nor any of its descendants can be in the results of the filter nor used
+ * to evaluate its predicates. The filter is conservative, the parsed data still need to be trimmed.
+ *
+ * @param[in] filter Parser filter.
+ * @param[in,out] state Filter state of the parent, is set to the state of the node.
+ * @param[in] snode Schema node of the data node, NULL for an opaque node.
+ * @return Whether the node needs to be parsed.
+ */
+ly_bool lyd_parser_filter_node(struct lyd_filter *filter, struct lyd_filter_state *state, const struct lysc_node *snode);
+
+/**
+ * @brief Evaluate the pending predicates of a parsed data node and check whether it is still needed by a parser filter.
+ *
+ * If the node is not needed, none of its remaining children are parsed.
+ *
+ * @param[in] filter Parser filter.
+ * @param[in,out] state Filter state of the node, is updated.
+ * @param[in] node Data node, may be parsed only partially.
+ * @param[in] keys Whether to evaluate only the predicates referencing only list keys, if all of them are parsed.
+ * @return Whether the node is needed.
+ */
+ly_bool lyd_parser_filter_check(struct lyd_filter *filter, struct lyd_filter_state *state, const struct lyd_node *node,
+        ly_bool keys);
+
 /**
  * @brief Parse an instance extension statement.
  *
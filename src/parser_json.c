@@ -1424,6 +1424,11 @@ lydjson_parse_instance_inner(struct lyd_json_ctx *lydctx, const struct lysc_node
         r = lydjson_subtree_r(lydctx, *node, lyd_node_child_p(*node), NULL);
         LY_DPARSER_ERR_GOTO(r, rc = r, lydctx, cleanup);
 
+        if (lydctx->filter_state.pending) {
+            /* evaluate key predicates of the filter as soon as possible to skip the rest of the list instance */
+            lyd_parser_filter_check(lydctx->filter, &lydctx->filter_state, *node, 1);
+        }
+
         *status = lyjson_ctx_status(lydctx->jsonctx);
     } while (*status == LYJSON_OBJECT_NEXT);
 
@@ -1485,6 +1490,7 @@ lydjson_parse_instance(struct lyd_json_ctx *lydctx, struct lyd_node *parent, str
 {
     LY_ERR r, rc = LY_SUCCESS;
     uint32_t type_hints = 0;
+    struct lyd_filter_state orig_filter_state = lydctx->filter_state;
 
     LOG_LOCSET(snode, NULL);
 
@@ -1528,6 +1534,14 @@ lydjson_parse_instance(struct lyd_json_ctx *lydctx, struct lyd_node *parent, str
         }
         LY_CHECK_GOTO(!*node, cleanup);
 
+        if ((snode->nodetype == LYS_LIST) && lydctx->filter &&
+                !lyd_parser_filter_check(lydctx->filter, &lydctx->filter_state, *node, 0)) {
+            /* not selected by the filter, other nodes may still have sibling metadata referencing them */
+            lyd_free_tree(*node);
+            *node = NULL;
+            goto cleanup;
+        }
+
         /* add/correct flags */
         r = lyd_parse_set_data_flags(*node, &(*node)->meta, (struct lyd_ctx *)lydctx, ext);
         LY_CHECK_ERR_GOTO(r, rc = r, cleanup);
@@ -1554,6 +1568,7 @@ lydjson_parse_instance(struct lyd_json_ctx *lydctx, struct lyd_node *parent, str
     }
 
 cleanup:
+    lydctx->filter_state = orig_filter_state;
     LOG_LOCBACK(1, 0);
     return rc;
 }
@@ -1579,6 +1594,7 @@ lydjson_subtree_r(struct lyd_json_ctx *lydctx, struct lyd_node *parent, struct l
     struct lysc_ext_instance *ext = NULL;
     struct lyd_node *node = NULL, *attr_node = NULL;
     const struct ly_ctx *ctx = lydctx->jsonctx->ctx;
+    struct lyd_filter_state orig_filter_state = lydctx->filter_state;
     char *value = NULL;
 
     assert(parent || first_p);
@@ -1648,6 +1664,11 @@ lydjson_subtree_r(struct lyd_json_ctx *lydctx, struct lyd_node *parent, struct l
         if (!snode) {
             /* we will not be parsing it as metadata */
             is_meta = 0;
+        } else if (lydctx->filter && !lyd_parser_filter_node(lydctx->filter, &lydctx->filter_state, snode)) {
+            /* skip the node or its metadata with children, not needed by the filter */
+            r = lydjson_data_skip(lydctx->jsonctx);
+            LY_CHECK_ERR_GOTO(r, rc = r, cleanup);
+            goto node_parsed;
         }
     }
 
@@ -1809,6 +1830,7 @@ representation_error:
     }
 
 cleanup:
+    lydctx->filter_state = orig_filter_state;
     free(value);
     lyd_free_tree(node);
     return rc;
@@ -1860,7 +1882,7 @@ lyd_parse_json_init(const struct ly_ctx *ctx, struct ly_in *in, uint32_t parse_o
 LY_ERR
 lyd_parse_json(const struct ly_ctx *ctx, const struct lysc_ext_instance *ext, struct lyd_node *parent,
         struct lyd_node **first_p, struct ly_in *in, uint32_t parse_opts, uint32_t val_opts, uint32_t int_opts,
-        struct ly_set *parsed, ly_bool *subtree_sibling, struct lyd_ctx **lydctx_p)
+        struct lyd_filter *filter, struct ly_set *parsed, ly_bool *subtree_sibling, struct lyd_ctx **lydctx_p)
 {
     LY_ERR r, rc = LY_SUCCESS;
     struct lyd_json_ctx *lydctx = NULL;
@@ -1871,6 +1893,10 @@ lyd_parse_json(const struct ly_ctx *ctx, const struct lysc_ext_instance *ext, st
 
     lydctx->int_opts = int_opts;
     lydctx->ext = ext;
+    if (filter) {
+        lydctx->filter = filter;
+        lydctx->filter_state.steps = filter->first;
+    }
 
     /* find the operation node if it exists already */
     LY_CHECK_GOTO(rc = lyd_parser_find_operation(parent, int_opts, &lydctx->op_node), cleanup);
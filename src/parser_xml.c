@@ -834,6 +834,11 @@ lydxml_subtree_inner(struct lyd_xml_ctx *lydctx, const struct lysc_node *snode,
     while (xmlctx->status == LYXML_ELEMENT) {
         r = lydxml_subtree_r(lydctx, *node, lyd_node_child_p(*node), NULL);
         LY_DPARSER_ERR_GOTO(r, rc = r, lydctx, cleanup);
+
+        if (lydctx->filter_state.pending) {
+            /* evaluate key predicates of the filter as soon as possible to skip the rest of the list instance */
+            lyd_parser_filter_check(lydctx->filter, &lydctx->filter_state, *node, 1);
+        }
     }
 
     /* restore options */
@@ -984,6 +989,7 @@ lydxml_subtree_r(struct lyd_xml_ctx *lydctx, struct lyd_node *parent, struct lyd
     struct lysc_ext_instance *ext = NULL;
     uint32_t orig_parse_opts;
     struct lyd_node *node = NULL, *insert_anchor = NULL;
+    struct lyd_filter_state orig_filter_state = lydctx->filter_state;
     ly_bool parse_subtree;
 
     assert(parent || first_p);
@@ -1051,6 +1057,10 @@ lydxml_subtree_r(struct lyd_xml_ctx *lydctx, struct lyd_node *parent, struct lyd
         /* skip element with children */
         rc = lydxml_data_skip(xmlctx);
         goto cleanup;
+    } else if (lydctx->filter && !lyd_parser_filter_node(lydctx->filter, &lydctx->filter_state, snode)) {
+        /* skip element with children, not needed by the filter */
+        rc = lydxml_data_skip(xmlctx);
+        goto cleanup;
     }
 
     /* create metadata/attributes */
@@ -1083,6 +1093,12 @@ lydxml_subtree_r(struct lyd_xml_ctx *lydctx, struct lyd_node *parent, struct lyd
     }
     LY_DPARSER_ERR_GOTO(r, rc = r, lydctx, cleanup);
 
+    if (node && lydctx->filter && !lyd_parser_filter_check(lydctx->filter, &lydctx->filter_state, node, 0)) {
+        /* not selected by the filter */
+        lyd_free_tree(node);
+        node = NULL;
+    }
+
 node_parsed:
     if (node && snode) {
         /* add/correct flags */
@@ -1135,6 +1151,7 @@ node_parsed:
 
 cleanup:
     lydctx->parse_opts = orig_parse_opts;
+    lydctx->filter_state = orig_filter_state;
     lyd_free_meta_siblings(meta);
     lyd_free_attr_siblings(ctx, attr);
     return rc;
@@ -1221,7 +1238,7 @@ cleanup:
 LY_ERR
 lyd_parse_xml(const struct ly_ctx *ctx, const struct lysc_ext_instance *ext, struct lyd_node *parent,
         struct lyd_node **first_p, struct ly_in *in, uint32_t parse_opts, uint32_t val_opts, uint32_t int_opts,
-        struct ly_set *parsed, ly_bool *subtree_sibling, struct lyd_ctx **lydctx_p)
+        struct lyd_filter *filter, struct ly_set *parsed, ly_bool *subtree_sibling, struct lyd_ctx **lydctx_p)
 {
     LY_ERR r, rc = LY_SUCCESS;
     struct lyd_xml_ctx *lydctx;
@@ -1242,6 +1259,10 @@ lyd_parse_xml(const struct ly_ctx *ctx, const struct lysc_ext_instance *ext, str
     lydctx->int_opts = int_opts;
     lydctx->free = lyd_xml_ctx_free;
     lydctx->ext = ext;
+    if (filter) {
+        lydctx->filter = filter;
+        lydctx->filter_state.steps = filter->first;
+    }
 
     /* find the operation node if it exists already */
     LY_CHECK_GOTO(rc = lyd_parser_find_operation(parent, int_opts, &lydctx->op_node), cleanup);
@@ -558,6 +558,9 @@ LIBYANG_API_DECL LY_ERR lyplg_ext_parse_extension_instance(struct lysp_ctx *pctx
  * The parsed generic statements can be processed by the callback on its own or the ::lyplg_ext_compile_extension_instance()
  * function can be used to let the compilation to libyang following the standard rules for processing the YANG statements.
  *
+ * If parallel compilation is allowed by ::ly_ctx_set_compile_threads(), the callback may be called concurrently for
+ * extension instances of different modules so it must not modify any shared state without synchronization.
+ *
  * @param[in] cctx Current compile context.
  * @param[in] extp Parsed extension instance data.
  * @param[in,out] ext Prepared compiled extension instance structure where an addition, extension-specific, data are
@@ -85,4 +85,61 @@ struct lyplg_type *lyplg_type_plugin_find(const struct ly_ctx *ctx, const char *
  */
 struct lyplg_ext_record *lyplg_ext_record_find(const struct ly_ctx *ctx, const char *module, const char *revision, const char *name);
 
+/**
+ * @brief Cache a lazily generated canonical value of a stored value.
+ *
+ * The same value can be printed by several threads at once so the canonical value is set atomically and
+ * the string of a thread that lost the race is released.
+ *
+ * @param[in] ctx Context of the value.
+ * @param[in] value Value to cache the canonical value in.
+ * @param[in] canon Generated canonical value, is always spent.
+ * @return Cached canonical value, NULL on error.
+ */
+const char *lyplg_type_canonical_cache(const struct ly_ctx *ctx, const struct lyd_value *value, char *canon);
+
+/**
+ * @brief Convert a dotted-decimal IPv4 address into its binary (network-byte order) form.
+ *
+ * Accepts the same strings as inet_pton(3), but does not require @p str to be terminated.
+ *
+ * @param[in] str IPv4 address string.
+ * @param[in] str_len Length of @p str.
+ * @param[out] bin Binary address, 4 bytes.
+ * @return LY_SUCCESS on success.
+ * @return LY_EVALID if @p str is not a valid IPv4 address.
+ */
+LY_ERR lyplg_type_ipv4_str2bin(const char *str, size_t str_len, uint8_t *bin);
+
+/**
+ * @brief Convert an IPv6 address into its binary (network-byte order) form.
+ *
+ * Accepts the same strings as inet_pton(3), but does not require @p str to be terminated.
+ *
+ * @param[in] str IPv6 address string.
+ * @param[in] str_len Length of @p str.
+ * @param[out] bin Binary address, 16 bytes.
+ * @return LY_SUCCESS on success.
+ * @return LY_EVALID if @p str is not a valid IPv6 address.
+ */
+LY_ERR lyplg_type_ipv6_str2bin(const char *str, size_t str_len, uint8_t *bin);
+
+/**
+ * @brief Print a binary IPv4 address in the dotted-decimal notation.
+ *
+ * @param[in] bin Binary address, 4 bytes.
+ * @param[in] buf Buffer of at least INET_ADDRSTRLEN bytes to print into.
+ * @return Length of the printed (terminated) string.
+ */
+uint32_t lyplg_type_ipv4_bin2str(const uint8_t *bin, char *buf);
+
+/**
+ * @brief Print a binary IPv6 address in the same (RFC 5952) form as inet_ntop(3).
+ *
+ * @param[in] bin Binary address, 16 bytes.
+ * @param[in] buf Buffer of at least INET6_ADDRSTRLEN bytes to print into.
+ * @return Length of the printed (terminated) string.
+ */
+uint32_t lyplg_type_ipv6_bin2str(const uint8_t *bin, char *buf);
+
 #endif /* LY_PLUGINS_INTERNAL_H_ */
@@ -917,16 +917,19 @@ lyplg_type_make_implemented(struct lys_module *mod, const char **features, struc
 LIBYANG_API_DEF LY_ERR
 lyplg_type_identity_isderived(const struct lysc_ident *base, const struct lysc_ident *der)
 {
-    LY_ARRAY_COUNT_TYPE u;
+    LY_ARRAY_COUNT_TYPE lo = 0, hi = LY_ARRAY_COUNT(der->ancestors), mid;
 
     assert(base->module->ctx == der->module->ctx);
 
-    LY_ARRAY_FOR(base->derived, u) {
-        if (der == base->derived[u]) {
-            return LY_SUCCESS;
-        }
-        if (!lyplg_type_identity_isderived(base->derived[u], der)) {
+    /* the sorted ancestors include all the identities @p der is derived from */
+    while (lo < hi) {
+        mid = lo + (hi - lo) / 2;
+        if (der->ancestors[mid] == base->index) {
             return LY_SUCCESS;
+        } else if (der->ancestors[mid] < base->index) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
         }
     }
     return LY_ENOTFOUND;
@@ -1120,3 +1123,238 @@ cleanup:
     lyxp_set_free_content(&set);
     return rc;
 }
+
+const char *
+lyplg_type_canonical_cache(const struct ly_ctx *ctx, const struct lyd_value *value, char *canon)
+{
+    const char *str;
+
+    if (lydict_insert_zc(ctx, canon, &str)) {
+        LOGMEM(ctx);
+        return NULL;
+    }
+
+    if (!LY_ATOMIC_CAS_BARRIER(((struct lyd_value *)value)->_canonical, NULL, str)) {
+        /* another thread was faster */
+        lydict_remove(ctx, str);
+    }
+    return value->_canonical;
+}
+
+LY_ERR
+lyplg_type_ipv4_str2bin(const char *str, size_t str_len, uint8_t *bin)
+{
+    size_t i;
+    uint32_t octet = 0, octets = 0, digits = 0;
+
+    for (i = 0; i < str_len; ++i) {
+        if ((str[i] >= '0') && (str[i] <= '9')) {
+            if (digits && !octet) {
+                /* leading zeros are not allowed */
+                return LY_EVALID;
+            }
+            octet = octet * 10 + (str[i] - '0');
+            if ((octet > 255) || (++digits > 3)) {
+                return LY_EVALID;
+            }
+        } else if ((str[i] == '.') && digits && (octets < 3)) {
+            bin[octets++] = octet;
+            octet = 0;
+            digits = 0;
+        } else {
+            return LY_EVALID;
+        }
+    }
+    if (!digits || (octets != 3)) {
+        return LY_EVALID;
+    }
+    bin[octets] = octet;
+
+    return LY_SUCCESS;
+}
+
+LY_ERR
+lyplg_type_ipv6_str2bin(const char *str, size_t str_len, uint8_t *bin)
+{
+    uint8_t tmp[16] = {0};
+    size_t i = 0, tok_start, gap_len;
+    int32_t gap = -1;
+    uint32_t len = 0, word = 0, digits = 0;
+    char c;
+
+    /* a leading colon must be a part of "::" */
+    if (str_len && (str[0] == ':')) {
+        if ((str_len < 2) || (str[1] != ':')) {
+            return LY_EVALID;
+        }
+        ++i;
+    }
+
+    tok_start = i;
+    while (i < str_len) {
+        c = str[i++];
+        if (((c >= '0') && (c <= '9')) || ((c >= 'a') && (c <= 'f')) || ((c >= 'A') && (c <= 'F'))) {
+            word = (word << 4) | ((c <= '9') ? c - '0' : (c | 0x20) - 'a' + 10);
+            if (++digits > 4) {
+                return LY_EVALID;
+            }
+        } else if (c == ':') {
+            tok_start = i;
+            if (!digits) {
+                /* "::", only once */
+                if (gap > -1) {
+                    return LY_EVALID;
+                }
+                gap = len;
+                continue;
+            } else if ((i == str_len) || (len + 2 > 16)) {
+                /* trailing single colon or too many groups */
+                return LY_EVALID;
+            }
+            tmp[len++] = word >> 8;
+            tmp[len++] = word;
+            word = 0;
+            digits = 0;
+        } else if ((c == '.') && (len + 4 <= 16) &&
+                !lyplg_type_ipv4_str2bin(str + tok_start, str_len - tok_start, tmp + len)) {
+            /* embedded IPv4 address ends the string */
+            len += 4;
+            digits = 0;
+            break;
+        } else {
+            return LY_EVALID;
+        }
+    }
+
+    if (digits) {
+        if (len + 2 > 16) {
+            return LY_EVALID;
+        }
+        tmp[len++] = word >> 8;
+        tmp[len++] = word;
+    }
+
+    if (gap > -1) {
+        /* expand "::" by moving all the groups after it to the end */
+        if (len == 16) {
+            return LY_EVALID;
+        }
+        gap_len = len - gap;
+        memmove(tmp + 16 - gap_len, tmp + gap, gap_len);
+        memset(tmp + gap, 0, 16 - gap_len - gap);
+        len = 16;
+    }
+    if (len != 16) {
+        return LY_EVALID;
+    }
+
+    memcpy(bin, tmp, 16);
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Print an unsigned number in decimal.
+ *
+ * @param[in] num Number to print.
+ * @param[in] buf Buffer to print into, not terminated.
+ * @return Number of characters printed.
+ */
+static uint32_t
+lyplg_type_print_dec(uint32_t num, char *buf)
+{
+    char digits[10];
+    uint32_t len = 0, i;
+
+    do {
+        digits[len++] = '0' + num % 10;
+        num /= 10;
+    } while (num);
+
+    for (i = 0; i < len; ++i) {
+        buf[i] = digits[len - i - 1];
+    }
+    return len;
+}
+
+uint32_t
+lyplg_type_ipv4_bin2str(const uint8_t *bin, char *buf)
+{
+    uint32_t len = 0, i;
+
+    for (i = 0; i < 4; ++i) {
+        if (i) {
+            buf[len++] = '.';
+        }
+        len += lyplg_type_print_dec(bin[i], buf + len);
+    }
+    buf[len] = '\0';
+
+    return len;
+}
+
+uint32_t
+lyplg_type_ipv6_bin2str(const uint8_t *bin, char *buf)
+{
+    static const char hex[] = "0123456789abcdef";
+    uint16_t words[8];
+    int32_t best = -1, best_len = 0, cur = -1, cur_len = 0;
+    uint32_t len = 0, i, shift;
+
+    for (i = 0; i < 8; ++i) {
+        words[i] = (bin[2 * i] << 8) | bin[2 * i + 1];
+    }
+
+    /* find the longest run of zero groups, the first one wins */
+    for (i = 0; i < 8; ++i) {
+        if (!words[i]) {
+            if (cur == -1) {
+                cur = i;
+                cur_len = 0;
+            }
+            ++cur_len;
+        }
+        if ((cur > -1) && (words[i] || (i == 7))) {
+            if (cur_len > best_len) {
+                best = cur;
+                best_len = cur_len;
+            }
+            cur = -1;
+        }
+    }
+    if (best_len < 2) {
+        /* a single zero group is not compressed */
+        best = -1;
+    }
+
+    for (i = 0; i < 8; ++i) {
+        if ((best > -1) && ((int32_t)i >= best) && ((int32_t)i < best + best_len)) {
+            /* compressed run */
+            if ((int32_t)i == best) {
+                buf[len++] = ':';
+            }
+            continue;
+        }
+
+        if (i) {
+            buf[len++] = ':';
+        }
+
+        if ((i == 6) && !best && ((best_len == 6) || ((best_len == 5) && (words[5] == 0xffff)))) {
+            /* IPv4-compatible or IPv4-mapped address */
+            len += lyplg_type_ipv4_bin2str(bin + 12, buf + len);
+            return len;
+        }
+
+        /* hex group without leading zeros */
+        for (shift = 16; (shift > 4) && !(words[i] >> (shift - 4)); shift -= 4) {}
+        for ( ; shift; shift -= 4) {
+            buf[len++] = hex[(words[i] >> (shift - 4)) & 0xf];
+        }
+    }
+    if ((best > -1) && (best + best_len == 8)) {
+        buf[len++] = ':';
+    }
+    buf[len] = '\0';
+
+    return len;
+}
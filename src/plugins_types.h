@@ -75,11 +75,17 @@ struct lysc_type_leafref;
  * The main functionality is provided via ::lyplg_type_store_clb callback responsible for canonizing and storing
  * provided string representation of the value in specified format (XML and JSON supported). Valid value is stored in
  * ::lyd_value structure - its union allows to store data as one of the predefined type or in a custom form behind
- * the void *ptr member of ::lyd_value structure. The callback is also responsible for storing canonized string
- * representation of the value as ::lyd_value._canonical. If the type does not define canonical representation, the original
- * representation is stored. In case there are any differences between the representation in specific input types, the plugin
- * is supposed to store the value in JSON representation - typically, the difference is in prefix representation and JSON
- * format uses directly the module names as prefixes.
+ * the void *ptr member of ::lyd_value structure. The callback may also store canonized string representation of the value
+ * as ::lyd_value._canonical but it can be left NULL, in which case ::lyplg_type_print_clb generates it on first use and caches
+ * it there. If the type does not define canonical representation, the original representation is used. In case there are
+ * any differences between the representation in specific input types, the plugin is supposed to store the value in JSON
+ * representation - typically, the difference is in prefix representation and JSON format uses directly the module names
+ * as prefixes.
+ *
+ * Since the built-in integer, decimal64, boolean, enumeration, and union types (among others) generate their canonical
+ * value lazily, ::lyd_value._canonical may be NULL for any stored value. Neither plugins nor applications may read it
+ * directly, the canonical value must always be obtained by ::lyd_value_get_canonical() (or ::lyd_get_value() and
+ * ::lyd_get_meta_value() for data nodes and metadata).
  *
  * Usually, all the validation according to the type's restrictions is done in the store callback. However, in case the type
  * requires some validation referencing other entities in the data tree, the optional validation callback
@@ -89,8 +95,8 @@ struct lysc_type_leafref;
  * the values is to compare their canonical string representations, the ::lyplg_type_compare_simple() function can be used.
  *
  * Data duplication is done with ::lyplg_type_dup_clb callbacks. Note that the callback is responsible even for duplicating
- * the ::lyd_value._canonical, so the callback must be always present (the canonical value is always present). If there is
- * nothing else to duplicate, the plugin can use the generic ::lyplg_type_dup_simple().
+ * the ::lyd_value._canonical, if already generated, so the callback must be always present. If there is nothing else
+ * to duplicate, the plugin can use the generic ::lyplg_type_dup_simple().
  *
  * The stored value can be printed into the required format via ::lyplg_type_print_clb implementation. Simple printing
  * canonical representation of the value is implemented by ::lyplg_type_print_simple().
@@ -649,7 +655,8 @@ struct lyplg_type_record {
  * @{
  *
  * Simple functions implementing @ref howtoPluginsTypes callbacks handling types that allocate no dynamic
- * value and always generate their canonical value (::lyd_value._canonical).
+ * value and always store their canonical value (::lyd_value._canonical) in the store callback. Types generating
+ * the canonical value lazily must implement their own ::lyplg_type_print_clb.
  */
 
 /**
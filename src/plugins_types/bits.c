@@ -423,8 +423,7 @@ lyplg_type_print_bits(const struct ly_ctx *ctx, const struct lyd_value *value, L
         }
 
         /* store it */
-        if (lydict_insert_zc(ctx, ret, (const char **)&value->_canonical)) {
-            LOGMEM(ctx);
+        if (!lyplg_type_canonical_cache(ctx, value, ret)) {
             return NULL;
         }
     }
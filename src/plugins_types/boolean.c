@@ -58,10 +58,6 @@ lyplg_type_store_boolean(const struct ly_ctx *ctx, const struct lysc_type *type,
         i = *(int8_t *)value;
         storage->boolean = i ? 1 : 0;
 
-        /* store canonical value, it always is */
-        ret = lydict_insert(ctx, i ? "true" : "false", 0, &storage->_canonical);
-        LY_CHECK_GOTO(ret, cleanup);
-
         /* success */
         goto cleanup;
     }
@@ -82,16 +78,6 @@ lyplg_type_store_boolean(const struct ly_ctx *ctx, const struct lysc_type *type,
     }
     storage->boolean = i;
 
-    /* store canonical value, it always is */
-    if (options & LYPLG_TYPE_STORE_DYNAMIC) {
-        ret = lydict_insert_zc(ctx, (char *)value, &storage->_canonical);
-        options &= ~LYPLG_TYPE_STORE_DYNAMIC;
-        LY_CHECK_GOTO(ret, cleanup);
-    } else {
-        ret = lydict_insert(ctx, value, value_len, &storage->_canonical);
-        LY_CHECK_GOTO(ret, cleanup);
-    }
-
 cleanup:
     if (options & LYPLG_TYPE_STORE_DYNAMIC) {
         free((char *)value);
@@ -136,14 +122,14 @@ lyplg_type_print_boolean(const struct ly_ctx *UNUSED(ctx), const struct lyd_valu
         return &value->boolean;
     }
 
-    /* use the cached canonical value */
+    /* constant canonical value, no need to cache it */
     if (dynamic) {
         *dynamic = 0;
     }
     if (value_len) {
-        *value_len = strlen(value->_canonical);
+        *value_len = value->boolean ? ly_strlen_const("true") : ly_strlen_const("false");
     }
-    return value->_canonical;
+    return value->boolean ? "true" : "false";
 }
 
 /**
@@ -29,6 +29,7 @@
 #include "compat.h"
 #include "ly_common.h"
 #include "plugins_internal.h" /* LY_TYPE_*_STR */
+#include "tree_data_internal.h"
 
 /**
  * @page howtoDataLYB LYB Binary Format
@@ -265,7 +266,6 @@ lyplg_type_print_date_and_time(const struct ly_ctx *ctx, const struct lyd_value
         void *UNUSED(prefix_data), ly_bool *dynamic, size_t *value_len)
 {
     struct lyd_value_date_and_time *val;
-    struct tm tm;
     char *ret;
 
     LYD_VALUE_GET(value, val);
@@ -298,12 +298,7 @@ lyplg_type_print_date_and_time(const struct ly_ctx *ctx, const struct lyd_value
     if (!value->_canonical) {
         if (val->unknown_tz) {
             /* ly_time_time2str but always using GMT */
-            if (!gmtime_r(&val->time, &tm)) {
-                return NULL;
-            }
-            if (asprintf(&ret, "%04d-%02d-%02dT%02d:%02d:%02d%s%s-00:00",
-                    tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec,
-                    val->fractions_s ? "." : "", val->fractions_s ? val->fractions_s : "") == -1) {
+            if (ly_time_time2str_utc(val->time, val->fractions_s, 1, &ret)) {
                 return NULL;
             }
         } else {
@@ -313,8 +308,7 @@ lyplg_type_print_date_and_time(const struct ly_ctx *ctx, const struct lyd_value
         }
 
         /* store it */
-        if (lydict_insert_zc(ctx, ret, (const char **)&value->_canonical)) {
-            LOGMEM(ctx);
+        if (!lyplg_type_canonical_cache(ctx, value, ret)) {
             return NULL;
         }
     }
@@ -40,18 +40,11 @@ static LY_ERR lyplg_type_validate_decimal64(const struct ly_ctx *UNUSED(ctx), co
  *
  * @param[in] num Decimal64 number stored in int64.
  * @param[in] type Decimal64 type with fraction digits.
- * @param[out] str Canonical string value.
- * @return LY_ERR value.
+ * @param[in] ret Buffer of ::LY_NUMBER_MAXLEN bytes to print the canonical string value into.
  */
-static LY_ERR
-decimal64_num2str(int64_t num, struct lysc_type_dec *type, char **str)
+static void
+decimal64_num2str(int64_t num, const struct lysc_type_dec *type, char *ret)
 {
-    char *ret;
-
-    /* allocate the value */
-    ret = calloc(1, LY_NUMBER_MAXLEN);
-    LY_CHECK_RET(!ret, LY_EMEM);
-
     if (num) {
         int count = sprintf(ret, "%" PRId64 " ", num);
 
@@ -77,9 +70,6 @@ decimal64_num2str(int64_t num, struct lysc_type_dec *type, char **str)
         /* zero */
         sprintf(ret, "0.0");
     }
-
-    *str = ret;
-    return LY_SUCCESS;
 }
 
 LIBYANG_API_DEF LY_ERR
@@ -91,7 +81,6 @@ lyplg_type_store_decimal64(const struct ly_ctx *ctx, const struct lysc_type *typ
     struct lysc_type_dec *type_dec = (struct lysc_type_dec *)type;
     LY_ERR ret = LY_SUCCESS;
     int64_t num;
-    char *canon;
 
     /* init storage */
     memset(storage, 0, sizeof *storage);
@@ -121,27 +110,6 @@ lyplg_type_store_decimal64(const struct ly_ctx *ctx, const struct lysc_type *typ
     /* store value */
     storage->dec64 = num;
 
-    /* we need canonical value for the range check */
-    if (format == LY_VALUE_CANON) {
-        /* store canonical value */
-        if (options & LYPLG_TYPE_STORE_DYNAMIC) {
-            ret = lydict_insert_zc(ctx, (char *)value, &storage->_canonical);
-            options &= ~LYPLG_TYPE_STORE_DYNAMIC;
-            LY_CHECK_GOTO(ret, cleanup);
-        } else {
-            ret = lydict_insert(ctx, value, value_len, &storage->_canonical);
-            LY_CHECK_GOTO(ret, cleanup);
-        }
-    } else {
-        /* generate canonical value */
-        ret = decimal64_num2str(num, type_dec, &canon);
-        LY_CHECK_GOTO(ret, cleanup);
-
-        /* store it */
-        ret = lydict_insert_zc(ctx, canon, (const char **)&storage->_canonical);
-        LY_CHECK_GOTO(ret, cleanup);
-    }
-
     if (!(options & LYPLG_TYPE_STORE_ONLY)) {
         /* validate value */
         ret = lyplg_type_validate_decimal64(ctx, type, NULL, NULL, storage, err);
@@ -169,15 +137,18 @@ lyplg_type_validate_decimal64(const struct ly_ctx *UNUSED(ctx), const struct lys
     LY_ERR ret;
     struct lysc_type_dec *type_dec = (struct lysc_type_dec *)type;
     int64_t num;
+    char canon[LY_NUMBER_MAXLEN];
 
     LY_CHECK_ARG_RET(NULL, type, storage, err, LY_EINVAL);
     *err = NULL;
     num = storage->dec64;
 
     if (type_dec->range) {
+        /* the canonical value may not be generated, print the number for a possible error message */
+        decimal64_num2str(num, type_dec, canon);
+
         /* check range of the number */
-        ret = lyplg_type_validate_range(type->basetype, type_dec->range, num, storage->_canonical,
-                strlen(storage->_canonical), err);
+        ret = lyplg_type_validate_range(type->basetype, type_dec->range, num, canon, strlen(canon), err);
         LY_CHECK_RET(ret);
     }
 
@@ -208,11 +179,12 @@ lyplg_type_sort_decimal64(const struct ly_ctx *UNUSED(ctx), const struct lyd_val
 }
 
 LIBYANG_API_DEF const void *
-lyplg_type_print_decimal64(const struct ly_ctx *UNUSED(ctx), const struct lyd_value *value, LY_VALUE_FORMAT format,
+lyplg_type_print_decimal64(const struct ly_ctx *ctx, const struct lyd_value *value, LY_VALUE_FORMAT format,
         void *UNUSED(prefix_data), ly_bool *dynamic, size_t *value_len)
 {
     int64_t num = 0;
     void *buf;
+    char *canon;
 
     if (format == LY_VALUE_LYB) {
         num = htole64(value->dec64);
@@ -237,6 +209,17 @@ lyplg_type_print_decimal64(const struct ly_ctx *UNUSED(ctx), const struct lyd_va
         }
     }
 
+    /* generate canonical value if not already */
+    if (!value->_canonical) {
+        canon = malloc(LY_NUMBER_MAXLEN);
+        LY_CHECK_ERR_RET(!canon, LOGMEM(ctx), NULL);
+        decimal64_num2str(value->dec64, (struct lysc_type_dec *)value->realtype, canon);
+
+        if (!lyplg_type_canonical_cache(ctx, value, canon)) {
+            return NULL;
+        }
+    }
+
     /* use the cached canonical value */
     if (dynamic) {
         *dynamic = 0;
@@ -83,10 +83,6 @@ lyplg_type_store_enum(const struct ly_ctx *ctx, const struct lysc_type *type, co
         /* store value */
         storage->enum_item = &type_enum->enums[u];
 
-        /* canonical settings via dictionary due to free callback */
-        ret = lydict_insert(ctx, type_enum->enums[u].name, 0, &storage->_canonical);
-        LY_CHECK_GOTO(ret, cleanup);
-
         /* success */
         goto cleanup;
     }
@@ -113,16 +109,6 @@ lyplg_type_store_enum(const struct ly_ctx *ctx, const struct lysc_type *type, co
     /* store value */
     storage->enum_item = &type_enum->enums[u];
 
-    /* store canonical value, it always is */
-    if (options & LYPLG_TYPE_STORE_DYNAMIC) {
-        ret = lydict_insert_zc(ctx, (char *)value, &storage->_canonical);
-        options &= ~LYPLG_TYPE_STORE_DYNAMIC;
-        LY_CHECK_GOTO(ret, cleanup);
-    } else {
-        ret = lydict_insert(ctx, value, value_len, &storage->_canonical);
-        LY_CHECK_GOTO(ret, cleanup);
-    }
-
 cleanup:
     if (options & LYPLG_TYPE_STORE_DYNAMIC) {
         free((void *)value);
@@ -178,14 +164,14 @@ lyplg_type_print_enum(const struct ly_ctx *UNUSED(ctx), const struct lyd_value *
         }
     }
 
-    /* use the cached canonical value */
+    /* the canonical value is the enum name in the schema dictionary, no need to cache it */
     if (dynamic) {
         *dynamic = 0;
     }
     if (value_len) {
-        *value_len = strlen(value->_canonical);
+        *value_len = strlen(value->enum_item->name);
     }
-    return value->_canonical;
+    return value->enum_item->name;
 }
 
 /**
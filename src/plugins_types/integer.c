@@ -56,7 +56,6 @@ lyplg_type_store_int(const struct ly_ctx *ctx, const struct lysc_type *type, con
     LY_ERR ret = LY_SUCCESS;
     int64_t num = 0;
     int base = 1;
-    char *canon = NULL;
 
     /* init storage */
     memset(storage, 0, sizeof *storage);
@@ -122,40 +121,6 @@ lyplg_type_store_int(const struct ly_ctx *ctx, const struct lysc_type *type, con
         break;
     }
 
-    if (format == LY_VALUE_CANON) {
-        /* store canonical value */
-        if (options & LYPLG_TYPE_STORE_DYNAMIC) {
-            ret = lydict_insert_zc(ctx, (char *)value, &storage->_canonical);
-            options &= ~LYPLG_TYPE_STORE_DYNAMIC;
-            LY_CHECK_GOTO(ret, cleanup);
-        } else {
-            ret = lydict_insert(ctx, value, value_len, &storage->_canonical);
-            LY_CHECK_GOTO(ret, cleanup);
-        }
-    } else {
-        /* generate canonical value */
-        switch (type->basetype) {
-        case LY_TYPE_INT8:
-            LY_CHECK_ERR_GOTO(asprintf(&canon, "%" PRId8, storage->int8) == -1, ret = LY_EMEM, cleanup);
-            break;
-        case LY_TYPE_INT16:
-            LY_CHECK_ERR_GOTO(asprintf(&canon, "%" PRId16, storage->int16) == -1, ret = LY_EMEM, cleanup);
-            break;
-        case LY_TYPE_INT32:
-            LY_CHECK_ERR_GOTO(asprintf(&canon, "%" PRId32, storage->int32) == -1, ret = LY_EMEM, cleanup);
-            break;
-        case LY_TYPE_INT64:
-            LY_CHECK_ERR_GOTO(asprintf(&canon, "%" PRId64, storage->int64) == -1, ret = LY_EMEM, cleanup);
-            break;
-        default:
-            break;
-        }
-
-        /* store it */
-        ret = lydict_insert_zc(ctx, canon, (const char **)&storage->_canonical);
-        LY_CHECK_GOTO(ret, cleanup);
-    }
-
     if (!(options & LYPLG_TYPE_STORE_ONLY)) {
         /* validate value */
         ret = lyplg_type_validate_int(ctx, type, NULL, NULL, storage, err);
@@ -183,6 +148,7 @@ lyplg_type_validate_int(const struct ly_ctx *UNUSED(ctx), const struct lysc_type
     LY_ERR ret;
     struct lysc_type_num *type_num = (struct lysc_type_num *)type;
     int64_t num;
+    char canon[LY_NUMBER_MAXLEN];
 
     LY_CHECK_ARG_RET(NULL, type, storage, err, LY_EINVAL);
     *err = NULL;
@@ -207,8 +173,9 @@ lyplg_type_validate_int(const struct ly_ctx *UNUSED(ctx), const struct lysc_type
 
     /* validate range of the number */
     if (type_num->range) {
-        ret = lyplg_type_validate_range(type->basetype, type_num->range, num, storage->_canonical,
-                strlen(storage->_canonical), err);
+        /* the canonical value may not be generated, print the number for a possible error message */
+        sprintf(canon, "%" PRId64, num);
+        ret = lyplg_type_validate_range(type->basetype, type_num->range, num, canon, strlen(canon), err);
         LY_CHECK_RET(ret);
     }
 
@@ -296,29 +263,31 @@ lyplg_type_sort_int(const struct ly_ctx *UNUSED(ctx), const struct lyd_value *va
 }
 
 LIBYANG_API_DEF const void *
-lyplg_type_print_int(const struct ly_ctx *UNUSED(ctx), const struct lyd_value *value, LY_VALUE_FORMAT format,
+lyplg_type_print_int(const struct ly_ctx *ctx, const struct lyd_value *value, LY_VALUE_FORMAT format,
         void *UNUSED(prefix_data), ly_bool *dynamic, size_t *value_len)
 {
     int64_t prev_num = 0, num = 0;
     void *buf;
+    char *canon;
+
+    switch (value->realtype->basetype) {
+    case LY_TYPE_INT8:
+        prev_num = num = value->int8;
+        break;
+    case LY_TYPE_INT16:
+        prev_num = num = value->int16;
+        break;
+    case LY_TYPE_INT32:
+        prev_num = num = value->int32;
+        break;
+    case LY_TYPE_INT64:
+        prev_num = num = value->int64;
+        break;
+    default:
+        break;
+    }
 
     if (format == LY_VALUE_LYB) {
-        switch (value->realtype->basetype) {
-        case LY_TYPE_INT8:
-            prev_num = num = value->int8;
-            break;
-        case LY_TYPE_INT16:
-            prev_num = num = value->int16;
-            break;
-        case LY_TYPE_INT32:
-            prev_num = num = value->int32;
-            break;
-        case LY_TYPE_INT64:
-            prev_num = num = value->int64;
-            break;
-        default:
-            break;
-        }
         num = htole64(num);
         if (num == prev_num) {
             /* values are equal, little-endian or int8 */
@@ -341,6 +310,17 @@ lyplg_type_print_int(const struct ly_ctx *UNUSED(ctx), const struct lyd_value *v
         }
     }
 
+    /* generate canonical value if not already */
+    if (!value->_canonical) {
+        if (asprintf(&canon, "%" PRId64, prev_num) == -1) {
+            LOGMEM(ctx);
+            return NULL;
+        }
+        if (!lyplg_type_canonical_cache(ctx, value, canon)) {
+            return NULL;
+        }
+    }
+
     /* use the cached canonical value */
     if (dynamic) {
         *dynamic = 0;
@@ -360,7 +340,6 @@ lyplg_type_store_uint(const struct ly_ctx *ctx, const struct lysc_type *type, co
     LY_ERR ret = LY_SUCCESS;
     uint64_t num = 0;
     int base = 0;
-    char *canon;
 
     /* init storage */
     memset(storage, 0, sizeof *storage);
@@ -421,25 +400,6 @@ lyplg_type_store_uint(const struct ly_ctx *ctx, const struct lysc_type *type, co
         break;
     }
 
-    if (format == LY_VALUE_CANON) {
-        /* store canonical value */
-        if (options & LYPLG_TYPE_STORE_DYNAMIC) {
-            ret = lydict_insert_zc(ctx, (char *)value, &storage->_canonical);
-            options &= ~LYPLG_TYPE_STORE_DYNAMIC;
-            LY_CHECK_GOTO(ret, cleanup);
-        } else {
-            ret = lydict_insert(ctx, value, value_len, &storage->_canonical);
-            LY_CHECK_GOTO(ret, cleanup);
-        }
-    } else {
-        /* generate canonical value */
-        LY_CHECK_ERR_GOTO(asprintf(&canon, "%" PRIu64, num) == -1, ret = LY_EMEM, cleanup);
-
-        /* store it */
-        ret = lydict_insert_zc(ctx, canon, (const char **)&storage->_canonical);
-        LY_CHECK_GOTO(ret, cleanup);
-    }
-
     if (!(options & LYPLG_TYPE_STORE_ONLY)) {
         /* validate value */
         ret = lyplg_type_validate_uint(ctx, type, NULL, NULL, storage, err);
@@ -467,6 +427,7 @@ lyplg_type_validate_uint(const struct ly_ctx *UNUSED(ctx), const struct lysc_typ
     LY_ERR ret;
     struct lysc_type_num *type_num = (struct lysc_type_num *)type;
     uint64_t num;
+    char canon[LY_NUMBER_MAXLEN];
 
     LY_CHECK_ARG_RET(NULL, type, storage, err, LY_EINVAL);
     *err = NULL;
@@ -491,8 +452,9 @@ lyplg_type_validate_uint(const struct ly_ctx *UNUSED(ctx), const struct lysc_typ
 
     /* validate range of the number */
     if (type_num->range) {
-        ret = lyplg_type_validate_range(type->basetype, type_num->range, num, storage->_canonical,
-                strlen(storage->_canonical), err);
+        /* the canonical value may not be generated, print the number for a possible error message */
+        sprintf(canon, "%" PRIu64, num);
+        ret = lyplg_type_validate_range(type->basetype, type_num->range, num, canon, strlen(canon), err);
         LY_CHECK_RET(ret);
     }
 
@@ -576,29 +538,31 @@ lyplg_type_sort_uint(const struct ly_ctx *UNUSED(ctx), const struct lyd_value *v
 }
 
 LIBYANG_API_DEF const void *
-lyplg_type_print_uint(const struct ly_ctx *UNUSED(ctx), const struct lyd_value *value, LY_VALUE_FORMAT format,
+lyplg_type_print_uint(const struct ly_ctx *ctx, const struct lyd_value *value, LY_VALUE_FORMAT format,
         void *UNUSED(prefix_data), ly_bool *dynamic, size_t *value_len)
 {
     uint64_t num = 0;
     void *buf;
+    char *canon;
+
+    switch (value->realtype->basetype) {
+    case LY_TYPE_UINT8:
+        num = value->uint8;
+        break;
+    case LY_TYPE_UINT16:
+        num = value->uint16;
+        break;
+    case LY_TYPE_UINT32:
+        num = value->uint32;
+        break;
+    case LY_TYPE_UINT64:
+        num = value->uint64;
+        break;
+    default:
+        break;
+    }
 
     if (format == LY_VALUE_LYB) {
-        switch (value->realtype->basetype) {
-        case LY_TYPE_UINT8:
-            num = value->uint8;
-            break;
-        case LY_TYPE_UINT16:
-            num = value->uint16;
-            break;
-        case LY_TYPE_UINT32:
-            num = value->uint32;
-            break;
-        case LY_TYPE_UINT64:
-            num = value->uint64;
-            break;
-        default:
-            break;
-        }
         num = htole64(num);
         if (num == value->uint64) {
             /* values are equal, little-endian or uint8 */
@@ -621,6 +585,17 @@ lyplg_type_print_uint(const struct ly_ctx *UNUSED(ctx), const struct lyd_value *
         }
     }
 
+    /* generate canonical value if not already */
+    if (!value->_canonical) {
+        if (asprintf(&canon, "%" PRIu64, num) == -1) {
+            LOGMEM(ctx);
+            return NULL;
+        }
+        if (!lyplg_type_canonical_cache(ctx, value, canon)) {
+            return NULL;
+        }
+    }
+
     /* use the cached canonical value */
     if (dynamic) {
         *dynamic = 0;
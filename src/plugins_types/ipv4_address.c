@@ -12,8 +12,6 @@
  *     https://opensource.org/licenses/BSD-3-Clause
  */
 
-#define _GNU_SOURCE /* strndup */
-
 #include "plugins_internal.h"
 #include "plugins_types.h"
 
@@ -28,7 +26,6 @@
 #  endif
 #endif
 #include <ctype.h>
-#include <errno.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
@@ -55,7 +52,6 @@ static void lyplg_type_free_ipv4_address(const struct ly_ctx *ctx, struct lyd_va
  *
  * @param[in] value Value to convert.
  * @param[in] value_len Length of @p value.
- * @param[in] options Type store callback options.
  * @param[in] ctx libyang context with dictionary.
  * @param[in,out] addr Allocated value for the address.
  * @param[out] zone Ipv6 address zone in dictionary.
@@ -63,57 +59,30 @@ static void lyplg_type_free_ipv4_address(const struct ly_ctx *ctx, struct lyd_va
  * @return LY_ERR value.
  */
 static LY_ERR
-ipv4address_str2ip(const char *value, size_t value_len, uint32_t options, const struct ly_ctx *ctx,
-        struct in_addr *addr, const char **zone, struct ly_err_item **err)
+ipv4address_str2ip(const char *value, size_t value_len, const struct ly_ctx *ctx, struct in_addr *addr,
+        const char **zone, struct ly_err_item **err)
 {
-    LY_ERR ret = LY_SUCCESS;
-    const char *addr_no_zone;
-    char *zone_ptr = NULL, *addr_dyn = NULL;
-    size_t zone_len;
+    const char *zone_ptr;
+    size_t addr_len;
 
-    /* store zone and get the string IPv4 address without it */
+    /* store zone and get the length of the IPv4 address without it */
     if ((zone_ptr = ly_strnchr(value, '%', value_len))) {
         /* there is a zone index */
-        zone_len = value_len - (zone_ptr - value) - 1;
-        ret = lydict_insert(ctx, zone_ptr + 1, zone_len, zone);
-        LY_CHECK_GOTO(ret, cleanup);
-
-        /* get the IP without it */
-        if (options & LYPLG_TYPE_STORE_DYNAMIC) {
-            *zone_ptr = '\0';
-            addr_no_zone = value;
-        } else {
-            addr_dyn = strndup(value, zone_ptr - value);
-            addr_no_zone = addr_dyn;
-        }
+        LY_CHECK_RET(lydict_insert(ctx, zone_ptr + 1, value_len - (zone_ptr - value) - 1, zone));
+        addr_len = zone_ptr - value;
     } else {
         /* no zone */
         *zone = NULL;
-
-        /* get the IP terminated with zero */
-        if (options & LYPLG_TYPE_STORE_DYNAMIC) {
-            /* we can use the value directly */
-            addr_no_zone = value;
-        } else {
-            addr_dyn = strndup(value, value_len);
-            addr_no_zone = addr_dyn;
-        }
+        addr_len = value_len;
     }
 
     /* store the IPv4 address in network-byte order */
-    if (!inet_pton(AF_INET, addr_no_zone, addr)) {
-        ret = ly_err_new(err, LY_EVALID, LYVE_DATA, NULL, NULL, "Failed to convert IPv4 address \"%s\".", addr_no_zone);
-        goto cleanup;
-    }
-
-    /* restore the value */
-    if ((options & LYPLG_TYPE_STORE_DYNAMIC) && zone_ptr) {
-        *zone_ptr = '%';
+    if (lyplg_type_ipv4_str2bin(value, addr_len, (uint8_t *)addr)) {
+        return ly_err_new(err, LY_EVALID, LYVE_DATA, NULL, NULL, "Failed to convert IPv4 address \"%.*s\".",
+                (int)addr_len, value);
     }
 
-cleanup:
-    free(addr_dyn);
-    return ret;
+    return LY_SUCCESS;
 }
 
 /**
@@ -183,17 +152,19 @@ lyplg_type_store_ipv4_address(const struct ly_ctx *ctx, const struct lysc_type *
     LY_CHECK_GOTO(ret, cleanup);
 
     /* get the network-byte order address */
-    ret = ipv4address_str2ip(value, value_len, options, ctx, &val->addr, &val->zone, err);
+    ret = ipv4address_str2ip(value, value_len, ctx, &val->addr, &val->zone, err);
     LY_CHECK_GOTO(ret, cleanup);
 
-    /* store canonical value */
-    if (options & LYPLG_TYPE_STORE_DYNAMIC) {
-        ret = lydict_insert_zc(ctx, (char *)value, &storage->_canonical);
-        options &= ~LYPLG_TYPE_STORE_DYNAMIC;
-        LY_CHECK_GOTO(ret, cleanup);
-    } else {
-        ret = lydict_insert(ctx, value_len ? value : "", value_len, &storage->_canonical);
-        LY_CHECK_GOTO(ret, cleanup);
+    if (format == LY_VALUE_CANON) {
+        /* store canonical value */
+        if (options & LYPLG_TYPE_STORE_DYNAMIC) {
+            ret = lydict_insert_zc(ctx, (char *)value, &storage->_canonical);
+            options &= ~LYPLG_TYPE_STORE_DYNAMIC;
+            LY_CHECK_GOTO(ret, cleanup);
+        } else {
+            ret = lydict_insert(ctx, value_len ? value : "", value_len, &storage->_canonical);
+            LY_CHECK_GOTO(ret, cleanup);
+        }
     }
 
 cleanup:
@@ -264,6 +235,7 @@ lyplg_type_print_ipv4_address(const struct ly_ctx *ctx, const struct lyd_value *
 {
     struct lyd_value_ipv4_address *val;
     size_t zone_len;
+    uint32_t addr_len;
     char *ret;
 
     LYD_VALUE_GET(value, val);
@@ -301,20 +273,16 @@ lyplg_type_print_ipv4_address(const struct ly_ctx *ctx, const struct lyd_value *
         LY_CHECK_RET(!ret, NULL);
 
         /* get the address in string */
-        if (!inet_ntop(AF_INET, &val->addr, ret, INET_ADDRSTRLEN)) {
-            free(ret);
-            LOGERR(ctx, LY_ESYS, "Failed to get IPv4 address in string (%s).", strerror(errno));
-            return NULL;
-        }
+        addr_len = lyplg_type_ipv4_bin2str((uint8_t *)&val->addr, ret);
 
         /* add zone */
         if (zone_len) {
-            sprintf(ret + strlen(ret), "%%%s", val->zone);
+            ret[addr_len] = '%';
+            memcpy(ret + addr_len + 1, val->zone, zone_len);
         }
 
         /* store it */
-        if (lydict_insert_zc(ctx, ret, (const char **)&value->_canonical)) {
-            LOGMEM(ctx);
+        if (!lyplg_type_canonical_cache(ctx, value, ret)) {
             return NULL;
         }
     }
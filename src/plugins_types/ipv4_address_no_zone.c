@@ -12,8 +12,6 @@
  *     https://opensource.org/licenses/BSD-3-Clause
  */
 
-#define _GNU_SOURCE /* strndup */
-
 #include "plugins_internal.h"
 #include "plugins_types.h"
 
@@ -28,7 +26,6 @@
 #  endif
 #endif
 #include <assert.h>
-#include <errno.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
@@ -96,24 +93,24 @@ lyplg_type_store_ipv4_address_no_zone(const struct ly_ctx *ctx, const struct lys
     ret = lyplg_type_validate_patterns(type_str->patterns, value, value_len, err);
     LY_CHECK_GOTO(ret, cleanup);
 
-    /* we always need a dynamic value */
-    if (!(options & LYPLG_TYPE_STORE_DYNAMIC)) {
-        value = strndup(value, value_len);
-        LY_CHECK_ERR_GOTO(!value, ret = LY_EMEM, cleanup);
-
-        options |= LYPLG_TYPE_STORE_DYNAMIC;
-    }
-
     /* get the network-byte order address */
-    if (!inet_pton(AF_INET, value, &val->addr)) {
-        ret = ly_err_new(err, LY_EVALID, LYVE_DATA, NULL, NULL, "Failed to convert IPv4 address \"%s\".", (char *)value);
+    if (lyplg_type_ipv4_str2bin(value, value_len, (uint8_t *)&val->addr)) {
+        ret = ly_err_new(err, LY_EVALID, LYVE_DATA, NULL, NULL, "Failed to convert IPv4 address \"%.*s\".",
+                (int)value_len, (char *)value);
         goto cleanup;
     }
 
-    /* store canonical value */
-    ret = lydict_insert_zc(ctx, (char *)value, &storage->_canonical);
-    options &= ~LYPLG_TYPE_STORE_DYNAMIC;
-    LY_CHECK_GOTO(ret, cleanup);
+    if (format == LY_VALUE_CANON) {
+        /* store canonical value */
+        if (options & LYPLG_TYPE_STORE_DYNAMIC) {
+            ret = lydict_insert_zc(ctx, (char *)value, &storage->_canonical);
+            options &= ~LYPLG_TYPE_STORE_DYNAMIC;
+            LY_CHECK_GOTO(ret, cleanup);
+        } else {
+            ret = lydict_insert(ctx, value_len ? value : "", value_len, &storage->_canonical);
+            LY_CHECK_GOTO(ret, cleanup);
+        }
+    }
 
 cleanup:
     if (options & LYPLG_TYPE_STORE_DYNAMIC) {
@@ -179,21 +176,16 @@ lyplg_type_print_ipv4_address_no_zone(const struct ly_ctx *ctx, const struct lyd
         return &val->addr;
     }
 
-    /* generate canonical value if not already (loaded from LYB) */
+    /* generate canonical value if not already */
     if (!value->_canonical) {
         ret = malloc(INET_ADDRSTRLEN);
         LY_CHECK_RET(!ret, NULL);
 
         /* get the address in string */
-        if (!inet_ntop(AF_INET, &val->addr, ret, INET_ADDRSTRLEN)) {
-            free(ret);
-            LOGERR(ctx, LY_ESYS, "Failed to get IPv4 address in string (%s).", strerror(errno));
-            return NULL;
-        }
+        lyplg_type_ipv4_bin2str((uint8_t *)&val->addr, ret);
 
         /* store it */
-        if (lydict_insert_zc(ctx, ret, (const char **)&value->_canonical)) {
-            LOGMEM(ctx);
+        if (!lyplg_type_canonical_cache(ctx, value, ret)) {
             return NULL;
         }
     }
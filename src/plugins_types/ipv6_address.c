@@ -12,8 +12,6 @@
  *     https://opensource.org/licenses/BSD-3-Clause
  */
 
-#define _GNU_SOURCE /* strndup */
-
 #include "plugins_internal.h"
 #include "plugins_types.h"
 
@@ -29,7 +27,6 @@
 #endif
 #include <assert.h>
 #include <ctype.h>
-#include <errno.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
@@ -56,7 +53,6 @@ static void lyplg_type_free_ipv6_address(const struct ly_ctx *ctx, struct lyd_va
  *
  * @param[in] value Value to convert.
  * @param[in] value_len Length of @p value.
- * @param[in] options Type store callback options.
  * @param[in] ctx libyang context with dictionary.
  * @param[in,out] addr Allocated value for the address.
  * @param[out] zone Ipv6 address zone in dictionary.
@@ -64,57 +60,30 @@ static void lyplg_type_free_ipv6_address(const struct ly_ctx *ctx, struct lyd_va
  * @return LY_ERR value.
  */
 static LY_ERR
-ipv6address_str2ip(const char *value, size_t value_len, uint32_t options, const struct ly_ctx *ctx,
-        struct in6_addr *addr, const char **zone, struct ly_err_item **err)
+ipv6address_str2ip(const char *value, size_t value_len, const struct ly_ctx *ctx, struct in6_addr *addr,
+        const char **zone, struct ly_err_item **err)
 {
-    LY_ERR ret = LY_SUCCESS;
-    const char *addr_no_zone;
-    char *zone_ptr = NULL, *addr_dyn = NULL;
-    size_t zone_len;
+    const char *zone_ptr;
+    size_t addr_len;
 
-    /* store zone and get the string IPv6 address without it */
+    /* store zone and get the length of the IPv6 address without it */
     if ((zone_ptr = ly_strnchr(value, '%', value_len))) {
         /* there is a zone index */
-        zone_len = value_len - (zone_ptr - value) - 1;
-        ret = lydict_insert(ctx, zone_ptr + 1, zone_len, zone);
-        LY_CHECK_GOTO(ret, cleanup);
-
-        /* get the IP without it */
-        if (options & LYPLG_TYPE_STORE_DYNAMIC) {
-            *zone_ptr = '\0';
-            addr_no_zone = value;
-        } else {
-            addr_dyn = strndup(value, zone_ptr - value);
-            addr_no_zone = addr_dyn;
-        }
+        LY_CHECK_RET(lydict_insert(ctx, zone_ptr + 1, value_len - (zone_ptr - value) - 1, zone));
+        addr_len = zone_ptr - value;
     } else {
         /* no zone */
         *zone = NULL;
-
-        /* get the IP terminated with zero */
-        if (options & LYPLG_TYPE_STORE_DYNAMIC) {
-            /* we can use the value directly */
-            addr_no_zone = value;
-        } else {
-            addr_dyn = strndup(value, value_len);
-            addr_no_zone = addr_dyn;
-        }
+        addr_len = value_len;
     }
 
     /* store the IPv6 address in network-byte order */
-    if (!inet_pton(AF_INET6, addr_no_zone, addr)) {
-        ret = ly_err_new(err, LY_EVALID, LYVE_DATA, NULL, NULL, "Failed to convert IPv6 address \"%s\".", addr_no_zone);
-        goto cleanup;
-    }
-
-    /* restore the value */
-    if ((options & LYPLG_TYPE_STORE_DYNAMIC) && zone_ptr) {
-        *zone_ptr = '%';
+    if (lyplg_type_ipv6_str2bin(value, addr_len, (uint8_t *)addr)) {
+        return ly_err_new(err, LY_EVALID, LYVE_DATA, NULL, NULL, "Failed to convert IPv6 address \"%.*s\".",
+                (int)addr_len, value);
     }
 
-cleanup:
-    free(addr_dyn);
-    return ret;
+    return LY_SUCCESS;
 }
 
 /**
@@ -184,7 +153,7 @@ lyplg_type_store_ipv6_address(const struct ly_ctx *ctx, const struct lysc_type *
     LY_CHECK_GOTO(ret, cleanup);
 
     /* get the network-byte order address */
-    ret = ipv6address_str2ip(value, value_len, options, ctx, &val->addr, &val->zone, err);
+    ret = ipv6address_str2ip(value, value_len, ctx, &val->addr, &val->zone, err);
     LY_CHECK_GOTO(ret, cleanup);
 
     if (format == LY_VALUE_CANON) {
@@ -267,6 +236,7 @@ lyplg_type_print_ipv6_address(const struct ly_ctx *ctx, const struct lyd_value *
 {
     struct lyd_value_ipv6_address *val;
     size_t zone_len;
+    uint32_t addr_len;
     char *ret;
 
     LYD_VALUE_GET(value, val);
@@ -304,20 +274,16 @@ lyplg_type_print_ipv6_address(const struct ly_ctx *ctx, const struct lyd_value *
         LY_CHECK_RET(!ret, NULL);
 
         /* get the address in string */
-        if (!inet_ntop(AF_INET6, &val->addr, ret, INET6_ADDRSTRLEN)) {
-            free(ret);
-            LOGERR(ctx, LY_ESYS, "Failed to get IPv6 address in string (%s).", strerror(errno));
-            return NULL;
-        }
+        addr_len = lyplg_type_ipv6_bin2str((uint8_t *)&val->addr, ret);
 
         /* add zone */
         if (zone_len) {
-            sprintf(ret + strlen(ret), "%%%s", val->zone);
+            ret[addr_len] = '%';
+            memcpy(ret + addr_len + 1, val->zone, zone_len);
         }
 
         /* store it */
-        if (lydict_insert_zc(ctx, ret, (const char **)&value->_canonical)) {
-            LOGMEM(ctx);
+        if (!lyplg_type_canonical_cache(ctx, value, ret)) {
             return NULL;
         }
     }
@@ -12,8 +12,6 @@
  *     https://opensource.org/licenses/BSD-3-Clause
  */
 
-#define _GNU_SOURCE /* strndup */
-
 #include "plugins_internal.h"
 #include "plugins_types.h"
 
@@ -28,7 +26,6 @@
 #  endif
 #endif
 #include <assert.h>
-#include <errno.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
@@ -54,36 +51,20 @@ static void lyplg_type_free_ipv6_address_no_zone(const struct ly_ctx *ctx, struc
  *
  * @param[in] value Value to convert.
  * @param[in] value_len Length of @p value.
- * @param[in] options Type store callback options.
  * @param[in,out] addr Allocated value for the address.
  * @param[out] err Error information on error.
  * @return LY_ERR value.
  */
 static LY_ERR
-ipv6addressnozone_str2ip(const char *value, size_t value_len, uint32_t options, struct in6_addr *addr, struct ly_err_item **err)
+ipv6addressnozone_str2ip(const char *value, size_t value_len, struct in6_addr *addr, struct ly_err_item **err)
 {
-    LY_ERR ret = LY_SUCCESS;
-    const char *addr_str;
-    char *addr_dyn = NULL;
-
-    /* get the IP terminated with zero */
-    if (options & LYPLG_TYPE_STORE_DYNAMIC) {
-        /* we can use the value directly */
-        addr_str = value;
-    } else {
-        addr_dyn = strndup(value, value_len);
-        addr_str = addr_dyn;
-    }
-
     /* store the IPv6 address in network-byte order */
-    if (!inet_pton(AF_INET6, addr_str, addr)) {
-        ret = ly_err_new(err, LY_EVALID, LYVE_DATA, NULL, NULL, "Failed to convert IPv6 address \"%s\".", addr_str);
-        goto cleanup;
+    if (lyplg_type_ipv6_str2bin(value, value_len, (uint8_t *)addr)) {
+        return ly_err_new(err, LY_EVALID, LYVE_DATA, NULL, NULL, "Failed to convert IPv6 address \"%.*s\".",
+                (int)value_len, value);
     }
 
-cleanup:
-    free(addr_dyn);
-    return ret;
+    return LY_SUCCESS;
 }
 
 /**
@@ -148,7 +129,7 @@ lyplg_type_store_ipv6_address_no_zone(const struct ly_ctx *ctx, const struct lys
     LY_CHECK_GOTO(ret, cleanup);
 
     /* get the network-byte order address */
-    ret = ipv6addressnozone_str2ip(value, value_len, options, &val->addr, err);
+    ret = ipv6addressnozone_str2ip(value, value_len, &val->addr, err);
     LY_CHECK_GOTO(ret, cleanup);
 
     if (format == LY_VALUE_CANON) {
@@ -234,15 +215,10 @@ lyplg_type_print_ipv6_address_no_zone(const struct ly_ctx *ctx, const struct lyd
         LY_CHECK_RET(!ret, NULL);
 
         /* get the address in string */
-        if (!inet_ntop(AF_INET6, &val->addr, ret, INET6_ADDRSTRLEN)) {
-            free(ret);
-            LOGERR(ctx, LY_ESYS, "Failed to get IPv6 address in string (%s).", strerror(errno));
-            return NULL;
-        }
+        lyplg_type_ipv6_bin2str((uint8_t *)&val->addr, ret);
 
         /* store it */
-        if (lydict_insert_zc(ctx, ret, (const char **)&value->_canonical)) {
-            LOGMEM(ctx);
+        if (!lyplg_type_canonical_cache(ctx, value, ret)) {
             return NULL;
         }
     }
@@ -12,8 +12,6 @@
  *     https://opensource.org/licenses/BSD-3-Clause
  */
 
-#define _GNU_SOURCE /* strndup */
-
 #include "plugins_internal.h"
 #include "plugins_types.h"
 
@@ -64,27 +62,19 @@ static void lyplg_type_free_ipv6_prefix(const struct ly_ctx *ctx, struct lyd_val
 static LY_ERR
 ipv6prefix_str2ip(const char *value, size_t value_len, struct in6_addr *addr, uint8_t *prefix, struct ly_err_item **err)
 {
-    LY_ERR ret = LY_SUCCESS;
     const char *pref_str;
-    char *mask_str = NULL;
 
     /* it passed the pattern validation */
     pref_str = ly_strnchr(value, '/', value_len);
     ly_strntou8(pref_str + 1, value_len - (pref_str + 1 - value), prefix);
 
-    /* get just the network prefix */
-    mask_str = strndup(value, pref_str - value);
-    LY_CHECK_ERR_GOTO(!mask_str, ret = LY_EMEM, cleanup);
-
-    /* convert it to netword-byte order */
-    if (inet_pton(AF_INET6, mask_str, addr) != 1) {
-        ret = ly_err_new(err, LY_EVALID, LYVE_DATA, NULL, NULL, "Failed to convert IPv6 address \"%s\".", mask_str);
-        goto cleanup;
+    /* convert just the network prefix to network-byte order */
+    if (lyplg_type_ipv6_str2bin(value, pref_str - value, (uint8_t *)addr)) {
+        return ly_err_new(err, LY_EVALID, LYVE_DATA, NULL, NULL, "Failed to convert IPv6 address \"%.*s\".",
+                (int)(pref_str - value), value);
     }
 
-cleanup:
-    free(mask_str);
-    return ret;
+    return LY_SUCCESS;
 }
 
 /**
@@ -252,6 +242,7 @@ lyplg_type_print_ipv6_prefix(const struct ly_ctx *ctx, const struct lyd_value *v
         void *UNUSED(prefix_data), ly_bool *dynamic, size_t *value_len)
 {
     struct lyd_value_ipv6_prefix *val;
+    uint32_t len;
     char *ret;
 
     LYD_VALUE_GET(value, val);
@@ -271,17 +262,13 @@ lyplg_type_print_ipv6_prefix(const struct ly_ctx *ctx, const struct lyd_value *v
         LY_CHECK_RET(!ret, NULL);
 
         /* convert back to string */
-        if (!inet_ntop(AF_INET6, &val->addr, ret, INET6_ADDRSTRLEN)) {
-            free(ret);
-            return NULL;
-        }
+        len = lyplg_type_ipv6_bin2str((uint8_t *)&val->addr, ret);
 
         /* add the prefix */
-        sprintf(ret + strlen(ret), "/%" PRIu8, val->prefix);
+        sprintf(ret + len, "/%" PRIu8, val->prefix);
 
         /* store it */
-        if (lydict_insert_zc(ctx, ret, (const char **)&value->_canonical)) {
-            LOGMEM(ctx);
+        if (!lyplg_type_canonical_cache(ctx, value, ret)) {
             return NULL;
         }
     }
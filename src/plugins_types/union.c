@@ -526,6 +526,7 @@ lyplg_type_print_union(const struct ly_ctx *ctx, const struct lyd_value *value,
         void *prefix_data, ly_bool *dynamic, size_t *value_len)
 {
     const void *ret;
+    const char *canon;
     struct lyd_value_union *subvalue = value->subvalue;
     struct lysc_type_union *type_u = (struct lysc_type_union *)value->realtype;
     size_t lyb_data_len = 0;
@@ -549,9 +550,11 @@ lyplg_type_print_union(const struct ly_ctx *ctx, const struct lyd_value *value,
 
     assert(format != LY_VALUE_LYB);
     ret = (void *)subvalue->value.realtype->plugin->print(ctx, &subvalue->value, format, prefix_data, dynamic, value_len);
-    if (!value->_canonical && (format == LY_VALUE_CANON)) {
-        /* the canonical value is supposed to be stored now */
-        lydict_insert(ctx, subvalue->value._canonical, 0, (const char **)&value->_canonical);
+    if (!value->_canonical && (format == LY_VALUE_CANON) && subvalue->value._canonical &&
+            !lydict_insert(ctx, subvalue->value._canonical, 0, &canon) &&
+            !LY_ATOMIC_CAS_BARRIER(((struct lyd_value *)value)->_canonical, NULL, canon)) {
+        /* the canonical value is supposed to be stored now, but another thread was faster */
+        lydict_remove(ctx, canon);
     }
 
     return ret;
@@ -16,6 +16,7 @@
 
 #include <stdio.h>
 
+#include "compat.h"
 #include "log.h"
 #include "ly_common.h"
 #include "out.h"
@@ -102,6 +103,38 @@ lyd_print_mem(char **strp, const struct lyd_node *root, LYD_FORMAT format, uint3
     return ret;
 }
 
+/**
+ * @brief Callback only counting the printed bytes.
+ *
+ * @param[in] user_data Pointer to the counter (size_t).
+ * @param[in] buf Unused printed data.
+ * @param[in] count Number of the printed bytes.
+ * @return @p count.
+ */
+static ssize_t
+lyd_print_size_clb(void *user_data, const void *UNUSED(buf), size_t count)
+{
+    *(size_t *)user_data += count;
+    return count;
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_print_size(const struct lyd_node *root, LYD_FORMAT format, uint32_t options, size_t *size)
+{
+    LY_ERR ret;
+    struct ly_out *out;
+
+    LY_CHECK_ARG_RET(NULL, size, LY_EINVAL);
+
+    /* init */
+    *size = 0;
+
+    LY_CHECK_RET(ly_out_new_clb(lyd_print_size_clb, size, &out));
+    ret = lyd_print_(out, root, format, options);
+    ly_out_free(out, NULL, 0);
+    return ret;
+}
+
 LIBYANG_API_DEF LY_ERR
 lyd_print_fd(int fd, const struct lyd_node *root, LYD_FORMAT format, uint32_t options)
 {
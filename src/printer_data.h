@@ -55,11 +55,17 @@ struct ly_out;
  * accept ::LYD_PRINT_WITHSIBLINGS [printer option](@ref dataprinterflags)) since this flag differentiate the functions
  * themselves.
  *
+ * A data tree is printed sequentially by the calling thread. Printing does not modify the data tree (canonical values
+ * generated on first use are cached atomically), so several threads can print the same data tree at once, for example
+ * its separate subtrees using ::lyd_print_tree(), as long as each uses its own [output handler](@ref howtoOutput) and
+ * no thread modifies the tree meanwhile.
+ *
  * Functions List
  * --------------
  * - ::lyd_print_all()
  * - ::lyd_print_tree()
  * - ::lyd_print_mem()
+ * - ::lyd_print_size()
  * - ::lyd_print_fd()
  * - ::lyd_print_file()
  * - ::lyd_print_path()
@@ -133,6 +139,21 @@ LIBYANG_API_DECL LY_ERR lyd_print_tree(struct ly_out *out, const struct lyd_node
  */
 LIBYANG_API_DECL LY_ERR lyd_print_mem(char **strp, const struct lyd_node *root, LYD_FORMAT format, uint32_t options);
 
+/**
+ * @brief Learn the exact size of data tree printed in the specified format.
+ *
+ * The data are printed without being stored anywhere, so it takes about as long as printing them. Useful to allocate
+ * a buffer of the size increased by 1 for the terminating zero and provide it to ::ly_out_new_memory() so that
+ * it is never reallocated while printing.
+ *
+ * @param[in] root The root element of the (sub)tree to print.
+ * @param[in] format Output format.
+ * @param[in] options [Data printer flags](@ref dataprinterflags).
+ * @param[out] size Number of bytes of the printed data.
+ * @return LY_ERR value.
+ */
+LIBYANG_API_DECL LY_ERR lyd_print_size(const struct lyd_node *root, LYD_FORMAT format, uint32_t options, size_t *size);
+
 /**
  * @brief Print data tree in the specified format.
  *
@@ -82,6 +82,7 @@ LY_ERR yang_print_parsed_module(struct ly_out *out, const struct lysp_module *mo
 #define DO_FORMAT (!(pctx->options & LY_PRINT_SHRINK))
 #define LEVEL pctx->level                     /**< current level */
 #define INDENT (DO_FORMAT ? (LEVEL)*2 : 0),"" /**< indentation parameters for printer functions */
+#define INDENT_SIZE (DO_FORMAT ? (LEVEL)*2 : 0) /**< indentation size for ::ly_write_strs_() */
 #define LEVEL_INC LEVEL++                     /**< increase indentation level */
 #define LEVEL_DEC LEVEL--                     /**< decrease indentation level */
 
@@ -14,9 +14,9 @@
  */
 
 #include <assert.h>
-#include <ctype.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "context.h"
 #include "log.h"
@@ -57,7 +57,7 @@ struct jsonpr_ctx {
 
 #define PRINT_COMMA \
     if (pctx->level_printed >= pctx->level) { \
-        ly_print_(pctx->out, ",%s", (DO_FORMAT ? "\n" : "")); \
+        ly_write_(pctx->out, ",\n", DO_FORMAT ? 2 : 1); \
     }
 
 static LY_ERR json_print_node(struct jsonpr_ctx *pctx, const struct lyd_node *node);
@@ -210,49 +210,90 @@ json_nscmp(const struct lyd_node *node1, const struct lyd_node *node2)
     }
 }
 
+/**
+ * @brief Get a word with all the bytes set to @p B.
+ */
+#define JSON_WORD_BYTES(B) ((uint64_t)0x0101010101010101ULL * (uint8_t)(B))
+
+/**
+ * @brief Check whether any byte of a word is less than @p B (at most 0x80).
+ */
+#define JSON_WORD_HAS_LESS(W, B) (((W) - JSON_WORD_BYTES(B)) & ~(W) & JSON_WORD_BYTES(0x80))
+
+/**
+ * @brief Check whether any byte of a word is equal to @p B.
+ */
+#define JSON_WORD_HAS_BYTE(W, B) JSON_WORD_HAS_LESS((W) ^ JSON_WORD_BYTES(B), 1)
+
+/**
+ * @brief Check whether any byte of a word must be escaped in a JSON string.
+ */
+#define JSON_WORD_HAS_ESCAPE(W) (JSON_WORD_HAS_LESS(W, 0x20) || JSON_WORD_HAS_BYTE(W, '"') || \
+        JSON_WORD_HAS_BYTE(W, '\\') || JSON_WORD_HAS_BYTE(W, 0x7F))
+
+/**
+ * @brief Escape sequences of the characters that must be escaped in a JSON string, NULL for the rest.
+ *
+ * Control characters (in the C locale) without a short escape are printed as "\uXXXX".
+ */
+static const char *json_escapes[256] = {
+    "\\u0000", "\\u0001", "\\u0002", "\\u0003", "\\u0004", "\\u0005", "\\u0006", "\\u0007",
+    "\\u0008", "\\t", "\\u000A", "\\u000B", "\\u000C", "\\r", "\\u000E", "\\u000F",
+    "\\u0010", "\\u0011", "\\u0012", "\\u0013", "\\u0014", "\\u0015", "\\u0016", "\\u0017",
+    "\\u0018", "\\u0019", "\\u001A", "\\u001B", "\\u001C", "\\u001D", "\\u001E", "\\u001F",
+    ['"'] = "\\\"", ['\\'] = "\\\\", [0x7F] = "\\u007F"
+};
+
 /**
  * @brief Print the @p text as JSON string - encode special characters and add quotation around the string.
  *
+ * The characters are not printed one by one, the runs of characters not needing to be escaped are found
+ * a word at a time and printed at once.
+ *
  * @param[in] out The output handler.
  * @param[in] text The string to print.
+ * @param[in] ref Flag that @p text stays unchanged until the output is flushed, so that it does not have to be copied.
  * @return LY_ERR value.
  */
 static LY_ERR
-json_print_string(struct ly_out *out, const char *text)
+json_print_string(struct ly_out *out, const char *text, ly_bool ref)
 {
-    uint64_t i;
+    size_t len, i, run;
+    uint64_t word;
+    const char *esc;
 
     if (!text) {
         return LY_SUCCESS;
     }
 
     ly_write_(out, "\"", 1);
-    for (i = 0; text[i]; i++) {
-        const unsigned char byte = text[i];
+    len = strlen(text);
+    run = 0;
+    i = 0;
+    while (i < len) {
+        if (i + sizeof word <= len) {
+            memcpy(&word, &text[i], sizeof word);
+            if (!JSON_WORD_HAS_ESCAPE(word)) {
+                /* no character in the word needs to be escaped */
+                i += sizeof word;
+                continue;
+            }
+        }
 
-        switch (byte) {
-        case '"':
-            ly_print_(out, "\\\"");
-            break;
-        case '\\':
-            ly_print_(out, "\\\\");
-            break;
-        case '\r':
-            ly_print_(out, "\\r");
-            break;
-        case '\t':
-            ly_print_(out, "\\t");
-            break;
-        default:
-            if (iscntrl(byte)) {
-                /* control character */
-                ly_print_(out, "\\u%.4X", byte);
-            } else {
-                /* printable character (even non-ASCII UTF8) */
-                ly_write_(out, &text[i], 1);
+        esc = json_escapes[(unsigned char)text[i]];
+        if (esc) {
+            /* print the run of characters before the escaped one */
+            if (i > run) {
+                ref ? ly_write_ref_(out, &text[run], i - run) : ly_write_(out, &text[run], i - run);
             }
-            break;
+            ly_write_(out, esc, strlen(esc));
+            run = i + 1;
         }
+        ++i;
+    }
+    if (len > run) {
+        /* printable characters (even non-ASCII UTF8) */
+        ref ? ly_write_ref_(out, &text[run], len - run) : ly_write_(out, &text[run], len - run);
     }
     ly_write_(out, "\"", 1);
 
@@ -273,10 +314,11 @@ json_print_member(struct jsonpr_ctx *pctx, const struct lyd_node *node, ly_bool
     PRINT_COMMA;
     if ((LEVEL == 1) || json_nscmp(node, pctx->parent)) {
         /* print "namespace" */
-        ly_print_(pctx->out, "%*s\"%s%s:%s\":%s", INDENT, is_attr ? "@" : "",
-                node_prefix(node), node->schema->name, DO_FORMAT ? " " : "");
+        ly_write_strs_(pctx->out, INDENT_SIZE, 7, "\"", is_attr ? "@" : NULL, node_prefix(node), ":",
+                node->schema->name, "\":", DO_FORMAT ? " " : NULL);
     } else {
-        ly_print_(pctx->out, "%*s\"%s%s\":%s", INDENT, is_attr ? "@" : "", node->schema->name, DO_FORMAT ? " " : "");
+        ly_write_strs_(pctx->out, INDENT_SIZE, 5, "\"", is_attr ? "@" : NULL, node->schema->name, "\":",
+                DO_FORMAT ? " " : NULL);
     }
 
     return LY_SUCCESS;
@@ -329,9 +371,10 @@ json_print_member2(struct jsonpr_ctx *pctx, const struct lyd_node *parent, LY_VA
 
     /* print the member */
     if (module_name && (!parent || (node_prefix(parent) != module_name))) {
-        ly_print_(pctx->out, "%*s\"%s%s:%s\":%s", INDENT, is_attr ? "@" : "", module_name, name_str, DO_FORMAT ? " " : "");
+        ly_write_strs_(pctx->out, INDENT_SIZE, 7, "\"", is_attr ? "@" : NULL, module_name, ":", name_str, "\":",
+                DO_FORMAT ? " " : NULL);
     } else {
-        ly_print_(pctx->out, "%*s\"%s%s\":%s", INDENT, is_attr ? "@" : "", name_str, DO_FORMAT ? " " : "");
+        ly_write_strs_(pctx->out, INDENT_SIZE, 5, "\"", is_attr ? "@" : NULL, name_str, "\":", DO_FORMAT ? " " : NULL);
     }
 
     return LY_SUCCESS;
@@ -376,7 +419,7 @@ print_val:
     case LY_TYPE_UINT64:
     case LY_TYPE_DEC64:
     case LY_TYPE_IDENT:
-        json_print_string(pctx->out, value);
+        json_print_string(pctx->out, value, !dynamic);
         break;
 
     case LY_TYPE_INT8:
@@ -386,7 +429,7 @@ print_val:
     case LY_TYPE_UINT16:
     case LY_TYPE_UINT32:
     case LY_TYPE_BOOL:
-        ly_print_(pctx->out, "%s", value[0] ? value : "null");
+        ly_write_strs_(pctx->out, 0, 1, value[0] ? value : "null");
         break;
 
     case LY_TYPE_EMPTY:
@@ -421,14 +464,14 @@ json_print_attribute(struct jsonpr_ctx *pctx, const struct lyd_node_opaq *node)
         json_print_member2(pctx, &node->node, attr->format, &attr->name, 0);
 
         if (attr->hints & (LYD_VALHINT_STRING | LYD_VALHINT_OCTNUM | LYD_VALHINT_HEXNUM | LYD_VALHINT_NUM64)) {
-            json_print_string(pctx->out, attr->value);
+            json_print_string(pctx->out, attr->value, 1);
         } else if (attr->hints & (LYD_VALHINT_BOOLEAN | LYD_VALHINT_DECNUM)) {
             ly_print_(pctx->out, "%s", attr->value[0] ? attr->value : "null");
         } else if (attr->hints & LYD_VALHINT_EMPTY) {
             ly_print_(pctx->out, "[null]");
         } else {
             /* unknown value format with no hints, use universal string */
-            json_print_string(pctx->out, attr->value);
+            json_print_string(pctx->out, attr->value, 1);
         }
         LEVEL_PRINTED;
     }
@@ -459,7 +502,8 @@ json_print_metadata(struct jsonpr_ctx *pctx, const struct lyd_node *node, const
             continue;
         }
         PRINT_COMMA;
-        ly_print_(pctx->out, "%*s\"%s:%s\":%s", INDENT, meta->annotation->module->name, meta->name, DO_FORMAT ? " " : "");
+        ly_write_strs_(pctx->out, INDENT_SIZE, 5, "\"", meta->annotation->module->name, ":", meta->name,
+                DO_FORMAT ? "\": " : "\":");
         LY_CHECK_RET(json_print_value(pctx, LYD_CTX(node), &meta->value, NULL));
         LEVEL_PRINTED;
     }
@@ -651,7 +695,7 @@ json_print_any_content(struct jsonpr_ctx *pctx, struct lyd_node_any *any)
             }
         } else {
             /* print as a string */
-            json_print_string(pctx->out, any->value.str);
+            json_print_string(pctx->out, any->value.str, 1);
         }
         break;
     case LYD_ANYDATA_LYB:
@@ -693,11 +737,13 @@ json_print_inner(struct jsonpr_ctx *pctx, const struct lyd_node *node)
 
     if ((node->schema && (node->schema->nodetype == LYS_LIST)) ||
             (opaq && (opaq->hints != LYD_HINT_DATA) && (opaq->hints & LYD_NODEHINT_LIST))) {
-        ly_print_(pctx->out, "%s%*s{%s", (is_open_array(pctx, node) && (pctx->level_printed >= pctx->level)) ?
-                (DO_FORMAT ? ",\n" : ",") : "", INDENT, (DO_FORMAT && has_content) ? "\n" : "");
+        if (is_open_array(pctx, node) && (pctx->level_printed >= pctx->level)) {
+            ly_write_(pctx->out, ",\n", DO_FORMAT ? 2 : 1);
+        }
+        ly_write_strs_(pctx->out, INDENT_SIZE, 1, (DO_FORMAT && has_content) ? "{\n" : "{");
     } else {
-        ly_print_(pctx->out, "%s{%s", (is_open_array(pctx, node) && (pctx->level_printed >= pctx->level)) ? "," : "",
-                (DO_FORMAT && has_content) ? "\n" : "");
+        ly_write_strs_(pctx->out, 0, 2, (is_open_array(pctx, node) && (pctx->level_printed >= pctx->level)) ? "," : NULL,
+                (DO_FORMAT && has_content) ? "{\n" : "{");
     }
     LEVEL_INC;
 
@@ -713,9 +759,10 @@ json_print_inner(struct jsonpr_ctx *pctx, const struct lyd_node *node)
 
     LEVEL_DEC;
     if (DO_FORMAT && has_content) {
-        ly_print_(pctx->out, "\n%*s}", INDENT);
+        ly_write_(pctx->out, "\n", 1);
+        ly_write_strs_(pctx->out, INDENT_SIZE, 1, "}");
     } else {
-        ly_print_(pctx->out, "}");
+        ly_write_(pctx->out, "}", 1);
     }
     LEVEL_PRINTED;
 
@@ -952,7 +999,7 @@ json_print_opaq(struct jsonpr_ctx *pctx, const struct lyd_node_opaq *node)
             ly_print_(pctx->out, "%s", node->value);
         } else {
             /* string or a large number */
-            json_print_string(pctx->out, node->value);
+            json_print_string(pctx->out, node->value, 1);
         }
         LEVEL_PRINTED;
 
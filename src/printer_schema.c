@@ -34,6 +34,11 @@ lys_print_module(struct ly_out *out, const struct lys_module *module, LYS_OUTFOR
     /* reset number of printed bytes */
     out->func_printed = 0;
 
+    if (module->ctx->parsed_freed && (format != LYS_OUT_YANG_COMPILED)) {
+        LOGERR(module->ctx, LY_EINVAL, "Module \"%s\" parsed module was freed.", module->name);
+        return LY_EINVAL;
+    }
+
     switch (format) {
     case LYS_OUT_YANG:
         if (!module->parsed) {
@@ -90,6 +95,11 @@ lys_print_submodule(struct ly_out *out, const struct lysp_submodule *submodule,
     /* reset number of printed bytes */
     out->func_printed = 0;
 
+    if (submodule->mod->ctx->parsed_freed) {
+        LOGERR(submodule->mod->ctx, LY_EINVAL, "Submodule \"%s\" parsed submodule was freed.", submodule->name);
+        return LY_EINVAL;
+    }
+
     switch (format) {
     case LYS_OUT_YANG:
         ret = yang_print_parsed_submodule(out, submodule, options);
@@ -68,7 +68,7 @@ xml_print_ns(struct xmlpr_ctx *pctx, const char *ns, const char *new_prefix, uin
         if (!new_prefix) {
             /* find default namespace */
             if (!pctx->prefix.objs[i - 1]) {
-                if (!strcmp(pctx->ns.objs[i - 1], ns)) {
+                if ((pctx->ns.objs[i - 1] == ns) || !strcmp(pctx->ns.objs[i - 1], ns)) {
                     /* matching default namespace */
                     return pctx->prefix.objs[i - 1];
                 }
@@ -77,7 +77,7 @@ xml_print_ns(struct xmlpr_ctx *pctx, const char *ns, const char *new_prefix, uin
             }
         } else {
             /* find prefixed namespace */
-            if (!strcmp(pctx->ns.objs[i - 1], ns)) {
+            if ((pctx->ns.objs[i - 1] == ns) || !strcmp(pctx->ns.objs[i - 1], ns)) {
                 if (!pctx->prefix.objs[i - 1]) {
                     /* default namespace is not interesting */
                     continue;
@@ -92,7 +92,7 @@ xml_print_ns(struct xmlpr_ctx *pctx, const char *ns, const char *new_prefix, uin
     }
 
     /* suitable namespace not found, must be printed */
-    ly_print_(pctx->out, " xmlns%s%s=\"%s\"", new_prefix ? ":" : "", new_prefix ? new_prefix : "", ns);
+    ly_write_strs_(pctx->out, 0, 6, " xmlns", new_prefix ? ":" : NULL, new_prefix, "=\"", ns, "\"");
 
     /* and added into namespaces */
     if (new_prefix) {
@@ -238,7 +238,7 @@ xml_print_meta(struct xmlpr_ctx *pctx, const struct lyd_node *node)
 
         /* print metadata value */
         if (value && value[0]) {
-            lyxml_dump_text(pctx->out, value, 1);
+            lyxml_dump_text(pctx->out, value, 1, !dynamic);
         }
         ly_print_(pctx->out, "\"");
         if (dynamic) {
@@ -259,7 +259,7 @@ static void
 xml_print_node_open(struct xmlpr_ctx *pctx, const struct lyd_node *node)
 {
     /* print node name */
-    ly_print_(pctx->out, "%*s<%s", INDENT, node->schema->name);
+    ly_write_strs_(pctx->out, INDENT_SIZE, 2, "<", node->schema->name);
 
     /* print default namespace */
     xml_print_ns(pctx, node->schema->module->ns, NULL, 0);
@@ -288,7 +288,7 @@ xml_print_attr(struct xmlpr_ctx *pctx, const struct lyd_node_opaq *node)
 
         /* print the attribute with its prefix and value */
         ly_print_(pctx->out, " %s%s%s=\"", pref ? pref : "", pref ? ":" : "", attr->name.name);
-        lyxml_dump_text(pctx->out, attr->value, 1);
+        lyxml_dump_text(pctx->out, attr->value, 1, 1);
         ly_print_(pctx->out, "\""); /* print attribute value terminator */
 
     }
@@ -300,7 +300,7 @@ static LY_ERR
 xml_print_opaq_open(struct xmlpr_ctx *pctx, const struct lyd_node_opaq *node)
 {
     /* print node name */
-    ly_print_(pctx->out, "%*s<%s", INDENT, node->name.name);
+    ly_write_strs_(pctx->out, INDENT_SIZE, 2, "<", node->name.name);
 
     if (node->name.prefix || node->name.module_ns) {
         /* print default namespace */
@@ -349,15 +349,15 @@ xml_print_term(struct xmlpr_ctx *pctx, const struct lyd_node_term *node)
     /* print namespaces connected with the values's prefixes */
     for (i = 1; i < ns_list.count; ++i) {
         mod = ns_list.objs[i];
-        ly_print_(pctx->out, " xmlns:%s=\"%s\"", mod->prefix, mod->ns);
+        ly_write_strs_(pctx->out, 0, 5, " xmlns:", mod->prefix, "=\"", mod->ns, "\"");
     }
 
     if (!value[0]) {
-        ly_print_(pctx->out, "/>%s", DO_FORMAT ? "\n" : "");
+        ly_write_(pctx->out, "/>\n", DO_FORMAT ? 3 : 2);
     } else {
-        ly_print_(pctx->out, ">");
-        lyxml_dump_text(pctx->out, value, 0);
-        ly_print_(pctx->out, "</%s>%s", node->schema->name, DO_FORMAT ? "\n" : "");
+        ly_write_(pctx->out, ">", 1);
+        lyxml_dump_text(pctx->out, value, 0, !dynamic);
+        ly_write_strs_(pctx->out, 0, 3, "</", node->schema->name, DO_FORMAT ? ">\n" : ">");
     }
 
 cleanup:
@@ -390,12 +390,12 @@ xml_print_inner(struct xmlpr_ctx *pctx, const struct lyd_node_inner *node)
     }
     if (!child) {
         /* there are no children that will be printed */
-        ly_print_(pctx->out, "/>%s", DO_FORMAT ? "\n" : "");
+        ly_write_(pctx->out, "/>\n", DO_FORMAT ? 3 : 2);
         return LY_SUCCESS;
     }
 
     /* children */
-    ly_print_(pctx->out, ">%s", DO_FORMAT ? "\n" : "");
+    ly_write_(pctx->out, ">\n", DO_FORMAT ? 2 : 1);
 
     LEVEL_INC;
     LY_LIST_FOR(node->child, child) {
@@ -404,7 +404,7 @@ xml_print_inner(struct xmlpr_ctx *pctx, const struct lyd_node_inner *node)
     }
     LEVEL_DEC;
 
-    ly_print_(pctx->out, "%*s</%s>%s", INDENT, node->schema->name, DO_FORMAT ? "\n" : "");
+    ly_write_strs_(pctx->out, INDENT_SIZE, 3, "</", node->schema->name, DO_FORMAT ? ">\n" : ">");
 
     return LY_SUCCESS;
 }
@@ -426,7 +426,7 @@ xml_print_anydata(struct xmlpr_ctx *pctx, const struct lyd_node_any *node)
     if (!any->value.tree) {
         /* no content */
 no_content:
-        ly_print_(pctx->out, "/>%s", DO_FORMAT ? "\n" : "");
+        ly_write_(pctx->out, "/>\n", DO_FORMAT ? 3 : 2);
         return LY_SUCCESS;
     } else {
         if (any->value_type == LYD_ANYDATA_LYB) {
@@ -453,7 +453,7 @@ no_content:
             pctx->options &= ~LYD_PRINT_WITHSIBLINGS;
             LEVEL_INC;
 
-            ly_print_(pctx->out, ">%s", DO_FORMAT ? "\n" : "");
+            ly_write_(pctx->out, ">\n", DO_FORMAT ? 2 : 1);
             LY_LIST_FOR(any->value.tree, iter) {
                 ret = xml_print_node(pctx, iter);
                 LY_CHECK_ERR_RET(ret, LEVEL_DEC, ret);
@@ -468,8 +468,8 @@ no_content:
                 goto no_content;
             }
             /* close opening tag and print data */
-            ly_print_(pctx->out, ">");
-            lyxml_dump_text(pctx->out, any->value.str, 0);
+            ly_write_(pctx->out, ">", 1);
+            lyxml_dump_text(pctx->out, any->value.str, 0, 1);
             break;
         case LYD_ANYDATA_XML:
             /* print without escaping special characters */
@@ -487,9 +487,9 @@ no_content:
 
         /* closing tag */
         if (any->value_type == LYD_ANYDATA_DATATREE) {
-            ly_print_(pctx->out, "%*s</%s>%s", INDENT, node->schema->name, DO_FORMAT ? "\n" : "");
+            ly_write_strs_(pctx->out, INDENT_SIZE, 3, "</", node->schema->name, DO_FORMAT ? ">\n" : ">");
         } else {
-            ly_print_(pctx->out, "</%s>%s", node->schema->name, DO_FORMAT ? "\n" : "");
+            ly_write_strs_(pctx->out, 0, 3, "</", node->schema->name, DO_FORMAT ? ">\n" : ">");
         }
     }
 
@@ -510,14 +510,14 @@ xml_print_opaq(struct xmlpr_ctx *pctx, const struct lyd_node_opaq *node)
             xml_print_ns_prefix_data(pctx, node->format, node->val_prefix_data, LYXML_PREFIX_REQUIRED);
         }
 
-        ly_print_(pctx->out, ">");
-        lyxml_dump_text(pctx->out, node->value, 0);
+        ly_write_(pctx->out, ">", 1);
+        lyxml_dump_text(pctx->out, node->value, 0, 1);
     }
 
     if (node->child) {
         /* children */
         if (!node->value[0]) {
-            ly_print_(pctx->out, ">%s", DO_FORMAT ? "\n" : "");
+            ly_write_(pctx->out, ">\n", DO_FORMAT ? 2 : 1);
         }
 
         LEVEL_INC;
@@ -527,12 +527,12 @@ xml_print_opaq(struct xmlpr_ctx *pctx, const struct lyd_node_opaq *node)
         }
         LEVEL_DEC;
 
-        ly_print_(pctx->out, "%*s</%s>%s", INDENT, node->name.name, DO_FORMAT ? "\n" : "");
+        ly_write_strs_(pctx->out, INDENT_SIZE, 3, "</", node->name.name, DO_FORMAT ? ">\n" : ">");
     } else if (node->value[0]) {
-        ly_print_(pctx->out, "</%s>%s", node->name.name, DO_FORMAT ? "\n" : "");
+        ly_write_strs_(pctx->out, 0, 3, "</", node->name.name, DO_FORMAT ? ">\n" : ">");
     } else {
         /* no value or children */
-        ly_print_(pctx->out, "/>%s", DO_FORMAT ? "\n" : "");
+        ly_write_(pctx->out, "/>\n", DO_FORMAT ? 3 : 2);
     }
 
     return LY_SUCCESS;
@@ -55,7 +55,7 @@ ypr_open(struct lys_ypr_ctx *pctx, const char *elem_name, const char *attr_name,
 
     if (attr_name) {
         ly_print_(pctx->out, " %s=\"", attr_name);
-        lyxml_dump_text(pctx->out, attr_value, 1);
+        lyxml_dump_text(pctx->out, attr_value, 1, 0);
         ly_print_(pctx->out, "\"%s", flag == -1 ? "/>\n" : flag == 1 ? ">\n" : "");
     } else if (flag) {
         ly_print_(pctx->out, flag == -1 ? "/>\n" : ">\n");
@@ -90,7 +90,7 @@ static void
 ypr_yin_arg(struct lys_ypr_ctx *pctx, const char *arg, const char *text)
 {
     ly_print_(pctx->out, "%*s<%s>", INDENT, arg);
-    lyxml_dump_text(pctx->out, text, 0);
+    lyxml_dump_text(pctx->out, text, 0, 0);
     ly_print_(pctx->out, "</%s>\n", arg);
 }
 
@@ -147,7 +147,7 @@ yprp_extension_instance(struct lys_ypr_ctx *pctx, enum ly_stmt substmt, uint8_t
         id = ext->name;
         ly_parse_nodeid(&id, &prefix, &prefix_len, &name, &name_len);
         ly_print_(pctx->out, "%*s<%.*s:%s>", INDENT, (int)prefix_len, prefix, ext->def->argname);
-        lyxml_dump_text(pctx->out, ext->argument, 0);
+        lyxml_dump_text(pctx->out, ext->argument, 0, 0);
         ly_print_(pctx->out, "</%.*s:%s>\n", (int)prefix_len, prefix, ext->def->argname);
     }
     LY_LIST_FOR(ext->child, stmt) {
@@ -416,7 +416,7 @@ yprp_restr(struct lys_ypr_ctx *pctx, const struct lysp_restr *restr, enum ly_stm
     ly_print_(pctx->out, "%*s<%s %s=\"", INDENT, lyplg_ext_stmt2str(stmt), attr);
     lyxml_dump_text(pctx->out,
             (restr->arg.str[0] != LYSP_RESTR_PATTERN_NACK && restr->arg.str[0] != LYSP_RESTR_PATTERN_ACK) ?
-            restr->arg.str : &restr->arg.str[1], 1);
+            restr->arg.str : &restr->arg.str[1], 1, 0);
     ly_print_(pctx->out, "\"");
 
     LEVEL++;
@@ -452,7 +452,7 @@ yprp_when(struct lys_ypr_ctx *pctx, struct lysp_when *when, int8_t *flag)
 
     ypr_close_parent(pctx, flag);
     ly_print_(pctx->out, "%*s<when condition=\"", INDENT);
-    lyxml_dump_text(pctx->out, when->cond, 1);
+    lyxml_dump_text(pctx->out, when->cond, 1, 0);
     ly_print_(pctx->out, "\"");
 
     LEVEL++;
@@ -474,11 +474,11 @@ yprp_enum(struct lys_ypr_ctx *pctx, const struct lysp_type_enum *items, LY_DATA_
     LY_ARRAY_FOR(items, u) {
         if (type == LY_TYPE_BITS) {
             ly_print_(pctx->out, "%*s<bit name=\"", INDENT);
-            lyxml_dump_text(pctx->out, items[u].name, 1);
+            lyxml_dump_text(pctx->out, items[u].name, 1, 0);
             ly_print_(pctx->out, "\"");
         } else { /* LY_TYPE_ENUM */
             ly_print_(pctx->out, "%*s<enum name=\"", INDENT);
-            lyxml_dump_text(pctx->out, items[u].name, 1);
+            lyxml_dump_text(pctx->out, items[u].name, 1, 0);
             ly_print_(pctx->out, "\"");
         }
         inner_flag = 0;
@@ -23,6 +23,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #include "compat.h"
 #include "context.h"
@@ -47,6 +48,12 @@
 #include "tree_schema_internal.h"
 #include "xpath.h"
 
+/**
+ * @brief Minimal stack size of the threads compiling dependency sets in parallel.
+ */
+#define LYS_COMPILE_THREAD_STACK_SIZE (8 * 1024 * 1024)
+
+
 void
 lysc_update_path(struct lysc_ctx *ctx, const struct lys_module *parent_module, const char *name)
 {
@@ -123,6 +130,10 @@ lys_compile_extension(struct lysc_ctx *ctx, struct lysp_ext_instance *extp, stru
     LY_ERR ret = LY_SUCCESS;
     struct lysp_ext *ep = extp->def;
 
+    /* the definition may be shared with other dep sets being compiled */
+    /* LOCK */
+    pthread_mutex_lock(&ctx->ctx->compile_lock);
+
     if (!ep->compiled) {
         lysc_update_path(ctx, NULL, "{extension}");
         lysc_update_path(ctx, NULL, ep->name);
@@ -147,6 +158,9 @@ lys_compile_extension(struct lysc_ctx *ctx, struct lysp_ext_instance *extp, stru
     *ext = ep->compiled;
 
 cleanup:
+    /* UNLOCK */
+    pthread_mutex_unlock(&ctx->ctx->compile_lock);
+
     if (ret) {
         lysc_update_path(ctx, NULL, NULL);
         lysc_update_path(ctx, NULL, NULL);
@@ -248,6 +262,7 @@ lys_identity_precompile(struct lysc_ctx *ctx_sc, struct ly_ctx *ctx, struct lysp
         DUP_STRING_GOTO(ctx_sc->ctx, identities_p[u].dsc, ident->dsc, ret, done);
         DUP_STRING_GOTO(ctx_sc->ctx, identities_p[u].ref, ident->ref, ret, done);
         ident->module = ctx_sc->cur_mod;
+        ident->index = LY_ATOMIC_INC_BARRIER(ctx_sc->ctx->ident_count);
         /* backlinks (derived) can be added no sooner than when all the identities in the current module are present */
         COMPILE_EXTS_GOTO(ctx_sc, identities_p[u].exts, ident->exts, ident, ret, done);
         ident->flags = identities_p[u].flags;
@@ -317,6 +332,74 @@ cleanup:
     return ret;
 }
 
+/**
+ * @brief Add an identity index into the sorted ancestors of an identity.
+ *
+ * @param[in] ctx libyang context for logging.
+ * @param[in] ident Identity to update.
+ * @param[in] index Index of the ancestor identity.
+ * @param[in,out] changed Set if the index was added.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lys_compile_identity_ancestor_insert(const struct ly_ctx *ctx, struct lysc_ident *ident, uint32_t index, ly_bool *changed)
+{
+    LY_ARRAY_COUNT_TYPE lo = 0, hi = LY_ARRAY_COUNT(ident->ancestors), mid;
+
+    /* find the position */
+    while (lo < hi) {
+        mid = lo + (hi - lo) / 2;
+        if (ident->ancestors[mid] == index) {
+            return LY_SUCCESS;
+        } else if (ident->ancestors[mid] < index) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    /* insert it */
+    LY_ARRAY_CREATE_RET(ctx, ident->ancestors, 1, LY_EMEM);
+    memmove(&ident->ancestors[lo + 1], &ident->ancestors[lo],
+            (LY_ARRAY_COUNT(ident->ancestors) - lo) * sizeof *ident->ancestors);
+    ident->ancestors[lo] = index;
+    LY_ARRAY_INCREMENT(ident->ancestors);
+    *changed = 1;
+
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Add a base identity and all its ancestors into the ancestors of an identity and
+ * (recursively) all the identities derived from it.
+ *
+ * @param[in] ctx libyang context for logging.
+ * @param[in] ident Identity derived from @p base.
+ * @param[in] base Base identity.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lys_compile_identity_ancestors_add(const struct ly_ctx *ctx, struct lysc_ident *ident, const struct lysc_ident *base)
+{
+    LY_ARRAY_COUNT_TYPE u;
+    ly_bool changed = 0;
+
+    /* add the base and all its ancestors */
+    LY_CHECK_RET(lys_compile_identity_ancestor_insert(ctx, ident, base->index, &changed));
+    LY_ARRAY_FOR(base->ancestors, u) {
+        LY_CHECK_RET(lys_compile_identity_ancestor_insert(ctx, ident, base->ancestors[u], &changed));
+    }
+
+    if (changed) {
+        /* identities derived from this one must include the new ancestors as well */
+        LY_ARRAY_FOR(ident->derived, u) {
+            LY_CHECK_RET(lys_compile_identity_ancestors_add(ctx, ident->derived[u], base));
+        }
+    }
+
+    return LY_SUCCESS;
+}
+
 LY_ERR
 lys_compile_identity_bases(struct lysc_ctx *ctx, const struct lysp_module *base_pmod, const char **bases_p,
         struct lysc_ident *ident, struct lysc_ident ***bases)
@@ -368,6 +451,7 @@ lys_compile_identity_bases(struct lysc_ctx *ctx, const struct lysp_module *base_
                     /* we have match! store the backlink */
                     LY_ARRAY_NEW_RET(ctx->ctx, mod->identities[v].derived, idref, LY_EMEM);
                     *idref = ident;
+                    LY_CHECK_RET(lys_compile_identity_ancestors_add(ctx->ctx, ident, &mod->identities[v]));
                 } else {
                     /* we have match! store the found identity */
                     LY_ARRAY_NEW_RET(ctx->ctx, *bases, idref, LY_EMEM);
@@ -911,7 +995,7 @@ lys_compile_unres_leafref(struct lysc_ctx *ctx, const struct lysc_node *node, st
 
     /* store the type */
     lref->realtype = ((struct lysc_node_leaf *)target)->type;
-    ++lref->realtype->refcount;
+    LY_ATOMIC_INC_BARRIER(lref->realtype->refcount);
     return LY_SUCCESS;
 }
 
@@ -1106,6 +1190,51 @@ lys_type_leafref_next(const struct lysc_node *node, uint64_t *index)
     return ret;
 }
 
+/**
+ * @brief Make sure all the modules referenced by an expression have their disabled nodes present in the compiled trees.
+ *
+ * Disabled nodes are removed once a dep set is compiled so a module that is not recompiled with the referencing
+ * module needs to be flagged and the dep set recompiled.
+ *
+ * @param[in] ctx libyang context.
+ * @param[in] expr Expression to check.
+ * @param[in] prefixes Resolved prefixes of @p expr.
+ * @return LY_SUCCESS on success.
+ * @return LY_ERECOMPILE if the dep set needs to be recompiled.
+ */
+static LY_ERR
+lys_compile_expr_disabled(const struct ly_ctx *ctx, const struct lyxp_expr *expr, const struct lysc_prefix *prefixes)
+{
+    LY_ERR rc = LY_SUCCESS;
+    uint32_t i;
+    const char *ptr, *start;
+    struct lys_module *mod;
+
+    for (i = 0; i < expr->used; ++i) {
+        if (expr->tokens[i] != LYXP_TOKEN_NAMETEST) {
+            continue;
+        }
+
+        start = expr->expr + expr->tok_pos[i];
+        if (!(ptr = ly_strnchr(start, ':', expr->tok_len[i]))) {
+            continue;
+        }
+
+        mod = (struct lys_module *)ly_resolve_prefix(ctx, start, ptr - start, LY_VALUE_SCHEMA_RESOLVED, (void *)prefixes);
+        if (!mod) {
+            continue;
+        }
+
+        if (mod->implemented && !mod->to_compile && mod->disabled_nodes) {
+            /* recompile the module to get its disabled nodes */
+            mod->to_compile = 1;
+            rc = LY_ERECOMPILE;
+        }
+    }
+
+    return rc;
+}
+
 /**
  * @brief Implement all referenced modules by leafrefs, when and must conditions.
  *
@@ -1137,6 +1266,7 @@ implement_all:
         u = 0;
         while ((lref = lys_type_leafref_next(l->node, &u))) {
             LY_CHECK_RET(lys_compile_expr_implement(ctx, lref->path, LY_VALUE_SCHEMA_RESOLVED, lref->prefixes, 1, unres, NULL));
+            LY_CHECK_RET(lys_compile_expr_disabled(ctx, lref->path, lref->prefixes));
         }
 
         ++di;
@@ -1291,7 +1421,7 @@ static LY_ERR
 lys_compile_unres_depset(struct ly_ctx *ctx, struct lys_glob_unres *unres)
 {
     LY_ERR ret = LY_SUCCESS;
-    struct lysc_node *node;
+    struct lysc_node *node, *root;
     struct lysc_type *typeiter;
     struct lysc_type_leafref *lref;
     struct lysc_ctx cctx = {0};
@@ -1356,7 +1486,7 @@ resolve_all:
 
             lysc_type_free(&cctx.free_ctx, lref->realtype);
             lref->realtype = typeiter;
-            ++lref->realtype->refcount;
+            LY_ATOMIC_INC_BARRIER(lref->realtype->refcount);
         }
 
         /* if 'goto' will be used on the 'resolve_all' label, then the current leafref will not be processed again */
@@ -1438,6 +1568,10 @@ resolve_all:
         ret = lys_compile_unres_check_disabled(node);
         LY_CHECK_GOTO(ret, cleanup);
 
+        /* remember the module of the compiled tree, it needs to be recompiled with its importers */
+        for (root = node; root->parent; root = root->parent) {}
+        root->module->disabled_nodes = 1;
+
         LYSC_CTX_INIT_PMOD(cctx, node->module->parsed, NULL);
 
         lysc_node_free(&cctx.free_ctx, node, 1);
@@ -1499,21 +1633,199 @@ lys_compile_unres_depset_erase(const struct ly_ctx *ctx, struct lys_glob_unres *
 }
 
 /**
- * @brief Compile all flagged modules in a dependency set, recursively if recompilation is needed.
+ * @brief Learn whether a module or any of its submodules imports another module.
+ *
+ * @param[in] mod Importing module.
+ * @param[in] imp_mod Imported module.
+ * @return Whether @p imp_mod is imported.
+ */
+static ly_bool
+lys_compile_depset_imports(const struct lys_module *mod, const struct lys_module *imp_mod)
+{
+    const struct lysp_import *imports;
+    LY_ARRAY_COUNT_TYPE u, v;
+
+    LY_ARRAY_FOR(mod->parsed->imports, u) {
+        if (mod->parsed->imports[u].module == imp_mod) {
+            return 1;
+        }
+    }
+    LY_ARRAY_FOR(mod->parsed->includes, v) {
+        imports = mod->parsed->includes[v].submodule->imports;
+        LY_ARRAY_FOR(imports, u) {
+            if (imports[u].module == imp_mod) {
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Learn whether a module needs to be recompiled because of the changed modules in its dep set.
+ *
+ * @param[in] mod Module to check.
+ * @param[in] changed Set of changed modules.
+ * @return Whether @p mod depends on any of the @p changed modules.
+ */
+static ly_bool
+lys_compile_depset_mod_changed(const struct lys_module *mod, const struct ly_set *changed)
+{
+    const struct lys_module *m;
+    LY_ARRAY_COUNT_TYPE u;
+    uint32_t i;
+
+    for (i = 0; i < changed->count; ++i) {
+        m = changed->objs[i];
+
+        /* features, groupings, typedefs, identities, and nodes of a changed module may be used by the importer */
+        if (lys_compile_depset_imports(mod, m)) {
+            return 1;
+        }
+
+    }
+
+    if (mod->implemented) {
+        /* augments and deviations are compiled into the tree of their target module */
+        LY_ARRAY_FOR(mod->augmented_by, u) {
+            if (ly_set_contains(changed, mod->augmented_by[u], NULL)) {
+                return 1;
+            }
+        }
+        LY_ARRAY_FOR(mod->deviated_by, u) {
+            if (ly_set_contains(changed, mod->deviated_by[u], NULL)) {
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Flag all the modules in a dependency set affected by the flagged modules to be recompiled.
+ *
+ * Only the modules whose compiled trees may change are recompiled instead of all the modules in the dep set.
+ * These are the importers of the changed modules (also through not-implemented modules with groupings or typedefs)
+ * and target modules of their augments and deviations. Imported modules with disabled nodes referenced by disabled
+ * leafrefs are flagged only when needed, see ::lys_compile_expr_disabled().
+ *
+ * @param[in] dep_set Dependency set to process.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lys_compile_depset_changed(struct ly_set *dep_set)
+{
+    LY_ERR rc = LY_SUCCESS;
+    struct ly_set changed = {0};
+    struct lys_module *mod;
+    ly_bool found;
+    uint32_t i;
+
+    /* modules flagged to be compiled */
+    for (i = 0; i < dep_set->count; ++i) {
+        mod = dep_set->objs[i];
+        if (mod->to_compile) {
+            LY_CHECK_GOTO(rc = ly_set_add(&changed, mod, 1, NULL), cleanup);
+        }
+    }
+    if (!changed.count) {
+        goto cleanup;
+    }
+
+    /* add all the modules depending on them, until there are no new ones */
+    do {
+        found = 0;
+        for (i = 0; i < dep_set->count; ++i) {
+            mod = dep_set->objs[i];
+            if (ly_set_contains(&changed, mod, NULL) || !lys_compile_depset_mod_changed(mod, &changed)) {
+                continue;
+            }
+
+            LY_CHECK_GOTO(rc = ly_set_add(&changed, mod, 1, NULL), cleanup);
+            found = 1;
+        }
+    } while (found);
+
+    /* flag the implemented ones */
+    for (i = 0; i < changed.count; ++i) {
+        mod = changed.objs[i];
+        if (mod->implemented) {
+            mod->to_compile = 1;
+        }
+    }
+
+cleanup:
+    ly_set_erase(&changed, NULL);
+    return rc;
+}
+
+/**
+ * @brief Flag the indexed leaves of all the compiled modules in a dependency set, see ::ly_ctx_set_index().
+ *
+ * @param[in] ctx libyang context.
+ * @param[in] dep_set Compiled dependency set.
+ */
+static void
+lys_compile_depset_indexes(struct ly_ctx *ctx, const struct ly_set *dep_set)
+{
+    const struct ly_ctx_index *index;
+    struct lysc_node *leaf, *list;
+    LY_ARRAY_COUNT_TYPE u;
+    uint32_t *prev_lo, temp_lo = 0;
+
+    LY_ARRAY_FOR(ctx->indexes, u) {
+        index = &ctx->indexes[u];
+        if (!index->mod->to_compile || !ly_set_contains(dep_set, index->mod, NULL)) {
+            /* module not compiled now */
+            continue;
+        }
+
+        /* the leaf may have been removed, for example by a deviation */
+        prev_lo = ly_temp_log_options(&temp_lo);
+        leaf = (struct lysc_node *)lys_find_path(ctx, NULL, index->path, index->output);
+        ly_temp_log_options(prev_lo);
+        if (!leaf || (leaf->nodetype != LYS_LEAF) || lysc_is_key(leaf)) {
+            continue;
+        }
+        list = (struct lysc_node *)lysc_data_parent(leaf);
+        if (!list || (list->nodetype != LYS_LIST)) {
+            continue;
+        }
+
+        /* mark both the list and the leaf */
+        list->flags |= LYS_INDEXED;
+        leaf->flags |= LYS_INDEXED;
+    }
+}
+
+/**
+ * @brief Compile all flagged modules in a dependency set, without resolving the dep set unres.
+ *
+ * Only the structures of the modules in @p dep_set are modified, except for shared compiled typedefs, extension
+ * definitions, and grouping flags, which are accessed with ::ly_ctx.compile_lock held.
  *
  * @param[in] ctx libyang context.
  * @param[in] dep_set Dependency set to compile.
- * @param[in,out] unres Global unres to use.
+ * @param[in,out] ds_unres Dep set unres to fill.
  * @return LY_ERR value.
  */
 static LY_ERR
-lys_compile_depset_r(struct ly_ctx *ctx, struct ly_set *dep_set, struct lys_glob_unres *unres)
+lys_compile_depset_mods(struct ly_ctx *ctx, struct ly_set *dep_set, struct lys_depset_unres *ds_unres)
 {
     LY_ERR ret = LY_SUCCESS;
     struct lysf_ctx fctx = {.ctx = ctx};
     struct lys_module *mod;
     uint32_t i;
 
+#ifndef NDEBUG
+    struct timespec start, end;
+#endif
+
+    /* flag all the modules affected by the changes */
+    LY_CHECK_GOTO(ret = lys_compile_depset_changed(dep_set), cleanup);
+
     for (i = 0; i < dep_set->count; ++i) {
         mod = dep_set->objs[i];
         if (!mod->to_compile) {
@@ -1522,13 +1834,72 @@ lys_compile_depset_r(struct ly_ctx *ctx, struct ly_set *dep_set, struct lys_glob
         }
         assert(mod->implemented);
 
+#ifndef NDEBUG
+        clock_gettime(CLOCK_MONOTONIC, &start);
+#endif
+
         /* free the compiled module, if any */
         lysc_module_free(&fctx, mod->compiled);
         mod->compiled = NULL;
+        mod->disabled_nodes = 0;
 
         /* (re)compile the module */
-        LY_CHECK_GOTO(ret = lys_compile(mod, &unres->ds_unres), cleanup);
+        LY_CHECK_GOTO(ret = lys_compile(mod, ds_unres), cleanup);
+
+#ifndef NDEBUG
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        LOGDBG(LY_LDGDEPSETS, "module \"%s\" compiled in %" PRId64 " us", mod->name,
+                (int64_t)(end.tv_sec - start.tv_sec) * 1000000 + (end.tv_nsec - start.tv_nsec) / 1000);
+#endif
+    }
+
+cleanup:
+    lysf_ctx_erase(&fctx);
+    return ret;
+}
+
+/**
+ * @brief Finish the compilation of a dependency set once its unres was resolved.
+ *
+ * @param[in] ctx libyang context.
+ * @param[in] dep_set Compiled dependency set.
+ */
+static void
+lys_compile_depset_finish(struct ly_ctx *ctx, struct ly_set *dep_set)
+{
+    uint32_t i;
+
+    /* the compiled modules are final, flag the indexed leaves */
+    lys_compile_depset_indexes(ctx, dep_set);
+
+    /* success, unset the flags of all the modules in the dep set */
+    for (i = 0; i < dep_set->count; ++i) {
+        ((struct lys_module *)dep_set->objs[i])->to_compile = 0;
     }
+}
+
+/**
+ * @brief Compile all flagged modules in a dependency set, recursively if recompilation is needed.
+ *
+ * @param[in] ctx libyang context.
+ * @param[in] dep_set Dependency set to compile.
+ * @param[in,out] unres Global unres to use.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lys_compile_depset_r(struct ly_ctx *ctx, struct ly_set *dep_set, struct lys_glob_unres *unres)
+{
+    LY_ERR ret = LY_SUCCESS;
+
+#ifndef NDEBUG
+    struct timespec start, end;
+#endif
+
+    LY_CHECK_GOTO(ret = lys_compile_depset_mods(ctx, dep_set, &unres->ds_unres), cleanup);
+
+#ifndef NDEBUG
+    clock_gettime(CLOCK_MONOTONIC, &start);
+#endif
 
     /* resolve dep set unres */
     ret = lys_compile_unres_depset(ctx, unres);
@@ -1541,15 +1912,16 @@ lys_compile_depset_r(struct ly_ctx *ctx, struct ly_set *dep_set, struct lys_glob
         goto cleanup;
     }
 
-    /* success, unset the flags of all the modules in the dep set */
-    for (i = 0; i < dep_set->count; ++i) {
-        mod = dep_set->objs[i];
-        mod->to_compile = 0;
-    }
+#ifndef NDEBUG
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    LOGDBG(LY_LDGDEPSETS, "dep set unres resolved in %" PRId64 " us",
+            (int64_t)(end.tv_sec - start.tv_sec) * 1000000 + (end.tv_nsec - start.tv_nsec) / 1000);
+#endif
+
+    lys_compile_depset_finish(ctx, dep_set);
 
 cleanup:
     lys_compile_unres_depset_erase(ctx, unres);
-    lysf_ctx_erase(&fctx);
     return ret;
 }
 
@@ -1579,12 +1951,20 @@ lys_compile_depset_check_features(struct ly_set *dep_set)
     return LY_SUCCESS;
 }
 
-LY_ERR
-lys_compile_depset_all(struct ly_ctx *ctx, struct lys_glob_unres *unres)
+/**
+ * @brief Compile all the dependency sets one after another.
+ *
+ * @param[in] ctx libyang context.
+ * @param[in,out] unres Global unres to use.
+ * @param[in] first Index of the first dep set to compile.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lys_compile_depset_all_serial(struct ly_ctx *ctx, struct lys_glob_unres *unres, uint32_t first)
 {
     uint32_t i;
 
-    for (i = 0; i < unres->dep_sets.count; ++i) {
+    for (i = first; i < unres->dep_sets.count; ++i) {
         LY_CHECK_RET(lys_compile_depset_check_features(unres->dep_sets.objs[i]));
         LY_CHECK_RET(lys_compile_depset_r(ctx, unres->dep_sets.objs[i], unres));
     }
@@ -1592,6 +1972,245 @@ lys_compile_depset_all(struct ly_ctx *ctx, struct lys_glob_unres *unres)
     return LY_SUCCESS;
 }
 
+/**
+ * @brief Modules of a dependency set compiled by a compile thread.
+ */
+struct lys_compile_depset_res {
+    LY_ERR ret;                     /**< compilation result */
+    struct ly_err_item *err;        /**< errors and warnings generated by the compilation */
+    struct lys_depset_unres ds_unres;   /**< unres of the dependency set, to be resolved by the calling thread */
+};
+
+/**
+ * @brief Arguments shared by all the compile threads.
+ */
+struct lys_compile_depset_arg {
+    struct ly_ctx *ctx;             /**< libyang context */
+    struct ly_set *dep_sets;        /**< dependency sets to compile */
+    struct lys_compile_depset_res *res; /**< results of the dependency sets, in the same order */
+    pthread_mutex_t start_lock;     /**< held until the threads are allowed to start */
+    ATOMIC_T next;                  /**< index of the next dependency set to compile */
+    ATOMIC_T failed;                /**< set if any dependency set compilation failed */
+};
+
+/**
+ * @brief Erase the unres of a dependency set compiled by a compile thread.
+ *
+ * @param[in] ctx libyang context.
+ * @param[in] unres Global unres to use for erasing.
+ * @param[in,out] res Result with the unres to erase.
+ */
+static void
+lys_compile_depset_res_erase(struct ly_ctx *ctx, struct lys_glob_unres *unres, struct lys_compile_depset_res *res)
+{
+    unres->ds_unres = res->ds_unres;
+    memset(&res->ds_unres, 0, sizeof res->ds_unres);
+    lys_compile_unres_depset_erase(ctx, unres);
+}
+
+/**
+ * @brief Compile thread, compiles the modules of dependency sets until there are none left or one fails.
+ *
+ * @param[in] arg Compile thread arguments.
+ * @return NULL.
+ */
+static void *
+lys_compile_depset_thread(void *arg)
+{
+    struct lys_compile_depset_arg *carg = arg;
+    struct lys_compile_depset_res *res;
+    struct ly_set *dep_set;
+    uint32_t idx, log_opts = LY_LOSTORE;
+
+    /* wait until the error record of this thread is created */
+    pthread_mutex_lock(&carg->start_lock);
+    pthread_mutex_unlock(&carg->start_lock);
+
+    /* the record may have been used by a finished thread with the same ID */
+    ly_err_free(ly_err_take(carg->ctx));
+
+    /* only store all the messages, they are logged by the main thread in the order of the dep sets */
+    ly_temp_log_options(&log_opts);
+
+    while (!ATOMIC_LOAD_RELAXED(carg->failed) && ((idx = ATOMIC_INC_RELAXED(carg->next)) < carg->dep_sets->count)) {
+        dep_set = carg->dep_sets->objs[idx];
+        res = &carg->res[idx];
+
+        res->ret = lys_compile_depset_check_features(dep_set);
+        if (!res->ret) {
+            res->ret = lys_compile_depset_mods(carg->ctx, dep_set, &res->ds_unres);
+        }
+        res->err = ly_err_take(carg->ctx);
+
+        if (res->ret) {
+            ATOMIC_STORE_RELAXED(carg->failed, 1);
+        }
+    }
+
+    ly_temp_log_options(NULL);
+    return NULL;
+}
+
+/**
+ * @brief Compile the modules of all the dependency sets in parallel.
+ *
+ * Only the modules are compiled in parallel, see ::lys_compile_depset_mods(). Their unres are then resolved
+ * by the calling thread in the order of the dep sets because that may implement new modules and flag modules
+ * of any dep set for recompilation. Once it happens, the following dep sets are compiled again serially so
+ * the results are the same as if compiled by ::lys_compile_depset_all_serial().
+ *
+ * @param[in] ctx libyang context.
+ * @param[in,out] unres Global unres to use.
+ * @param[in] thread_count Number of threads to use.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lys_compile_depset_all_parallel(struct ly_ctx *ctx, struct lys_glob_unres *unres, uint32_t thread_count)
+{
+    LY_ERR rc = LY_SUCCESS;
+    struct lys_compile_depset_arg arg = {0};
+    struct lys_compile_depset_res *res;
+    struct ly_set *dep_set;
+    struct ly_err_item *e;
+    pthread_t *threads = NULL;
+    pthread_attr_t attr;
+    size_t stack_size;
+    uint32_t i, j, count = 0, implementing;
+    ly_bool recompiled;
+
+    arg.ctx = ctx;
+    arg.dep_sets = &unres->dep_sets;
+    arg.res = calloc(unres->dep_sets.count, sizeof *arg.res);
+    threads = malloc(thread_count * sizeof *threads);
+    LY_CHECK_ERR_GOTO(!arg.res || !threads, LOGMEM(ctx); rc = LY_EMEM, cleanup);
+    pthread_mutex_init(&arg.start_lock, NULL);
+
+    /* compilation is deeply recursive, do not use smaller stacks than the main thread usually has */
+    pthread_attr_init(&attr);
+    if (!pthread_attr_getstacksize(&attr, &stack_size) && (stack_size < LYS_COMPILE_THREAD_STACK_SIZE)) {
+        pthread_attr_setstacksize(&attr, LYS_COMPILE_THREAD_STACK_SIZE);
+    }
+
+    /* START LOCK */
+    pthread_mutex_lock(&arg.start_lock);
+
+    for (count = 0; count < thread_count; ++count) {
+        if (pthread_create(&threads[count], &attr, lys_compile_depset_thread, &arg)) {
+            break;
+        }
+
+        /* create the error record now, the threads cannot modify the context concurrently */
+        if ((rc = ly_err_thread_rec(ctx, threads[count]))) {
+            ATOMIC_STORE_RELAXED(arg.failed, 1);
+            ++count;
+            break;
+        }
+    }
+
+    /* START UNLOCK */
+    pthread_mutex_unlock(&arg.start_lock);
+
+    for (i = 0; i < count; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+    for (i = 0; i < count; ++i) {
+        /* the threads are gone, so must be their error records */
+        ly_err_thread_rec_free(ctx, threads[i]);
+    }
+    pthread_attr_destroy(&attr);
+    pthread_mutex_destroy(&arg.start_lock);
+
+    if (!count) {
+        /* no threads, compile serially */
+        rc = lys_compile_depset_all_serial(ctx, unres, 0);
+        goto cleanup;
+    }
+
+    for (i = 0; !rc && (i < unres->dep_sets.count); ++i) {
+        dep_set = unres->dep_sets.objs[i];
+        res = &arg.res[i];
+
+        /* log the messages as if the dep sets were compiled serially, until the first failed one */
+        LY_LIST_FOR(res->err, e) {
+            ly_err_print(ctx, e);
+        }
+        if ((rc = res->ret)) {
+            break;
+        }
+
+        /* resolve the dep set unres */
+        unres->ds_unres = res->ds_unres;
+        memset(&res->ds_unres, 0, sizeof res->ds_unres);
+        implementing = unres->implementing.count;
+        rc = lys_compile_unres_depset(ctx, unres);
+        lys_compile_unres_depset_erase(ctx, unres);
+
+        recompiled = 0;
+        if (rc == LY_ERECOMPILE) {
+            /* new module is implemented or some modules flagged, recompile the whole dep set */
+            rc = lys_compile_depset_r(ctx, dep_set, unres);
+            recompiled = 1;
+        } else if (!rc) {
+            lys_compile_depset_finish(ctx, dep_set);
+        }
+
+        if (!rc && (recompiled || (implementing < unres->implementing.count))) {
+            /* modules of the following dep sets may have been flagged, discard their unres referencing
+             * the modules and compile them again serially */
+            for (j = i + 1; j < unres->dep_sets.count; ++j) {
+                lys_compile_depset_res_erase(ctx, unres, &arg.res[j]);
+            }
+            rc = lys_compile_depset_all_serial(ctx, unres, i + 1);
+            break;
+        }
+    }
+
+cleanup:
+    if (arg.res) {
+        for (i = 0; i < unres->dep_sets.count; ++i) {
+            ly_err_free(arg.res[i].err);
+            lys_compile_depset_res_erase(ctx, unres, &arg.res[i]);
+        }
+    }
+    free(arg.res);
+    free(threads);
+    return rc;
+}
+
+LY_ERR
+lys_compile_depset_all(struct ly_ctx *ctx, struct lys_glob_unres *unres)
+{
+    struct ly_set *dep_set;
+    uint32_t i, j, count = 0, max;
+
+    /* count dep sets with anything to compile */
+    for (i = 0; i < unres->dep_sets.count; ++i) {
+        dep_set = unres->dep_sets.objs[i];
+        for (j = 0; j < dep_set->count; ++j) {
+            if (((struct lys_module *)dep_set->objs[j])->to_compile) {
+                ++count;
+                break;
+            }
+        }
+    }
+
+    if (count && ctx->parsed_freed) {
+        LOGERR(ctx, LY_EDENIED, "Unable to compile modules in a context with freed parsed modules.");
+        return LY_EDENIED;
+    }
+
+    /* dep sets are independent of each other, compile them in parallel if allowed and it can help */
+    max = ctx->compile_threads ? ctx->compile_threads : ly_cpu_count();
+    if (count > max) {
+        count = max;
+    }
+    if (count > 1) {
+        return lys_compile_depset_all_parallel(ctx, unres, count);
+    }
+
+    return lys_compile_depset_all_serial(ctx, unres, 0);
+}
+
 /**
  * @brief Finish compilation of all the module unres sets in a compile context.
  *
@@ -1710,7 +2329,7 @@ lys_compile(struct lys_module *mod, struct lys_depset_unres *unres)
     LYSC_CTX_INIT_PMOD(ctx, sp, NULL);
     ctx.unres = unres;
 
-    ++mod->ctx->change_count;
+    LY_ATOMIC_INC_BARRIER(mod->ctx->change_count);
     mod->compiled = mod_c = calloc(1, sizeof *mod_c);
     LY_CHECK_ERR_RET(!mod_c, LOGMEM(mod->ctx), LY_EMEM);
     mod_c->mod = mod;
@@ -378,6 +378,11 @@ LY_ERR lys_compile_expr_implement(const struct ly_ctx *ctx, const struct lyxp_ex
  * - identityref, instance-identifier default value
  * - new implemented module augments, deviations
  *
+ * The dependency sets are independent of each other so if there are more of them to compile and more threads
+ * allowed by ::ly_ctx.compile_threads, step 4) is performed in parallel. Any structures the dep sets may share are accessed only with
+ * ::ly_ctx.compile_lock held. Step 5) may modify modules of any dep set so it is always performed serially,
+ * in the order of the dep sets.
+ *
  * @param[in] ctx libyang context.
  * @param[in,out] unres Global unres to use.
  * @return LY_ERR value.
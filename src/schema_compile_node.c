@@ -1637,7 +1637,6 @@ lys_compile_type_union(struct lysc_ctx *ctx, struct lysp_type *ptypes, struct ly
         ret = lys_compile_type(ctx, context_pnode, context_flags, context_name, &ptypes[u], &utypes[u + additional],
                 NULL, NULL);
         LY_CHECK_GOTO(ret, error);
-        LY_ATOMIC_INC_BARRIER(utypes[u + additional]->refcount);
 
         if (utypes[u + additional]->basetype == LY_TYPE_UNION) {
             /* add space for additional types from the union subtype */
@@ -2129,8 +2128,13 @@ cleanup:
     return rc;
 }
 
-LY_ERR
-lys_compile_type(struct lysc_ctx *ctx, struct lysp_node *context_pnode, uint16_t context_flags, const char *context_name,
+/**
+ * @brief Compile information about the leaf/leaf-list's type, see ::lys_compile_type().
+ *
+ * Compile lock must be held if the type is derived from a typedef.
+ */
+static LY_ERR
+_lys_compile_type(struct lysc_ctx *ctx, struct lysp_node *context_pnode, uint16_t context_flags, const char *context_name,
         const struct lysp_type *type_p, struct lysc_type **type, const char **units, struct lysp_qname **dflt)
 {
     LY_ERR ret = LY_SUCCESS;
@@ -2343,6 +2347,35 @@ cleanup:
     return ret;
 }
 
+LY_ERR
+lys_compile_type(struct lysc_ctx *ctx, struct lysp_node *context_pnode, uint16_t context_flags, const char *context_name,
+        const struct lysp_type *type_p, struct lysc_type **type, const char **units, struct lysp_qname **dflt)
+{
+    LY_ERR rc;
+    ly_bool tpdf;
+
+    /* compiled typedefs and their patterns are shared with all the modules using them, which may be in other
+     * dep sets being compiled, built-in types are private */
+    tpdf = !lysp_type_str2builtin(type_p->name, strlen(type_p->name));
+    if (tpdf) {
+        /* LOCK */
+        pthread_mutex_lock(&ctx->ctx->compile_lock);
+    }
+
+    rc = _lys_compile_type(ctx, context_pnode, context_flags, context_name, type_p, type, units, dflt);
+    if (!rc) {
+        /* new reference, before any other thread can free the type */
+        LY_ATOMIC_INC_BARRIER((*type)->refcount);
+    }
+
+    if (tpdf) {
+        /* UNLOCK */
+        pthread_mutex_unlock(&ctx->ctx->compile_lock);
+    }
+
+    return rc;
+}
+
 /**
  * @brief Check uniqness of the node/action/notification name.
  *
@@ -2976,7 +3009,6 @@ lys_compile_node_type(struct lysc_ctx *ctx, struct lysp_node *context_node, stru
 
     LY_CHECK_RET(lys_compile_type(ctx, context_node, leaf->flags, leaf->name, type_p, &leaf->type,
             leaf->units ? NULL : &leaf->units, &dflt));
-    LY_ATOMIC_INC_BARRIER(leaf->type->refcount);
 
     /* store default value, if any */
     if (dflt && !(leaf->flags & LYS_SET_DFLT)) {
@@ -3914,9 +3946,14 @@ lys_compile_uses_find_grouping(struct lysc_ctx *ctx, struct lysp_node_uses *uses
         return LY_EVALID;
     }
 
-    if (!(ctx->compile_opts & LYS_COMPILE_GROUPING)) {
-        /* remember that the grouping is instantiated to avoid its standalone validation */
+    if (!(ctx->compile_opts & LYS_COMPILE_GROUPING) && !(grp->flags & LYS_USED_GRP)) {
+        /* remember that the grouping is instantiated to avoid its standalone validation, it may be
+         * from a module shared with other dep sets being compiled */
+        /* LOCK */
+        pthread_mutex_lock(&ctx->ctx->compile_lock);
         grp->flags |= LYS_USED_GRP;
+        /* UNLOCK */
+        pthread_mutex_unlock(&ctx->ctx->compile_lock);
     }
 
     *grp_p = grp;
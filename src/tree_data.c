@@ -93,12 +93,14 @@ lyd_parse_get_format(const struct ly_in *in, LYD_FORMAT format)
  * @param[in] format Expected format of the data in @p in.
  * @param[in] parse_opts Options for parser.
  * @param[in] val_opts Options for validation.
+ * @param[in] filter Optional filter to skip the data that cannot affect its results, not used by LYB parser.
  * @param[out] op Optional pointer to the parsed operation, if any.
  * @return LY_ERR value.
  */
 static LY_ERR
 lyd_parse(const struct ly_ctx *ctx, const struct lysc_ext_instance *ext, struct lyd_node *parent, struct lyd_node **first_p,
-        struct ly_in *in, LYD_FORMAT format, uint32_t parse_opts, uint32_t val_opts, struct lyd_node **op)
+        struct ly_in *in, LYD_FORMAT format, uint32_t parse_opts, uint32_t val_opts, struct lyd_filter *filter,
+        struct lyd_node **op)
 {
     LY_ERR r = LY_SUCCESS, rc = LY_SUCCESS;
     struct lyd_ctx *lydctx = NULL;
@@ -125,11 +127,11 @@ lyd_parse(const struct ly_ctx *ctx, const struct lysc_ext_instance *ext, struct
     /* parse the data */
     switch (format) {
     case LYD_XML:
-        r = lyd_parse_xml(ctx, ext, parent, first_p, in, parse_opts, val_opts, int_opts, &parsed,
+        r = lyd_parse_xml(ctx, ext, parent, first_p, in, parse_opts, val_opts, int_opts, filter, &parsed,
                 &subtree_sibling, &lydctx);
         break;
     case LYD_JSON:
-        r = lyd_parse_json(ctx, ext, parent, first_p, in, parse_opts, val_opts, int_opts, &parsed,
+        r = lyd_parse_json(ctx, ext, parent, first_p, in, parse_opts, val_opts, int_opts, filter, &parsed,
                 &subtree_sibling, &lydctx);
         break;
     case LYD_LYB:
@@ -208,7 +210,7 @@ lyd_parse_ext_data(const struct lysc_ext_instance *ext, struct lyd_node *parent,
     LY_CHECK_ARG_RET(ctx, !(parse_options & ~LYD_PARSE_OPTS_MASK), LY_EINVAL);
     LY_CHECK_ARG_RET(ctx, !(validate_options & ~LYD_VALIDATE_OPTS_MASK), LY_EINVAL);
 
-    return lyd_parse(ctx, ext, parent, tree, in, format, parse_options, validate_options, NULL);
+    return lyd_parse(ctx, ext, parent, tree, in, format, parse_options, validate_options, NULL, NULL);
 }
 
 LIBYANG_API_DEF LY_ERR
@@ -219,7 +221,7 @@ lyd_parse_data(const struct ly_ctx *ctx, struct lyd_node *parent, struct ly_in *
     LY_CHECK_ARG_RET(ctx, !(parse_options & ~LYD_PARSE_OPTS_MASK), LY_EINVAL);
     LY_CHECK_ARG_RET(ctx, !(validate_options & ~LYD_VALIDATE_OPTS_MASK), LY_EINVAL);
 
-    return lyd_parse(ctx, NULL, parent, tree, in, format, parse_options, validate_options, NULL);
+    return lyd_parse(ctx, NULL, parent, tree, in, format, parse_options, validate_options, NULL, NULL);
 }
 
 LIBYANG_API_DEF LY_ERR
@@ -264,6 +266,41 @@ lyd_parse_data_path(const struct ly_ctx *ctx, const char *path, LYD_FORMAT forma
     return ret;
 }
 
+LIBYANG_API_DEF LY_ERR
+lyd_parse_data_filter(const struct ly_ctx *ctx, struct ly_in *in, LYD_FORMAT format, uint32_t parse_options,
+        const char *xpath, struct lyd_node **tree)
+{
+    LY_ERR r, rc;
+    struct lyd_filter *filter = NULL;
+
+    LY_CHECK_ARG_RET(ctx, ctx, in, xpath, tree, LY_EINVAL);
+    LY_CHECK_ARG_RET(ctx, !(parse_options & ~LYD_PARSE_OPTS_MASK), LY_EINVAL);
+
+    *tree = NULL;
+
+    if (lyd_parse_get_format(in, format) != LYD_LYB) {
+        /* compile the filter to skip the data that cannot be selected, if supported */
+        LY_CHECK_RET(lyd_parser_filter_new(ctx, xpath, &filter));
+    }
+
+    /* parse the data, filtered data cannot be valid */
+    rc = lyd_parse(ctx, NULL, NULL, tree, in, format, parse_options | LYD_PARSE_ONLY, 0, filter, NULL);
+    lyd_parser_filter_free(filter);
+    if (rc && (rc != LY_ENOT)) {
+        return rc;
+    }
+
+    /* select the exact results */
+    r = lyd_trim_xpath(tree, xpath, NULL);
+    if (r) {
+        lyd_free_all(*tree);
+        *tree = NULL;
+        return r;
+    }
+
+    return rc;
+}
+
 /**
  * @brief Parse YANG data into an operation data tree, in case the extension instance is specified, keep the searching
  * for schema nodes locked inside the extension instance.
@@ -383,10 +420,10 @@ lyd_parse_op_(const struct ly_ctx *ctx, const struct lysc_ext_instance *ext, str
     /* parse the data */
     switch (format) {
     case LYD_XML:
-        rc = lyd_parse_xml(ctx, ext, parent, &first, in, parse_opts, val_opts, int_opts, &parsed, NULL, &lydctx);
+        rc = lyd_parse_xml(ctx, ext, parent, &first, in, parse_opts, val_opts, int_opts, NULL, &parsed, NULL, &lydctx);
         break;
     case LYD_JSON:
-        rc = lyd_parse_json(ctx, ext, parent, &first, in, parse_opts, val_opts, int_opts, &parsed, NULL, &lydctx);
+        rc = lyd_parse_json(ctx, ext, parent, &first, in, parse_opts, val_opts, int_opts, NULL, &parsed, NULL, &lydctx);
         break;
     case LYD_LYB:
         rc = lyd_parse_lyb(ctx, ext, parent, &first, in, parse_opts, val_opts, int_opts, &parsed, NULL, &lydctx);
@@ -450,6 +487,60 @@ lyd_parse_ext_op(const struct lysc_ext_instance *ext, struct lyd_node *parent, s
     return lyd_parse_op_(ctx, ext, parent, in, format, data_type, tree, op);
 }
 
+/**
+ * @brief Try to get the next anchor of a new top-level node from the last top-level siblings.
+ *
+ * Top-level siblings are ordered by their modules and then by their schema order so in the usual case
+ * of nodes being created in this order, the anchor can be learned without traversing all the siblings.
+ *
+ * @param[in] first_sibling First top-level sibling.
+ * @param[in] new_node Node to be inserted.
+ * @param[in] getnext_opts Options for ::lys_getnext().
+ * @param[out] anchor Next anchor, NULL if inserting at the end.
+ * @return Whether the anchor was learned.
+ */
+static ly_bool
+lyd_insert_get_next_anchor_top(const struct lyd_node *first_sibling, const struct lyd_node *new_node,
+        uint32_t getnext_opts, struct lyd_node **anchor)
+{
+    const struct lys_module *mod, *last_mod;
+    const struct lysc_node *schema;
+    const struct lyd_node *last;
+
+    /* skip the trailing opaque nodes */
+    last = first_sibling->prev;
+    while (!last->schema && (last != first_sibling)) {
+        last = last->prev;
+    }
+    if (!last->schema) {
+        /* only opaque nodes */
+        return 0;
+    }
+    *anchor = last->next;
+
+    mod = lyd_owner_module(new_node);
+    last_mod = lyd_owner_module(last);
+    if (last_mod != mod) {
+        /* new node belongs after the last node if its module does */
+        return strcmp(last_mod->name, mod->name) < 0;
+    }
+
+    if (last->schema == new_node->schema) {
+        /* another instance */
+        return 1;
+    }
+
+    /* new node belongs after the last node if its schema node follows */
+    schema = last->schema;
+    while ((schema = lys_getnext(schema, NULL, mod->compiled, getnext_opts))) {
+        if (schema == new_node->schema) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
 struct lyd_node *
 lyd_insert_get_next_anchor(const struct lyd_node *first_sibling, const struct lyd_node *new_node)
 {
@@ -488,9 +579,16 @@ lyd_insert_get_next_anchor(const struct lyd_node *first_sibling, const struct ly
         match = (struct lyd_node *)first_sibling;
         sparent = lysc_data_parent(new_node->schema);
         if (!sparent) {
-            /* we are in top-level, skip all the data from preceding modules */
+            /* we are in top-level, the node is usually being appended */
+            if (lyd_insert_get_next_anchor_top(first_sibling, new_node, getnext_opts, &match)) {
+                return match;
+            }
+
+            /* skip all the data from preceding modules */
+            match = (struct lyd_node *)first_sibling;
             LY_LIST_FOR(match, match) {
-                if (!match->schema || (strcmp(lyd_owner_module(match)->name, lyd_owner_module(new_node)->name) >= 0)) {
+                if (!match->schema || (lyd_owner_module(match) == lyd_owner_module(new_node)) ||
+                        (strcmp(lyd_owner_module(match)->name, lyd_owner_module(new_node)->name) >= 0)) {
                     break;
                 }
             }
@@ -3067,14 +3165,23 @@ lyd_find_meta(const struct lyd_meta *first, const struct lys_module *module, con
     return ret;
 }
 
-LIBYANG_API_DEF LY_ERR
-lyd_find_sibling_first(const struct lyd_node *siblings, const struct lyd_node *target, struct lyd_node **match)
+/**
+ * @brief Search in the given siblings (NOT recursively) for the first target instance with the same value using
+ * a specific hash table of the siblings.
+ *
+ * @param[in] siblings Siblings to search in including preceding and succeeding nodes.
+ * @param[in] ht Hash table of @p siblings, NULL to search them linearly.
+ * @param[in] target Target node to find.
+ * @param[out] match Can be NULL, otherwise the found data node.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lyd_find_sibling_first_ht(const struct lyd_node *siblings, const struct ly_ht *ht, const struct lyd_node *target,
+        struct lyd_node **match)
 {
     struct lyd_node **match_p, *iter, *dup = NULL;
-    struct lyd_node_inner *parent;
     ly_bool found;
 
-    LY_CHECK_ARG_RET(NULL, target, LY_EINVAL);
     if (!siblings) {
         /* no data */
         if (match) {
@@ -3101,8 +3208,7 @@ lyd_find_sibling_first(const struct lyd_node *siblings, const struct lyd_node *t
     /* get first sibling */
     siblings = lyd_first_sibling(siblings);
 
-    parent = siblings->parent;
-    if (target->schema && parent && parent->schema && parent->children_ht) {
+    if (target->schema && ht) {
         assert(target->hash);
 
         if (lysc_is_dup_inst_list(target->schema)) {
@@ -3121,7 +3227,7 @@ lyd_find_sibling_first(const struct lyd_node *siblings, const struct lyd_node *t
             }
         } else {
             /* find by hash */
-            if (!lyht_find(parent->children_ht, &target, target->hash, (void **)&match_p)) {
+            if (!lyht_find(ht, &target, target->hash, (void **)&match_p)) {
                 siblings = *match_p;
             } else {
                 /* not found */
@@ -3129,7 +3235,7 @@ lyd_find_sibling_first(const struct lyd_node *siblings, const struct lyd_node *t
             }
         }
     } else {
-        /* no children hash table or cannot be used */
+        /* no siblings hash table or cannot be used */
         for ( ; siblings; siblings = siblings->next) {
             if (lysc_is_dup_inst_list(target->schema)) {
                 if (!lyd_compare_single(siblings, target, LYD_COMPARE_FULL_RECURSION)) {
@@ -3158,14 +3264,32 @@ lyd_find_sibling_first(const struct lyd_node *siblings, const struct lyd_node *t
 }
 
 LIBYANG_API_DEF LY_ERR
-lyd_find_sibling_val(const struct lyd_node *siblings, const struct lysc_node *schema, const char *key_or_value,
-        size_t val_len, struct lyd_node **match)
+lyd_find_sibling_first(const struct lyd_node *siblings, const struct lyd_node *target, struct lyd_node **match)
+{
+    LY_CHECK_ARG_RET(NULL, target, LY_EINVAL);
+
+    return lyd_find_sibling_first_ht(siblings, siblings ? lyd_sibling_ht(siblings) : NULL, target, match);
+}
+
+/**
+ * @brief Search in the given siblings for the first schema instance using a specific hash table of the siblings.
+ *
+ * @param[in] siblings Siblings to search in including preceding and succeeding nodes.
+ * @param[in] ht Hash table of @p siblings, NULL to search them linearly.
+ * @param[in] schema Schema node of the data node to find.
+ * @param[in] key_or_value Expected value depends on the type of @p schema, see ::lyd_find_sibling_val().
+ * @param[in] val_len Optional length of @p key_or_value in case it is not 0-terminated.
+ * @param[out] match Can be NULL, otherwise the found data node.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lyd_find_sibling_val_ht(const struct lyd_node *siblings, const struct ly_ht *ht, const struct lysc_node *schema,
+        const char *key_or_value, size_t val_len, struct lyd_node **match)
 {
     LY_ERR rc;
     struct lyd_node *target = NULL;
     const struct lyd_node *parent;
 
-    LY_CHECK_ARG_RET(NULL, schema, !(schema->nodetype & (LYS_CHOICE | LYS_CASE)), LY_EINVAL);
     if (!siblings) {
         /* no data */
         if (match) {
@@ -3210,16 +3334,43 @@ lyd_find_sibling_val(const struct lyd_node *siblings, const struct lysc_node *sc
         }
 
         /* find it */
-        rc = lyd_find_sibling_first(siblings, target, match);
+        rc = lyd_find_sibling_first_ht(siblings, ht, target, match);
     } else {
         /* find the first schema node instance */
-        rc = lyd_find_sibling_schema(siblings, schema, match);
+        rc = lyd_find_sibling_schema_ht(siblings, ht, schema, match);
     }
 
     lyd_free_tree(target);
     return rc;
 }
 
+LIBYANG_API_DEF LY_ERR
+lyd_find_sibling_val(const struct lyd_node *siblings, const struct lysc_node *schema, const char *key_or_value,
+        size_t val_len, struct lyd_node **match)
+{
+    LY_CHECK_ARG_RET(NULL, schema, !(schema->nodetype & (LYS_CHOICE | LYS_CASE)), LY_EINVAL);
+
+    return lyd_find_sibling_val_ht(siblings, siblings ? lyd_sibling_ht(siblings) : NULL, schema, key_or_value, val_len,
+            match);
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_top_ht_find_first(const struct lyd_top_ht *top_ht, const struct lyd_node *target, struct lyd_node **match)
+{
+    LY_CHECK_ARG_RET(NULL, top_ht, target, LY_EINVAL);
+
+    return lyd_find_sibling_first_ht(top_ht->first, top_ht->ht, target, match);
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_top_ht_find_val(const struct lyd_top_ht *top_ht, const struct lysc_node *schema, const char *key_or_value,
+        size_t val_len, struct lyd_node **match)
+{
+    LY_CHECK_ARG_RET(NULL, top_ht, schema, !(schema->nodetype & (LYS_CHOICE | LYS_CASE)), LY_EINVAL);
+
+    return lyd_find_sibling_val_ht(top_ht->first, top_ht->ht, schema, key_or_value, val_len, match);
+}
+
 LIBYANG_API_DEF LY_ERR
 lyd_find_sibling_dup_inst_set(const struct lyd_node *siblings, const struct lyd_node *target, struct ly_set **set)
 {
@@ -3296,6 +3447,53 @@ error:
     return LY_EMEM;
 }
 
+LIBYANG_API_DEF LY_ERR
+lyd_find_sibling_leaf_val(const struct lyd_node *siblings, const struct lysc_node *leaf, const char *value,
+        size_t val_len, struct ly_set **set)
+{
+    LY_ERR rc;
+    const struct lysc_node *list;
+    struct lyd_node *target = NULL;
+
+    LY_CHECK_ARG_RET(NULL, leaf, leaf->nodetype == LYS_LEAF, value, set, LY_EINVAL);
+    LY_CHECK_CTX_EQUAL_RET(siblings ? LYD_CTX(siblings) : NULL, leaf->module->ctx, LY_EINVAL);
+
+    list = lysc_data_parent(leaf);
+    if (!list || (list->nodetype != LYS_LIST)) {
+        LOGERR(leaf->module->ctx, LY_EINVAL, "Leaf \"%s\" is not a child of a list.", leaf->name);
+        return LY_EINVAL;
+    }
+
+    LY_CHECK_RET(ly_set_new(set));
+
+    if (!siblings || (siblings->schema && (lysc_data_parent(siblings->schema) != lysc_data_parent(list)))) {
+        /* no data or schema mismatch */
+        return LY_ENOTFOUND;
+    }
+
+    if (!val_len) {
+        val_len = strlen(value);
+    }
+
+    /* target used attributes: schema, value */
+    rc = lyd_create_term(leaf, value, val_len, 0, 1, NULL, LY_VALUE_JSON, NULL, LYD_HINT_DATA, NULL, &target);
+    LY_CHECK_GOTO(rc, cleanup);
+
+    /* find all the instances */
+    LY_CHECK_GOTO(rc = lyd_find_sibling_index(siblings, target, *set), cleanup);
+    if (!(*set)->count) {
+        rc = LY_ENOTFOUND;
+    }
+
+cleanup:
+    lyd_free_tree(target);
+    if (rc && (rc != LY_ENOTFOUND)) {
+        ly_set_free(*set, NULL);
+        *set = NULL;
+    }
+    return rc;
+}
+
 LIBYANG_API_DEF LY_ERR
 lyd_find_sibling_opaq_next(const struct lyd_node *first, const char *name, struct lyd_node **match)
 {
@@ -3531,6 +3729,7 @@ lyd_trim_xpath(struct lyd_node **tree, const char *xpath, const struct lyxp_var
             ret = lyht_insert(parent_ht, &parent, parent->hash, NULL);
             if (ret == LY_EEXIST) {
                 /* shared parent, we are done */
+                ret = LY_SUCCESS;
                 break;
             }
             LY_CHECK_GOTO(ret, cleanup);
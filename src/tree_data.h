@@ -45,6 +45,7 @@ struct ly_set;
 struct lyd_node;
 struct lyd_node_opaq;
 struct lyd_node_term;
+struct lyd_top_ht;
 struct timespec;
 struct lyxp_var;
 struct rb_node;
@@ -111,8 +112,13 @@ struct rb_node;
  * - ::lyd_find_path()
  * - ::lyd_find_target()
  * - ::lyd_find_sibling_val()
+ * - ::lyd_find_sibling_leaf_val()
  * - ::lyd_find_sibling_first()
  * - ::lyd_find_sibling_opaq_next()
+ * - ::lyd_top_ht_new()
+ * - ::lyd_top_ht_find_first()
+ * - ::lyd_top_ht_find_val()
+ * - ::lyd_top_ht_free()
  * - ::lyd_find_meta()
  *
  * - ::lyd_path()
@@ -569,9 +575,10 @@ typedef enum {
  * @brief YANG data representation
  */
 struct lyd_value {
-    const char *_canonical;          /**< Should never be accessed directly, instead ::lyd_get_value() and ::lyd_get_meta_value()
-                                          should be used. Serves as a cache for the canonical value or the JSON
-                                          representation if no canonical value is defined. */
+    const char *_canonical;          /**< Should never be accessed directly, instead ::lyd_get_value(), ::lyd_get_meta_value(),
+                                          or ::lyd_value_get_canonical() should be used. Serves as a cache for the canonical
+                                          value or the JSON representation if no canonical value is defined, it is NULL
+                                          until first generated for types printing it lazily. */
     const struct lysc_type *realtype; /**< pointer to the real type of the data stored in the value structure. This type can differ from the type
                                           in the schema node of the data node since the type's store plugin can use other types/plugins for
                                           storing data. Speaking about built-in types, this is the case of leafref which stores data as its
@@ -840,7 +847,8 @@ struct lyd_node_inner {
     };                                      /**< common part corresponding to ::lyd_node */
 
     struct lyd_node *child;          /**< pointer to the first child node. */
-    struct ly_ht *children_ht;  /**< hash table with all the direct children (except keys for a list, lists without keys) */
+    struct ly_ht *children_ht;  /**< hash table with all the direct children (except keys for a list, lists without keys)
+                                     and the indexed leaves of the list children, see ::ly_ctx_set_index() */
 
 #define LYD_HT_MIN_ITEMS 4           /**< minimal number of children to create ::lyd_node_inner.children_ht hash table. */
 };
@@ -2362,7 +2370,8 @@ LIBYANG_API_DECL struct lyd_meta *lyd_find_meta(const struct lyd_meta *first, co
 
 /**
  * @brief Search in the given siblings (NOT recursively) for the first target instance with the same value.
- * Uses hashes - should be used whenever possible for best performance.
+ * Uses hashes - should be used whenever possible for best performance. Top-level siblings have no hash table and
+ * are searched linearly, use ::lyd_top_ht_new() for many lookups among them.
  *
  * @param[in] siblings Siblings to search in including preceding and succeeding nodes.
  * @param[in] target Target node to find.
@@ -2376,7 +2385,8 @@ LIBYANG_API_DECL LY_ERR lyd_find_sibling_first(const struct lyd_node *siblings,
 
 /**
  * @brief Search in the given siblings for the first schema instance.
- * Uses hashes - should be used whenever possible for best performance.
+ * Uses hashes - should be used whenever possible for best performance. Top-level siblings have no hash table and
+ * are searched linearly, use ::lyd_top_ht_new() for many lookups among them.
  *
  * @param[in] siblings Siblings to search in including preceding and succeeding nodes.
  * @param[in] schema Schema node of the data node to find.
@@ -2401,6 +2411,74 @@ LIBYANG_API_DECL LY_ERR lyd_find_sibling_first(const struct lyd_node *siblings,
 LIBYANG_API_DECL LY_ERR lyd_find_sibling_val(const struct lyd_node *siblings, const struct lysc_node *schema,
         const char *key_or_value, size_t val_len, struct lyd_node **match);
 
+/**
+ * @brief Create a hash table of top-level siblings for searching them using hashes.
+ *
+ * Top-level siblings have no parent to store their hash table in so the searches in them are linear. The hash table
+ * is owned by the caller and is not updated when the siblings change. It must not be used after any top-level
+ * sibling is inserted, unlinked, or freed, create a new one instead. Searches in the hash table do not modify it
+ * so it can be used by several threads at once.
+ *
+ * @param[in] siblings Top-level siblings to hash.
+ * @param[out] top_ht Created hash table of @p siblings, free with ::lyd_top_ht_free().
+ * @return LY_ERR value.
+ */
+LIBYANG_API_DECL LY_ERR lyd_top_ht_new(const struct lyd_node *siblings, struct lyd_top_ht **top_ht);
+
+/**
+ * @brief Search the hash table of top-level siblings for the first target instance with the same value,
+ * see ::lyd_find_sibling_first().
+ *
+ * @param[in] top_ht Hash table of top-level siblings.
+ * @param[in] target Target node to find.
+ * @param[out] match Can be NULL, otherwise the found data node.
+ * @return LY_SUCCESS on success, @p match set.
+ * @return LY_ENOTFOUND if not found, @p match set to NULL.
+ * @return LY_ERR value if another error occurred.
+ */
+LIBYANG_API_DECL LY_ERR lyd_top_ht_find_first(const struct lyd_top_ht *top_ht, const struct lyd_node *target,
+        struct lyd_node **match);
+
+/**
+ * @brief Search the hash table of top-level siblings for the first schema instance, see ::lyd_find_sibling_val().
+ *
+ * @param[in] top_ht Hash table of top-level siblings.
+ * @param[in] schema Schema node of the data node to find.
+ * @param[in] key_or_value Value to find, see ::lyd_find_sibling_val().
+ * @param[in] val_len Optional length of @p key_or_value in case it is not 0-terminated.
+ * @param[out] match Can be NULL, otherwise the found data node.
+ * @return LY_SUCCESS on success, @p match set.
+ * @return LY_ENOTFOUND if not found, @p match set to NULL.
+ * @return LY_EINVAL if @p schema is a key-less list.
+ * @return LY_ERR value if another error occurred.
+ */
+LIBYANG_API_DECL LY_ERR lyd_top_ht_find_val(const struct lyd_top_ht *top_ht, const struct lysc_node *schema,
+        const char *key_or_value, size_t val_len, struct lyd_node **match);
+
+/**
+ * @brief Free a hash table of top-level siblings.
+ *
+ * @param[in] top_ht Hash table to free.
+ */
+LIBYANG_API_DECL void lyd_top_ht_free(struct lyd_top_ht *top_ht);
+
+/**
+ * @brief Search the given siblings for all the list instances with a specific value of one of their leaves.
+ * Uses the secondary index of the list created by ::ly_ctx_set_index() if the siblings have a hash table,
+ * otherwise all the list instances are traversed. Top-level siblings never have a hash table with the index.
+ *
+ * @param[in] siblings Siblings to search in including preceding and succeeding nodes.
+ * @param[in] leaf Schema node of the leaf of the list.
+ * @param[in] value Searched leaf value, it is canonized first before comparison.
+ * @param[in] val_len Optional length of @p value in case it is not 0-terminated.
+ * @param[out] set Set with all the found list instances in the data order.
+ * @return LY_SUCCESS on success, @p set returned.
+ * @return LY_ENOTFOUND if not found, empty @p set returned.
+ * @return LY_ERR value if another error occurred.
+ */
+LIBYANG_API_DECL LY_ERR lyd_find_sibling_leaf_val(const struct lyd_node *siblings, const struct lysc_node *leaf,
+        const char *value, size_t val_len, struct ly_set **set);
+
 /**
  * @brief Search the given siblings for all the exact same instances of a specific node instance.
  * Uses hashes to whatever extent possible.
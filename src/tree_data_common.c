@@ -1196,9 +1196,15 @@ lyd_hash_table_schema_val_equal(void *val1_p, void *val2_p, ly_bool UNUSED(mod),
 
 LY_ERR
 lyd_find_sibling_schema(const struct lyd_node *siblings, const struct lysc_node *schema, struct lyd_node **match)
+{
+    return lyd_find_sibling_schema_ht(siblings, siblings ? lyd_sibling_ht(siblings) : NULL, schema, match);
+}
+
+LY_ERR
+lyd_find_sibling_schema_ht(const struct lyd_node *siblings, const struct ly_ht *ht, const struct lysc_node *schema,
+        struct lyd_node **match)
 {
     struct lyd_node **match_p;
-    struct lyd_node_inner *parent;
     uint32_t hash;
 
     assert(schema);
@@ -1210,15 +1216,14 @@ lyd_find_sibling_schema(const struct lyd_node *siblings, const struct lysc_node
         return LY_ENOTFOUND;
     }
 
-    parent = siblings->parent;
-    if (parent && parent->schema && parent->children_ht) {
+    if (ht) {
         /* calculate our hash */
         hash = lyht_hash_multi(0, schema->module->name, strlen(schema->module->name));
         hash = lyht_hash_multi(hash, schema->name, strlen(schema->name));
         hash = lyht_hash_multi(hash, NULL, 0);
 
         /* find by hash but use special hash table function (and stay thread-safe) */
-        if (!lyht_find_with_val_cb(parent->children_ht, &schema, hash, lyd_hash_table_schema_val_equal, (void **)&match_p)) {
+        if (!lyht_find_with_val_cb(ht, &schema, hash, lyd_hash_table_schema_val_equal, (void **)&match_p)) {
             siblings = *match_p;
         } else {
             /* not found */
@@ -1265,6 +1270,73 @@ lyd_find_sibling_schema(const struct lyd_node *siblings, const struct lysc_node
     return LY_SUCCESS;
 }
 
+/**
+ * @brief Compare callback for sorting data node pointers.
+ *
+ * @param[in] ptr1 Pointer to the first data node pointer.
+ * @param[in] ptr2 Pointer to the second data node pointer.
+ * @return Negative, zero, or positive value.
+ */
+static int
+lyd_ptr_cmp(const void *ptr1, const void *ptr2)
+{
+    uintptr_t node1 = (uintptr_t)*(const struct lyd_node **)ptr1, node2 = (uintptr_t)*(const struct lyd_node **)ptr2;
+
+    return (node1 > node2) - (node1 < node2);
+}
+
+LY_ERR
+lyd_find_sibling_index(const struct lyd_node *siblings, const struct lyd_node *leaf, struct ly_set *set)
+{
+    const struct lysc_node *list;
+    struct lyd_node *iter, *match, **found;
+    struct ly_ht *ht;
+    uint32_t first_idx = set->count, i;
+
+    list = lysc_data_parent(leaf->schema);
+    assert(list && (list->nodetype == LYS_LIST));
+
+    if (!siblings) {
+        /* no data */
+        return LY_SUCCESS;
+    }
+
+    if ((leaf->schema->flags & LYS_INDEXED) && (ht = lyd_sibling_ht(siblings))) {
+        /* find by the secondary index */
+        LY_CHECK_RET(lyd_find_hash_index(ht, leaf, set));
+        if (set->count - first_idx < 2) {
+            return LY_SUCCESS;
+        }
+
+        /* restore the data order of the instances */
+        found = malloc((set->count - first_idx) * sizeof *found);
+        LY_CHECK_ERR_RET(!found, LOGMEM(LYD_CTX(siblings)), LY_EMEM);
+        memcpy(found, &set->dnodes[first_idx], (set->count - first_idx) * sizeof *found);
+        qsort(found, set->count - first_idx, sizeof *found, lyd_ptr_cmp);
+
+        i = first_idx;
+        LYD_LIST_FOR_INST(siblings, list, iter) {
+            if (bsearch(&iter, found, set->count - first_idx, sizeof *found, lyd_ptr_cmp)) {
+                set->dnodes[i++] = iter;
+                if (i == set->count) {
+                    break;
+                }
+            }
+        }
+        free(found);
+        assert(i == set->count);
+    } else {
+        /* search all the list instances */
+        LYD_LIST_FOR_INST(siblings, list, iter) {
+            if (!lyd_find_sibling_schema(lyd_child(iter), leaf->schema, &match) && !lyd_compare_single(match, leaf, 0)) {
+                LY_CHECK_RET(ly_set_add(set, iter, 1, NULL));
+            }
+        }
+    }
+
+    return LY_SUCCESS;
+}
+
 void
 lyd_del_move_root(struct lyd_node **root, const struct lyd_node *to_del, const struct lys_module *mod)
 {
@@ -1588,50 +1660,184 @@ ly_format2str(LY_VALUE_FORMAT format)
     return NULL;
 }
 
-LIBYANG_API_DEF int
-ly_time_tz_offset(void)
+/**
+ * @brief Get the number of days since the UNIX epoch of a proleptic Gregorian calendar date.
+ *
+ * @param[in] year Full year.
+ * @param[in] mon Month, 1 - 12.
+ * @param[in] mday Day of month, may overflow the month.
+ * @return Number of days since 1970-01-01.
+ */
+static int64_t
+ly_time_days_from_civil(int64_t year, int64_t mon, int64_t mday)
 {
-    return ly_time_tz_offset_at(time(NULL));
+    int64_t era, yoe, doy, doe;
+
+    /* years start in March so that the leap day is the last one */
+    year -= (mon <= 2);
+    era = (year >= 0 ? year : year - 399) / 400;
+    yoe = year - era * 400;
+    doy = (153 * (mon > 2 ? mon - 3 : mon + 9) + 2) / 5 + mday - 1;
+    doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+    return era * 146097 + doe - 719468;
 }
 
-LIBYANG_API_DEF int
-ly_time_tz_offset_at(time_t time)
+/**
+ * @brief Get the proleptic Gregorian calendar date from the number of days since the UNIX epoch.
+ *
+ * @param[in] days Number of days since 1970-01-01.
+ * @param[out] year Full year.
+ * @param[out] mon Month, 1 - 12.
+ * @param[out] mday Day of month, 1 - 31.
+ */
+static void
+ly_time_civil_from_days(int64_t days, int64_t *year, int *mon, int *mday)
+{
+    int64_t era, doe, yoe, doy, mp;
+
+    days += 719468;
+    era = (days >= 0 ? days : days - 146096) / 146097;
+    doe = days - era * 146097;
+    yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    mp = (5 * doy + 2) / 153;
+
+    *mday = doy - (153 * mp + 2) / 5 + 1;
+    *mon = mp < 10 ? mp + 3 : mp - 9;
+    *year = yoe + era * 400 + (*mon <= 2);
+}
+
+/**
+ * @brief Get the local time of a UNIX timestamp and its timezone offset.
+ *
+ * @param[in] time UNIX timestamp.
+ * @param[out] tm Local broken-down time.
+ * @param[out] tz_offset Timezone offset in seconds.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+ly_time_localtime(time_t time, struct tm *tm, int *tz_offset)
 {
-    struct tm tm_local, tm_utc;
-    int result = 0;
+    int64_t local;
 
     /* init timezone */
     tzset();
 
-    /* get local and UTC time */
-    localtime_r(&time, &tm_local);
-    gmtime_r(&time, &tm_utc);
+    if (!localtime_r(&time, tm)) {
+        return LY_ESYS;
+    }
+
+    /* the offset is the difference of the local time read as UTC and the timestamp (do not use tm_gmtoff to avoid
+     * portability problems) */
+    local = ly_time_days_from_civil(tm->tm_year + 1900LL, tm->tm_mon + 1, tm->tm_mday) * 86400 +
+            tm->tm_hour * 3600 + tm->tm_min * 60 + tm->tm_sec;
+    *tz_offset = local - time;
+
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Print a zero-padded decimal number.
+ *
+ * @param[in] num Number to print.
+ * @param[in] width Number of digits to print.
+ * @param[in] buf Buffer to print into.
+ * @return Pointer after the last printed digit.
+ */
+static char *
+ly_time_print_digits(uint32_t num, uint32_t width, char *buf)
+{
+    uint32_t i;
 
-    /* account for year/month/day change by adding/subtracting from the hours, the change cannot be more than 1 day */
-    if (tm_local.tm_year < tm_utc.tm_year) {
-        tm_utc.tm_hour += 24;
-    } else if (tm_local.tm_year > tm_utc.tm_year) {
-        tm_local.tm_hour += 24;
-    } else if (tm_local.tm_mon < tm_utc.tm_mon) {
-        tm_utc.tm_hour += 24;
-    } else if (tm_local.tm_mon > tm_utc.tm_mon) {
-        tm_local.tm_hour += 24;
-    } else if (tm_local.tm_mday < tm_utc.tm_mday) {
-        tm_utc.tm_hour += 24;
-    } else if (tm_local.tm_mday > tm_utc.tm_mday) {
-        tm_local.tm_hour += 24;
+    for (i = width; i; --i) {
+        buf[i - 1] = '0' + num % 10;
+        num /= 10;
+    }
+    return buf + width;
+}
+
+/**
+ * @brief Print a date-and-time string from its parts.
+ *
+ * @param[in] year Full year.
+ * @param[in] mon Month, 1 - 12.
+ * @param[in] mday Day of month.
+ * @param[in] hour Hours.
+ * @param[in] min Minutes.
+ * @param[in] sec Seconds.
+ * @param[in] fractions_s Optional fractions of a second.
+ * @param[in] tz_offset Timezone offset in seconds.
+ * @param[in] unknown_tz Whether to print the unknown timezone "-00:00" instead of @p tz_offset.
+ * @param[out] str Printed date-and-time.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+ly_time_print(int64_t year, int mon, int mday, int hour, int min, int sec, const char *fractions_s, int tz_offset,
+        ly_bool unknown_tz, char **str)
+{
+    size_t frac_len = fractions_s ? strlen(fractions_s) : 0;
+    char *ptr;
+    int tz_abs;
+
+    if ((year < 0) || (year > 9999)) {
+        /* cannot be printed in the fixed-width format, fall back to a generic print */
+        if (asprintf(str, "%04" PRId64 "-%02d-%02dT%02d:%02d:%02d%s%s%c%02d:%02d", year, mon, mday, hour, min, sec,
+                fractions_s ? "." : "", fractions_s ? fractions_s : "", (unknown_tz || (tz_offset < 0)) ? '-' : '+',
+                abs(tz_offset) / 3600, abs(tz_offset) / 60 % 60) == -1) {
+            return LY_EMEM;
+        }
+        return LY_SUCCESS;
+    }
+
+    /* YYYY-MM-DDThh:mm:ss[.frac]+hh:mm */
+    *str = malloc(19 + (fractions_s ? 1 + frac_len : 0) + 6 + 1);
+    LY_CHECK_RET(!*str, LY_EMEM);
+
+    ptr = ly_time_print_digits(year, 4, *str);
+    *ptr++ = '-';
+    ptr = ly_time_print_digits(mon, 2, ptr);
+    *ptr++ = '-';
+    ptr = ly_time_print_digits(mday, 2, ptr);
+    *ptr++ = 'T';
+    ptr = ly_time_print_digits(hour, 2, ptr);
+    *ptr++ = ':';
+    ptr = ly_time_print_digits(min, 2, ptr);
+    *ptr++ = ':';
+    ptr = ly_time_print_digits(sec, 2, ptr);
+    if (fractions_s) {
+        *ptr++ = '.';
+        memcpy(ptr, fractions_s, frac_len);
+        ptr += frac_len;
     }
 
-    /* hours shift in seconds */
-    result += (tm_local.tm_hour - tm_utc.tm_hour) * 3600;
+    tz_abs = abs(tz_offset);
+    *ptr++ = (unknown_tz || (tz_offset < 0)) ? '-' : '+';
+    ptr = ly_time_print_digits(tz_abs / 3600, 2, ptr);
+    *ptr++ = ':';
+    ptr = ly_time_print_digits(tz_abs / 60 % 60, 2, ptr);
+    *ptr = '\0';
 
-    /* minutes shift in seconds */
-    result += (tm_local.tm_min - tm_utc.tm_min) * 60;
+    return LY_SUCCESS;
+}
+
+LIBYANG_API_DEF int
+ly_time_tz_offset(void)
+{
+    return ly_time_tz_offset_at(time(NULL));
+}
 
-    /* seconds shift */
-    result += tm_local.tm_sec - tm_utc.tm_sec;
+LIBYANG_API_DEF int
+ly_time_tz_offset_at(time_t time)
+{
+    struct tm tm;
+    int tz_offset;
 
-    return result;
+    if (ly_time_localtime(time, &tm, &tz_offset)) {
+        return 0;
+    }
+
+    return tz_offset;
 }
 
 LIBYANG_API_DEF LY_ERR
@@ -1674,7 +1880,9 @@ ly_time_str2time(const char *value, time_t *time, char **fractions_s)
         return LY_EINVAL;
     }
 
-    t = timegm(&tm);
+    /* same as timegm() but without normalizing the broken-down time */
+    t = ly_time_days_from_civil(tm.tm_year + 1900LL, tm.tm_mon + 1, tm.tm_mday) * 86400 +
+            tm.tm_hour * 3600 + tm.tm_min * 60 + tm.tm_sec;
     i = 19;
 
     /* fractions of a second */
@@ -1735,33 +1943,34 @@ LIBYANG_API_DEF LY_ERR
 ly_time_time2str(time_t time, const char *fractions_s, char **str)
 {
     struct tm tm;
-    char zoneshift[12];
-    int zonediff_s, zonediff_h, zonediff_m;
+    int tz_offset;
 
     LY_CHECK_ARG_RET(NULL, str, LY_EINVAL);
 
-    /* init timezone */
-    tzset();
-
     /* convert */
-    if (!localtime_r(&time, &tm)) {
-        return LY_ESYS;
-    }
-
-    /* get timezone offset (do not use tm_gmtoff to avoid portability problems) */
-    zonediff_s = ly_time_tz_offset_at(time);
-    zonediff_h = zonediff_s / 60 / 60;
-    zonediff_m = zonediff_s / 60 % 60;
-    sprintf(zoneshift, "%+03d:%02d", zonediff_h, zonediff_m);
+    LY_CHECK_RET(ly_time_localtime(time, &tm, &tz_offset));
 
     /* print */
-    if (asprintf(str, "%04d-%02d-%02dT%02d:%02d:%02d%s%s%s",
-            tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec,
-            fractions_s ? "." : "", fractions_s ? fractions_s : "", zoneshift) == -1) {
-        return LY_EMEM;
+    return ly_time_print(tm.tm_year + 1900LL, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec, fractions_s,
+            tz_offset, 0, str);
+}
+
+LY_ERR
+ly_time_time2str_utc(time_t time, const char *fractions_s, ly_bool unknown_tz, char **str)
+{
+    int64_t days, secs, year;
+    int mon, mday;
+
+    /* split into days and seconds of the day */
+    days = time / 86400;
+    secs = time % 86400;
+    if (secs < 0) {
+        --days;
+        secs += 86400;
     }
+    ly_time_civil_from_days(days, &year, &mon, &mday);
 
-    return LY_SUCCESS;
+    return ly_time_print(year, mon, mday, secs / 3600, secs / 60 % 60, secs % 60, fractions_s, 0, unknown_tz, str);
 }
 
 LIBYANG_API_DEF LY_ERR
@@ -22,8 +22,10 @@
 #include "log.h"
 #include "ly_common.h"
 #include "plugins_types.h"
+#include "set.h"
 #include "tree.h"
 #include "tree_data.h"
+#include "tree_data_internal.h"
 #include "tree_schema.h"
 
 LY_ERR
@@ -79,6 +81,88 @@ lyd_hash(struct lyd_node *node)
     return LY_SUCCESS;
 }
 
+/**
+ * @brief Get the hash of the first (leaf-)list instance, which does not include any values.
+ *
+ * @param[in] schema Schema node of the (leaf-)list.
+ * @return Simple hash.
+ */
+static uint32_t
+lyd_hash_first_inst(const struct lysc_node *schema)
+{
+    uint32_t hash;
+
+    hash = lyht_hash_multi(0, schema->module->name, strlen(schema->module->name));
+    hash = lyht_hash_multi(hash, schema->name, strlen(schema->name));
+    return lyht_hash_multi(hash, NULL, 0);
+}
+
+/**
+ * @brief Get the hash of an indexed leaf instance in the secondary index of its list instances.
+ *
+ * @param[in] leaf Indexed leaf instance.
+ * @return Index hash.
+ */
+static uint32_t
+lyd_hash_index(const struct lyd_node_term *leaf)
+{
+    const struct lysc_node *list = lysc_data_parent(leaf->schema);
+    const void *hash_key;
+    ly_bool dyn;
+    size_t key_len;
+    uint32_t hash;
+
+    /* list and leaf module and schema names */
+    hash = lyht_hash_multi(0, list->module->name, strlen(list->module->name));
+    hash = lyht_hash_multi(hash, list->name, strlen(list->name));
+    hash = lyht_hash_multi(hash, leaf->schema->module->name, strlen(leaf->schema->module->name));
+    hash = lyht_hash_multi(hash, leaf->schema->name, strlen(leaf->schema->name));
+
+    /* leaf value */
+    hash_key = leaf->value.realtype->plugin->print(NULL, &leaf->value, LY_VALUE_LYB, NULL, &dyn, &key_len);
+    hash = lyht_hash_multi(hash, hash_key, key_len);
+    if (dyn) {
+        free((void *)hash_key);
+    }
+
+    return lyht_hash_multi(hash, NULL, 0);
+}
+
+/**
+ * @brief Check whether a data node is a leaf with a secondary index of its list instances.
+ *
+ * @param[in] node Data node to check.
+ * @return Whether @p node is an indexed leaf.
+ */
+static ly_bool
+lyd_hash_is_indexed(const struct lyd_node *node)
+{
+    return node->schema && (node->schema->flags & LYS_INDEXED) && (node->schema->nodetype == LYS_LEAF);
+}
+
+/**
+ * @brief Get the hash table with the secondary index of an indexed leaf.
+ *
+ * @param[in] node Data node.
+ * @return Hash table of the siblings of the list instance of @p node;
+ * @return NULL if @p node is not an indexed leaf or there is no such hash table.
+ */
+static struct ly_ht *
+lyd_hash_index_ht(const struct lyd_node *node)
+{
+    const struct lyd_node_inner *list;
+
+    if (!lyd_hash_is_indexed(node)) {
+        return NULL;
+    }
+
+    list = node->parent;
+    if (!list || !list->schema) {
+        return NULL;
+    }
+    return lyd_sibling_ht(&list->node);
+}
+
 /**
  * @brief Compare callback for values in hash table.
  *
@@ -112,17 +196,129 @@ lyd_hash_table_val_equal(void *val1_p, void *val2_p, ly_bool mod, void *UNUSED(c
     return 0;
 }
 
+/**
+ * @brief Compare callback for exact instances in hash table.
+ *
+ * Implementation of ::lyht_value_equal_cb.
+ */
+static ly_bool
+lyd_hash_table_inst_equal(void *val1_p, void *val2_p, ly_bool UNUSED(mod), void *UNUSED(cb_data))
+{
+    return (*((struct lyd_node **)val1_p) == *((struct lyd_node **)val2_p)) ? 1 : 0;
+}
+
+/**
+ * @brief Secondary index lookup used as the value to find in a children hash table.
+ */
+struct lyd_hash_index_lookup {
+    struct lyd_node *match;         /**< previously found indexed leaf instance, needs to be the first member so that
+                                         the lookup can be used to find the next instance */
+    const struct lyd_node *leaf;    /**< leaf instance with the value to find */
+};
+
+/**
+ * @brief Compare callback for the secondary index lookups in hash table.
+ *
+ * Implementation of ::lyht_value_equal_cb.
+ */
+static ly_bool
+lyd_hash_index_val_equal(void *val1_p, void *val2_p, ly_bool UNUSED(mod), void *UNUSED(cb_data))
+{
+    const struct lyd_hash_index_lookup *lookup = val1_p;
+    struct lyd_node *leaf;
+
+    leaf = *((struct lyd_node **)val2_p);
+
+    if (leaf->schema != lookup->leaf->schema) {
+        /* a sibling or another indexed leaf with a colliding hash */
+        return 0;
+    }
+
+    /* compare the leaf value */
+    return lyd_compare_single(leaf, lookup->leaf, 0) ? 0 : 1;
+}
+
+/**
+ * @brief Add a list instance into the secondary index of one of its leaves.
+ *
+ * The index is stored in the hash table of the siblings of the list instance but the records are the indexed leaf
+ * instances. Unlike the list instances, they are never the records of the siblings so none of the records can
+ * be the exact same value as another, which is not supported (by the HT), whatever the hashes.
+ *
+ * @param[in] ht Hash table of the siblings of the list instance.
+ * @param[in] leaf Indexed leaf instance of the list instance.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lyd_insert_hash_index(struct ly_ht *ht, struct lyd_node *leaf)
+{
+    if (lyht_insert_no_check(ht, &leaf, lyd_hash_index((struct lyd_node_term *)leaf), NULL)) {
+        LOGINT_RET(LYD_CTX(leaf));
+    }
+
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Remove a list instance from the secondary index of one of its leaves.
+ *
+ * @param[in] ht Hash table of the siblings of the list instance.
+ * @param[in] leaf Indexed leaf instance of the list instance.
+ */
+static void
+lyd_unlink_hash_index(struct ly_ht *ht, struct lyd_node *leaf)
+{
+    uint32_t hash;
+
+    hash = lyd_hash_index((struct lyd_node_term *)leaf);
+
+    /* the instance may not be in the index if it was created before the index */
+    if (lyht_find_with_val_cb(ht, &leaf, hash, lyd_hash_table_inst_equal, NULL)) {
+        return;
+    }
+
+    if (lyht_remove(ht, &leaf, hash)) {
+        LOGINT(LYD_CTX(leaf));
+    }
+}
+
+LY_ERR
+lyd_find_hash_index(const struct ly_ht *ht, const struct lyd_node *leaf, struct ly_set *set)
+{
+    struct lyd_hash_index_lookup lookup = {.leaf = leaf};
+    struct lyd_node **match_p;
+    uint32_t hash;
+
+    hash = lyd_hash_index((struct lyd_node_term *)leaf);
+
+    if (lyht_find_with_val_cb(ht, &lookup, hash, lyd_hash_index_val_equal, (void **)&match_p)) {
+        /* not found */
+        return LY_SUCCESS;
+    }
+
+    do {
+        lookup.match = *match_p;
+        LY_CHECK_RET(ly_set_add(set, lyd_parent(lookup.match), 1, NULL));
+
+        /* find next instance */
+    } while (!lyht_find_next_with_collision_cb(ht, &lookup, hash, lyd_hash_index_val_equal, (void **)&match_p));
+
+    return LY_SUCCESS;
+}
+
 /**
  * @brief Add single node into children hash table.
  *
  * @param[in] ht Children hash table.
  * @param[in] node Node to insert.
  * @param[in] empty_ht Whether we started with an empty HT meaning no nodes were inserted yet.
+ * @param[in] add_index Whether to add a list instance into the secondary indexes of its leaves.
  * @return LY_ERR value.
  */
 static LY_ERR
-lyd_insert_hash_add(struct ly_ht *ht, struct lyd_node *node, ly_bool empty_ht)
+lyd_insert_hash_add(struct ly_ht *ht, struct lyd_node *node, ly_bool empty_ht, ly_bool add_index)
 {
+    struct lyd_node *iter;
     uint32_t hash;
 
     assert(ht && node && node->schema);
@@ -136,9 +332,7 @@ lyd_insert_hash_add(struct ly_ht *ht, struct lyd_node *node, ly_bool empty_ht)
     if ((node->schema->nodetype & (LYS_LIST | LYS_LEAFLIST)) &&
             (!node->prev->next || (node->prev->schema != node->schema))) {
         /* get the simple hash */
-        hash = lyht_hash_multi(0, node->schema->module->name, strlen(node->schema->module->name));
-        hash = lyht_hash_multi(hash, node->schema->name, strlen(node->schema->name));
-        hash = lyht_hash_multi(hash, NULL, 0);
+        hash = lyd_hash_first_inst(node->schema);
 
         /* remove any previous stored instance, only if we did not start with an empty HT */
         if (!empty_ht && node->next && (node->next->schema == node->schema)) {
@@ -156,13 +350,80 @@ lyd_insert_hash_add(struct ly_ht *ht, struct lyd_node *node, ly_bool empty_ht)
         }
     }
 
+    /* add list instance into the secondary indexes of its leaves */
+    if (add_index && (node->schema->flags & LYS_INDEXED) && (node->schema->nodetype == LYS_LIST)) {
+        LY_LIST_FOR(lyd_child(node), iter) {
+            if (lyd_hash_is_indexed(iter)) {
+                LY_CHECK_RET(lyd_insert_hash_index(ht, iter));
+            }
+        }
+    }
+
     return LY_SUCCESS;
 }
 
+struct ly_ht *
+lyd_sibling_ht(const struct lyd_node *sibling)
+{
+    if (sibling->parent && sibling->parent->schema) {
+        return sibling->parent->children_ht;
+    }
+    return NULL;
+}
+
+LIBYANG_API_DEF LY_ERR
+lyd_top_ht_new(const struct lyd_node *siblings, struct lyd_top_ht **top_ht)
+{
+    LY_ERR rc = LY_SUCCESS;
+    const struct lyd_node *iter;
+    uint32_t u;
+
+    LY_CHECK_ARG_RET(NULL, siblings, !siblings->parent, top_ht, LY_EINVAL);
+
+    *top_ht = calloc(1, sizeof **top_ht);
+    LY_CHECK_ERR_RET(!*top_ht, LOGMEM(LYD_CTX(siblings)), LY_EMEM);
+    (*top_ht)->first = siblings = lyd_first_sibling(siblings);
+
+    u = 0;
+    LY_LIST_FOR(siblings, iter) {
+        if (iter->schema) {
+            ++u;
+        }
+    }
+
+    /* the same content as a children hash table except for the secondary indexes, which would not be updated */
+    (*top_ht)->ht = lyht_new(lyht_get_fixed_size(u), sizeof(struct lyd_node *), lyd_hash_table_val_equal, NULL, 1);
+    LY_CHECK_ERR_GOTO(!(*top_ht)->ht, LOGMEM(LYD_CTX(siblings)); rc = LY_EMEM, cleanup);
+    LY_LIST_FOR(siblings, iter) {
+        if (iter->schema) {
+            LY_CHECK_GOTO(rc = lyd_insert_hash_add((*top_ht)->ht, (struct lyd_node *)iter, 1, 0), cleanup);
+        }
+    }
+
+cleanup:
+    if (rc) {
+        lyd_top_ht_free(*top_ht);
+        *top_ht = NULL;
+    }
+    return rc;
+}
+
+LIBYANG_API_DEF void
+lyd_top_ht_free(struct lyd_top_ht *top_ht)
+{
+    if (!top_ht) {
+        return;
+    }
+
+    lyht_free(top_ht->ht, NULL);
+    free(top_ht);
+}
+
 LY_ERR
 lyd_insert_hash(struct lyd_node *node)
 {
     struct lyd_node *iter;
+    struct ly_ht *index_ht;
     uint32_t u;
 
     if (!node->parent || !node->schema || !node->parent->schema) {
@@ -170,6 +431,11 @@ lyd_insert_hash(struct lyd_node *node)
         return LY_SUCCESS;
     }
 
+    if ((index_ht = lyd_hash_index_ht(node))) {
+        /* add the parent list instance into the secondary index */
+        LY_CHECK_RET(lyd_insert_hash_index(index_ht, node));
+    }
+
     /* create parent hash table if required, otherwise just add the new child */
     if (!node->parent->children_ht) {
         /* the hash table is created only when the number of children in a node exceeds the
@@ -185,12 +451,12 @@ lyd_insert_hash(struct lyd_node *node)
             node->parent->children_ht = lyht_new(lyht_get_fixed_size(u), sizeof(struct lyd_node *), lyd_hash_table_val_equal, NULL, 1);
             LY_LIST_FOR(node->parent->child, iter) {
                 if (iter->schema) {
-                    LY_CHECK_RET(lyd_insert_hash_add(node->parent->children_ht, iter, 1));
+                    LY_CHECK_RET(lyd_insert_hash_add(node->parent->children_ht, iter, 1, 1));
                 }
             }
         }
     } else {
-        LY_CHECK_RET(lyd_insert_hash_add(node->parent->children_ht, node, 0));
+        LY_CHECK_RET(lyd_insert_hash_add(node->parent->children_ht, node, 0, 1));
     }
 
     return LY_SUCCESS;
@@ -199,8 +465,15 @@ lyd_insert_hash(struct lyd_node *node)
 void
 lyd_unlink_hash(struct lyd_node *node)
 {
+    struct lyd_node *iter;
+    struct ly_ht *index_ht;
     uint32_t hash;
 
+    if ((index_ht = lyd_hash_index_ht(node))) {
+        /* remove the parent list instance from the secondary index */
+        lyd_unlink_hash_index(index_ht, node);
+    }
+
     if (!node->parent || !node->schema || !node->parent->schema || !node->parent->children_ht) {
         /* not in any HT */
         return;
@@ -212,12 +485,19 @@ lyd_unlink_hash(struct lyd_node *node)
         return;
     }
 
+    /* remove list instance from the secondary indexes of its leaves */
+    if ((node->schema->flags & LYS_INDEXED) && (node->schema->nodetype == LYS_LIST)) {
+        LY_LIST_FOR(lyd_child(node), iter) {
+            if (lyd_hash_is_indexed(iter)) {
+                lyd_unlink_hash_index(node->parent->children_ht, iter);
+            }
+        }
+    }
+
     /* first instance of the (leaf-)list, needs to be removed from HT */
     if ((node->schema->nodetype & (LYS_LIST | LYS_LEAFLIST)) && (!node->prev->next || (node->prev->schema != node->schema))) {
         /* get the simple hash */
-        hash = lyht_hash_multi(0, node->schema->module->name, strlen(node->schema->module->name));
-        hash = lyht_hash_multi(hash, node->schema->name, strlen(node->schema->name));
-        hash = lyht_hash_multi(hash, NULL, 0);
+        hash = lyd_hash_first_inst(node->schema);
 
         /* remove the instance */
         if (lyht_remove(node->parent->children_ht, &node, hash)) {
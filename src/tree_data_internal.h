@@ -136,6 +136,32 @@ void lyd_cont_set_dflt(struct lyd_node *node);
  */
 LY_ERR lyd_find_sibling_schema(const struct lyd_node *siblings, const struct lysc_node *schema, struct lyd_node **match);
 
+/**
+ * @brief Search in the given siblings (NOT recursively) for the first schema node data instance using a specific
+ * hash table of the siblings.
+ *
+ * @param[in] siblings Siblings to search in including preceding and succeeding nodes.
+ * @param[in] ht Hash table of @p siblings, NULL to search them linearly.
+ * @param[in] schema Target data node schema to find.
+ * @param[out] match Can be NULL, otherwise the found data node.
+ * @return LY_SUCCESS on success, @p match set.
+ * @return LY_ENOTFOUND if not found, @p match set to NULL.
+ * @return LY_ERR value if another error occurred.
+ */
+LY_ERR lyd_find_sibling_schema_ht(const struct lyd_node *siblings, const struct ly_ht *ht, const struct lysc_node *schema,
+        struct lyd_node **match);
+
+/**
+ * @brief Search in the given siblings (NOT recursively) for all the list instances with a specific leaf value.
+ * Uses the secondary index of the leaf, if any.
+ *
+ * @param[in] siblings Siblings to search in including preceding and succeeding nodes, may be NULL.
+ * @param[in] leaf Leaf instance of the list with the value to find.
+ * @param[in,out] set Set to add the found list instances to, in the data order.
+ * @return LY_ERR value.
+ */
+LY_ERR lyd_find_sibling_index(const struct lyd_node *siblings, const struct lyd_node *leaf, struct ly_set *set);
+
 /**
  * @brief Check whether a node to be deleted is the root node, move it if it is.
  *
@@ -600,6 +626,14 @@ LY_ERR ly_value_validate(const struct ly_ctx *ctx, const struct lysc_node *node,
  */
 LY_ERR lyd_hash(struct lyd_node *node);
 
+/**
+ * @brief Hash table of top-level data siblings, see ::lyd_top_ht_new().
+ */
+struct lyd_top_ht {
+    const struct lyd_node *first;   /**< first top-level sibling */
+    struct ly_ht *ht;               /**< hash table of the siblings, the same content as ::lyd_node_inner.children_ht */
+};
+
 /**
  * @brief Insert hash of the node into the hash table of its parent.
  *
@@ -617,6 +651,25 @@ LY_ERR lyd_insert_hash(struct lyd_node *node);
  */
 void lyd_unlink_hash(struct lyd_node *node);
 
+/**
+ * @brief Get the hash table of data siblings.
+ *
+ * @param[in] sibling Any data sibling.
+ * @return Children hash table of the parent of @p sibling;
+ * @return NULL if there is no such hash table, always for top-level siblings.
+ */
+struct ly_ht *lyd_sibling_ht(const struct lyd_node *sibling);
+
+/**
+ * @brief Find all the list instances with a specific leaf value in the secondary index of the leaf.
+ *
+ * @param[in] ht Children hash table of the parent of the list instances.
+ * @param[in] leaf Indexed leaf instance with the value to find.
+ * @param[in,out] set Set to add the found list instances to, in no particular order.
+ * @return LY_ERR value.
+ */
+LY_ERR lyd_find_hash_index(const struct ly_ht *ht, const struct lyd_node *leaf, struct ly_set *set);
+
 /** @} datahash */
 
 /**
@@ -711,4 +764,17 @@ LY_ERR lyd_unlink_leafref_node(const struct lyd_node_term *node, const struct ly
  */
 void lyd_unlink_ignore_lyds(struct lyd_node **first_sibling, struct lyd_node *node);
 
+/**
+ * @brief Convert UNIX timestamp to date-and-time string in UTC.
+ *
+ * Same as ::ly_time_time2str() but without any local timezone lookup.
+ *
+ * @param[in] time UNIX timestamp to convert.
+ * @param[in] fractions_s Optional fractions of a second.
+ * @param[in] unknown_tz Whether to print the unknown timezone "-00:00" instead of "+00:00".
+ * @param[out] str String date-and-time.
+ * @return LY_ERR value.
+ */
+LY_ERR ly_time_time2str_utc(time_t time, const char *fractions_s, ly_bool unknown_tz, char **str);
+
 #endif /* LY_TREE_DATA_INTERNAL_H_ */
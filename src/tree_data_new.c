@@ -283,10 +283,10 @@ lyd_create_any_datatree(const struct ly_ctx *ctx, struct ly_in *value_in, LYD_AN
         /* unreachable */
         LOGINT_RET(ctx);
     case LYD_ANYDATA_XML:
-        rc = lyd_parse_xml(ctx, NULL, NULL, tree, value_in, parse_opts, 0, int_opts, NULL, NULL, &lydctx);
+        rc = lyd_parse_xml(ctx, NULL, NULL, tree, value_in, parse_opts, 0, int_opts, NULL, NULL, NULL, &lydctx);
         break;
     case LYD_ANYDATA_JSON:
-        rc = lyd_parse_json(ctx, NULL, NULL, tree, value_in, parse_opts, 0, int_opts, NULL, NULL, &lydctx);
+        rc = lyd_parse_json(ctx, NULL, NULL, tree, value_in, parse_opts, 0, int_opts, NULL, NULL, NULL, &lydctx);
         break;
     case LYD_ANYDATA_LYB:
         rc = lyd_parse_lyb(ctx, NULL, NULL, tree, value_in, parse_opts | LYD_PARSE_STRICT, 0, int_opts, NULL, NULL, &lydctx);
@@ -1254,6 +1254,9 @@ lyd_change_node_value(struct lyd_node_term *term, struct lyd_value *val)
         target = (struct lyd_node *)term;
     } else if ((term->schema->flags & LYS_KEY) && term->parent) {
         target = (struct lyd_node *)term->parent;
+    } else if (term->schema->flags & LYS_INDEXED) {
+        /* leaf value is used for the hash of its list in the secondary index */
+        target = (struct lyd_node *)term;
     } else {
         /* just change the value */
         term->value.realtype->plugin->free(LYD_CTX(term), &term->value);
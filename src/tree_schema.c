@@ -20,11 +20,13 @@
 #include <ctype.h>
 #include <dirent.h>
 #include <errno.h>
+#include <pthread.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/stat.h>
+#include <time.h>
 #include <unistd.h>
 
 #include "compat.h"
@@ -1004,10 +1006,7 @@ LY_ERR
 lys_unres_dep_sets_create(struct ly_ctx *ctx, struct ly_set *main_set, struct lys_module *mod)
 {
     LY_ERR ret = LY_SUCCESS;
-    struct lys_module *m;
     struct ly_set *dep_set = NULL, *ctx_set = NULL, aux_set = {0};
-    uint32_t i;
-    ly_bool found;
 
     assert(!main_set->count);
 
@@ -1036,26 +1035,6 @@ lys_unres_dep_sets_create(struct ly_ctx *ctx, struct ly_set *main_set, struct ly
         ly_set_erase(&aux_set, NULL);
         assert(dep_set->count);
 
-        /* check whether there is any module that will be (re)compiled */
-        found = 0;
-        for (i = 0; i < dep_set->count; ++i) {
-            m = dep_set->objs[i];
-            if (m->to_compile) {
-                found = 1;
-                break;
-            }
-        }
-
-        if (found) {
-            /* if there is, all the implemented modules need to be recompiled */
-            for (i = 0; i < dep_set->count; ++i) {
-                m = dep_set->objs[i];
-                if (m->implemented) {
-                    m->to_compile = 1;
-                }
-            }
-        }
-
         /* add the dep set into main set */
         LY_CHECK_GOTO(ret = ly_set_add(main_set, dep_set, 1, NULL), cleanup);
         dep_set = NULL;
@@ -1068,12 +1047,13 @@ lys_unres_dep_sets_create(struct ly_ctx *ctx, struct ly_set *main_set, struct ly
 
 #ifndef NDEBUG
     LOGDBG(LY_LDGDEPSETS, "dep sets created (%" PRIu32 "):", main_set->count);
-    for (i = 0; i < main_set->count; ++i) {
+    for (uint32_t i = 0; i < main_set->count; ++i) {
         struct ly_set *iter_set = main_set->objs[i];
 
         LOGDBG(LY_LDGDEPSETS, "dep set #%" PRIu32 ":", i);
         for (uint32_t j = 0; j < iter_set->count; ++j) {
-            m = iter_set->objs[j];
+            struct lys_module *m = iter_set->objs[j];
+
             LOGDBG(LY_LDGDEPSETS, "\t%s", m->name);
         }
     }
@@ -1171,6 +1151,11 @@ lys_set_implemented(struct lys_module *mod, const char **features)
 
     LY_CHECK_ARG_RET(NULL, mod, LY_EINVAL);
 
+    if (mod->ctx->parsed_freed) {
+        LOGERR(mod->ctx, LY_EDENIED, "Unable to change module \"%s\" in a context with freed parsed modules.", mod->name);
+        return LY_EDENIED;
+    }
+
     /* implement */
     ret = _lys_set_implemented(mod, features, unres);
     LY_CHECK_GOTO(ret, cleanup);
@@ -1799,6 +1784,150 @@ lysp_add_internal_yang(struct lysp_ctx *pctx, struct lysp_module *mod)
     return LY_SUCCESS;
 }
 
+/**
+ * @brief Pre-parse thread argument.
+ */
+struct lys_preparse_arg {
+    struct ly_ctx *ctx;             /**< context of the modules */
+    uint32_t next;                  /**< index of the next module to parse in ::ly_ctx.preparsed */
+};
+
+/**
+ * @brief Thread parsing modules from ::ly_ctx.preparsed until there are none left.
+ *
+ * @param[in] arg Pre-parse thread argument.
+ * @return NULL.
+ */
+static void *
+lys_preparse_thread(void *arg)
+{
+    struct lys_preparse_arg *parg = arg;
+    struct ly_ctx *ctx = parg->ctx;
+    struct lysp_preparsed *item;
+    struct lysf_ctx fctx = {.ctx = ctx};
+    uint32_t idx, log_opts = 0;
+
+    /* any errors will be reported when parsing the module again */
+    ly_temp_log_options(&log_opts);
+
+    while ((idx = LY_ATOMIC_INC_BARRIER(parg->next)) < LY_ARRAY_COUNT(ctx->preparsed)) {
+        item = &ctx->preparsed[idx];
+        if (ly_in_new_filepath(item->path, 0, &item->in)) {
+            continue;
+        }
+
+        item->mod = calloc(1, sizeof *item->mod);
+        if (!item->mod) {
+            continue;
+        }
+        item->mod->ctx = ctx;
+
+        if (yang_parse_module(&item->pctx, item->in, item->mod)) {
+            fctx.mod = item->mod;
+            lys_module_free(&fctx, item->mod, 0);
+            lysf_ctx_erase(&fctx);
+            item->mod = NULL;
+        }
+    }
+
+    ly_temp_log_options(NULL);
+    return NULL;
+}
+
+void
+lys_preparse(struct ly_ctx *ctx)
+{
+    struct lys_preparse_arg arg = {.ctx = ctx, .next = 0};
+    pthread_t *threads;
+    uint32_t i, count;
+
+    /* use as many threads as allowed for compilation */
+    count = ctx->compile_threads ? ctx->compile_threads : ly_cpu_count();
+    if (count > LY_ARRAY_COUNT(ctx->preparsed)) {
+        count = LY_ARRAY_COUNT(ctx->preparsed);
+    }
+    if (!count) {
+        return;
+    } else if (count == 1) {
+        /* no need for another thread */
+        lys_preparse_thread(&arg);
+        return;
+    }
+
+    threads = malloc(count * sizeof *threads);
+    if (!threads) {
+        /* the modules will just be parsed when needed */
+        return;
+    }
+
+    for (i = 0; i < count; ++i) {
+        if (pthread_create(&threads[i], NULL, lys_preparse_thread, &arg)) {
+            break;
+        }
+    }
+    count = i;
+
+    for (i = 0; i < count; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+    free(threads);
+}
+
+/**
+ * @brief Take a module parsed in advance from the context, if it was parsed from the file of the current input.
+ *
+ * @param[in] ctx Context with the pre-parsed modules.
+ * @param[in] in Input handler of the module being parsed, moved after the module if found.
+ * @param[out] mod Pre-parsed module, NULL if none found.
+ * @param[out] pctx YANG parser context of @p mod.
+ */
+static void
+lys_preparsed_take(struct ly_ctx *ctx, struct ly_in *in, struct lys_module **mod, struct lysp_yang_ctx **pctx)
+{
+    struct lysp_preparsed *item;
+    LY_ARRAY_COUNT_TYPE u;
+
+    LY_ARRAY_FOR(ctx->preparsed, u) {
+        item = &ctx->preparsed[u];
+        if (!item->mod || (in->current != in->start) || strcmp(item->path, in->method.fpath.filepath)) {
+            continue;
+        }
+
+        *mod = item->mod;
+        *pctx = item->pctx;
+        item->mod = NULL;
+        item->pctx = NULL;
+
+        /* continue as if the module was parsed from the input */
+        in->current += item->in->current - item->in->start;
+        in->line = item->in->line;
+        (*pctx)->in = in;
+        return;
+    }
+}
+
+void
+lys_preparsed_free(struct ly_ctx *ctx)
+{
+    struct lysp_preparsed *item;
+    struct lysf_ctx fctx = {.ctx = ctx};
+    LY_ARRAY_COUNT_TYPE u;
+
+    LY_ARRAY_FOR(ctx->preparsed, u) {
+        item = &ctx->preparsed[u];
+        if (item->mod) {
+            fctx.mod = item->mod;
+            lys_module_free(&fctx, item->mod, 0);
+            lysf_ctx_erase(&fctx);
+        }
+        lysp_yang_ctx_free(item->pctx);
+        ly_in_free(item->in, 0);
+        free(item->path);
+    }
+    LY_ARRAY_FREE(ctx->preparsed);
+    ctx->preparsed = NULL;
+}
+
 LY_ERR
 lys_parse_in(struct ly_ctx *ctx, struct ly_in *in, LYS_INFORMAT format,
         LY_ERR (*custom_check)(const struct ly_ctx *ctx, struct lysp_module *mod, struct lysp_submodule *submod, void *data),
@@ -1818,26 +1947,40 @@ lys_parse_in(struct ly_ctx *ctx, struct ly_in *in, LYS_INFORMAT format,
         *module = NULL;
     }
 
-    mod = calloc(1, sizeof *mod);
-    LY_CHECK_ERR_RET(!mod, LOGMEM(ctx), LY_EMEM);
-    mod->ctx = ctx;
+    if (ctx->parsed_freed) {
+        LOGERR(ctx, LY_EDENIED, "Unable to add new modules into a context with freed parsed modules.");
+        return LY_EDENIED;
+    }
 
-    /* parse */
-    switch (format) {
-    case LYS_IN_YIN:
-        ret = yin_parse_module(&yinctx, in, mod);
-        pctx = (struct lysp_ctx *)yinctx;
-        break;
-    case LYS_IN_YANG:
-        ret = yang_parse_module(&yangctx, in, mod);
+    if ((format == LYS_IN_YANG) && ctx->preparsed && (in->type == LY_IN_FILEPATH)) {
+        /* use the module parsed in advance, if any */
+        lys_preparsed_take(ctx, in, &mod, &yangctx);
+    }
+
+    if (mod) {
         pctx = (struct lysp_ctx *)yangctx;
-        break;
-    default:
-        LOGERR(ctx, LY_EINVAL, "Invalid schema input format.");
-        ret = LY_EINVAL;
-        break;
+    } else {
+        mod = calloc(1, sizeof *mod);
+        LY_CHECK_ERR_RET(!mod, LOGMEM(ctx), LY_EMEM);
+        mod->ctx = ctx;
+
+        /* parse */
+        switch (format) {
+        case LYS_IN_YIN:
+            ret = yin_parse_module(&yinctx, in, mod);
+            pctx = (struct lysp_ctx *)yinctx;
+            break;
+        case LYS_IN_YANG:
+            ret = yang_parse_module(&yangctx, in, mod);
+            pctx = (struct lysp_ctx *)yangctx;
+            break;
+        default:
+            LOGERR(ctx, LY_EINVAL, "Invalid schema input format.");
+            ret = LY_EINVAL;
+            break;
+        }
+        LY_CHECK_GOTO(ret, cleanup);
     }
-    LY_CHECK_GOTO(ret, cleanup);
 
     /* make sure that the newest revision is at position 0 */
     lysp_sort_revisions(mod->parsed->revs);
@@ -2165,27 +2308,44 @@ cleanup:
     return rc;
 }
 
-LIBYANG_API_DEF LY_ERR
-lys_search_localfile(const char * const *searchpaths, ly_bool cwd, const char *name, const char *revision,
-        char **localfile, LYS_INFORMAT *format)
+/**
+ * @brief Callback for every searched directory and every (sub)module file found in it.
+ *
+ * @param[in] wd Searched directory.
+ * @param[in] fname (Sub)module file name in @p wd, NULL if @p wd is only about to be searched.
+ * @param[in] format Format of @p fname according to its suffix.
+ * @param[in] cb_data Callback data.
+ * @param[out] stop Set to stop searching.
+ * @return LY_ERR value.
+ */
+typedef LY_ERR (*lys_search_localfile_clb)(const char *wd, const char *fname, LYS_INFORMAT format, void *cb_data,
+        ly_bool *stop);
+
+/**
+ * @brief Walk all the (sub)module files in the search dirs in the search order.
+ *
+ * @param[in] searchpaths NULL-terminated array of the search dirs.
+ * @param[in] cwd Whether to search also the current working directory (not recursively).
+ * @param[in] file_clb Callback to call for every directory and file.
+ * @param[in] cb_data Callback data.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lys_search_localfile_walk(const char * const *searchpaths, ly_bool cwd, lys_search_localfile_clb file_clb, void *cb_data)
 {
     LY_ERR ret = LY_EMEM;
-    size_t len, flen, match_len = 0, dir_len;
-    ly_bool implicit_cwd = 0, skip;
+    size_t flen;
+    ly_bool implicit_cwd = 0, skip, stop = 0;
     char *wd;
     DIR *dir = NULL;
     struct dirent *file;
-    char *match_name = NULL;
-    LYS_INFORMAT format_aux, match_format = 0;
+    LYS_INFORMAT format;
     struct ly_set *dirs;
 
-    LY_CHECK_ARG_RET(NULL, localfile, LY_EINVAL);
-
     /* start to fill the dir fifo with the context's search path (if set)
      * and the current working directory */
     LY_CHECK_RET(ly_set_new(&dirs));
 
-    len = strlen(name);
     if (cwd) {
         wd = get_current_dir_name();
         if (!wd) {
@@ -2217,28 +2377,28 @@ lys_search_localfile(const char * const *searchpaths, ly_bool cwd, const char *n
         }
     }
     wd = NULL;
+    ret = LY_SUCCESS;
 
     /* start searching */
-    while (dirs->count) {
+    while (!stop && dirs->count) {
         free(wd);
 
         dirs->count--;
         wd = (char *)dirs->objs[dirs->count];
         dirs->objs[dirs->count] = NULL;
-        LOGVRB("Searching for \"%s\" in \"%s\".", name, wd);
+        LY_CHECK_GOTO(ret = file_clb(wd, NULL, LYS_IN_UNKNOWN, cb_data, &stop), cleanup);
 
         if (dir) {
             closedir(dir);
         }
         dir = opendir(wd);
-        dir_len = strlen(wd);
         if (!dir) {
             LOGWRN(NULL, "Unable to open directory \"%s\" for searching (sub)modules (%s).", wd, strerror(errno));
             continue;
         }
 
         /* search the directory */
-        while ((file = readdir(dir))) {
+        while (!stop && (file = readdir(dir))) {
             if (!strcmp(".", file->d_name) || !strcmp("..", file->d_name)) {
                 /* skip . and .. */
                 continue;
@@ -2248,93 +2408,404 @@ lys_search_localfile(const char * const *searchpaths, ly_bool cwd, const char *n
             if ((ret = lys_search_localfile_file_type(file, wd, dirs, implicit_cwd, &skip))) {
                 goto cleanup;
             }
-
-            /* here we know that the item is a file which can contain a module */
-            if (strncmp(name, file->d_name, len) || ((file->d_name[len] != '.') && (file->d_name[len] != '@'))) {
-                /* different filename than the module we search for */
+            if (skip) {
                 continue;
             }
 
             /* get type according to filename suffix */
             flen = strlen(file->d_name);
             if ((flen >= LY_YANG_SUFFIX_LEN + 1) && !strcmp(&file->d_name[flen - LY_YANG_SUFFIX_LEN], LY_YANG_SUFFIX)) {
-                format_aux = LYS_IN_YANG;
+                format = LYS_IN_YANG;
             } else if ((flen >= LY_YIN_SUFFIX_LEN + 1) && !strcmp(&file->d_name[flen - LY_YIN_SUFFIX_LEN], LY_YIN_SUFFIX)) {
-                format_aux = LYS_IN_YIN;
+                format = LYS_IN_YIN;
             } else {
                 /* not supported suffix/file format */
                 continue;
             }
 
-            if (revision) {
-                /* we look for the specific revision, try to get it from the filename */
-                if (file->d_name[len] == '@') {
-                    /* check revision from the filename */
-                    if (strncmp(revision, &file->d_name[len + 1], strlen(revision))) {
-                        /* another revision */
-                        continue;
-                    } else {
-                        /* exact revision */
-                        free(match_name);
-                        if (asprintf(&match_name, "%s/%s", wd, file->d_name) == -1) {
-                            LOGMEM(NULL);
-                            goto cleanup;
-                        }
-                        match_len = dir_len + 1 + len;
-                        match_format = format_aux;
-                        goto success;
-                    }
-                } else {
-                    /* continue trying to find exact revision match, use this only if not found */
-                    free(match_name);
-                    if (asprintf(&match_name, "%s/%s", wd, file->d_name) == -1) {
-                        LOGMEM(NULL);
-                        goto cleanup;
-                    }
-                    match_len = dir_len + 1 + len;
-                    match_format = format_aux;
-                    continue;
-                }
-            } else {
-                /* remember the revision and try to find the newest one */
-                if (match_name) {
-                    if ((file->d_name[len] != '@') ||
-                            lysp_check_date(NULL, &file->d_name[len + 1],
-                            flen - ((format_aux == LYS_IN_YANG) ? LY_YANG_SUFFIX_LEN : LY_YIN_SUFFIX_LEN) - len - 1, NULL)) {
-                        continue;
-                    } else if ((match_name[match_len] == '@') &&
-                            (strncmp(&match_name[match_len + 1], &file->d_name[len + 1], LY_REV_SIZE - 1) >= 0)) {
-                        continue;
-                    }
-                    free(match_name);
-                }
-
-                if (asprintf(&match_name, "%s/%s", wd, file->d_name) == -1) {
-                    LOGMEM(NULL);
-                    goto cleanup;
-                }
-                match_len = dir_len + 1 + len;
-                match_format = format_aux;
-                continue;
-            }
+            LY_CHECK_GOTO(ret = file_clb(wd, file->d_name, format, cb_data, &stop), cleanup);
         }
     }
 
-success:
-    (*localfile) = match_name;
-    match_name = NULL;
-    if (format) {
-        (*format) = match_format;
-    }
-    ret = LY_SUCCESS;
-
 cleanup:
     free(wd);
     if (dir) {
         closedir(dir);
     }
-    free(match_name);
     ly_set_free(dirs, free);
+    return ret;
+}
+
+/**
+ * @brief Searched (sub)module file match.
+ */
+struct lys_search_localfile_match {
+    const char *name;               /**< searched (sub)module name */
+    size_t len;                     /**< length of @p name */
+    const char *revision;           /**< searched (sub)module revision, if any */
+
+    char *match_name;               /**< path of the best matching file found so far */
+    size_t match_len;               /**< length of the path of @p match_name up to the end of the (sub)module name */
+    LYS_INFORMAT match_format;      /**< format of @p match_name */
+};
+
+/**
+ * @brief Check a (sub)module file named after the searched (sub)module and remember it if it is a better match.
+ *
+ * @param[in,out] match Searched (sub)module with the best match so far.
+ * @param[in] wd Directory of the file.
+ * @param[in] dir_len Length of @p wd.
+ * @param[in] fname File name.
+ * @param[in] format Format of the file.
+ * @param[out] exact Set if the file is an exact revision match and no other files need to be checked.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lys_search_localfile_match_file(struct lys_search_localfile_match *match, const char *wd, size_t dir_len,
+        const char *fname, LYS_INFORMAT format, ly_bool *exact)
+{
+    size_t len = match->len, flen;
+
+    if (match->revision) {
+        /* we look for the specific revision, try to get it from the filename */
+        if (fname[len] == '@') {
+            /* check revision from the filename */
+            if (strncmp(match->revision, &fname[len + 1], strlen(match->revision))) {
+                /* another revision */
+                return LY_SUCCESS;
+            }
+
+            /* exact revision */
+            *exact = 1;
+        }
+        /* else continue trying to find exact revision match, use this only if not found */
+    } else if (match->match_name) {
+        /* remember the revision and try to find the newest one */
+        flen = strlen(fname);
+        if ((fname[len] != '@') ||
+                lysp_check_date(NULL, &fname[len + 1],
+                flen - ((format == LYS_IN_YANG) ? LY_YANG_SUFFIX_LEN : LY_YIN_SUFFIX_LEN) - len - 1, NULL)) {
+            return LY_SUCCESS;
+        } else if ((match->match_name[match->match_len] == '@') &&
+                (strncmp(&match->match_name[match->match_len + 1], &fname[len + 1], LY_REV_SIZE - 1) >= 0)) {
+            return LY_SUCCESS;
+        }
+    }
+
+    free(match->match_name);
+    if (asprintf(&match->match_name, "%.*s/%s", (int)dir_len, wd, fname) == -1) {
+        match->match_name = NULL;
+        LOGMEM(NULL);
+        return LY_EMEM;
+    }
+    match->match_len = dir_len + 1 + len;
+    match->match_format = format;
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Search callback checking the files named after the searched (sub)module.
+ *
+ * Implementation of ::lys_search_localfile_clb.
+ */
+static LY_ERR
+lys_search_localfile_match_clb(const char *wd, const char *fname, LYS_INFORMAT format, void *cb_data, ly_bool *stop)
+{
+    struct lys_search_localfile_match *match = cb_data;
+
+    if (!fname) {
+        LOGVRB("Searching for \"%s\" in \"%s\".", match->name, wd);
+        return LY_SUCCESS;
+    }
+
+    if (strncmp(match->name, fname, match->len) || ((fname[match->len] != '.') && (fname[match->len] != '@'))) {
+        /* different filename than the module we search for */
+        return LY_SUCCESS;
+    }
+
+    return lys_search_localfile_match_file(match, wd, strlen(wd), fname, format, stop);
+}
+
+LIBYANG_API_DEF LY_ERR
+lys_search_localfile(const char * const *searchpaths, ly_bool cwd, const char *name, const char *revision,
+        char **localfile, LYS_INFORMAT *format)
+{
+    LY_ERR ret;
+    struct lys_search_localfile_match match = {0};
+
+    LY_CHECK_ARG_RET(NULL, localfile, LY_EINVAL);
+
+    match.name = name;
+    match.len = strlen(name);
+    match.revision = revision;
+    ret = lys_search_localfile_walk(searchpaths, cwd, lys_search_localfile_match_clb, &match);
+    if (ret) {
+        free(match.match_name);
+        return ret;
+    }
+
+    *localfile = match.match_name;
+    if (format) {
+        *format = match.match_format;
+    }
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Hash table record of a (sub)module name in the search dirs index.
+ */
+struct lys_search_index_rec {
+    const char *name;               /**< (sub)module name, not terminated, points into a file path */
+    size_t name_len;                /**< length of @p name */
+    uint32_t *files;                /**< sized array of indexes of all the files for this name in ::lys_search_index.files */
+};
+
+/**
+ * @brief Hash table value equal callback of the search dirs index.
+ */
+static ly_bool
+lys_search_index_equal_cb(void *val1_p, void *val2_p, ly_bool UNUSED(mod), void *UNUSED(cb_data))
+{
+    struct lys_search_index_rec *rec1 = val1_p, *rec2 = val2_p;
+
+    return (rec1->name_len == rec2->name_len) && !strncmp(rec1->name, rec2->name, rec1->name_len);
+}
+
+/**
+ * @brief Hash table value free callback of the search dirs index.
+ */
+static void
+lys_search_index_rec_free(void *val_p)
+{
+    struct lys_search_index_rec *rec = val_p;
+
+    LY_ARRAY_FREE(rec->files);
+}
+
+void
+lys_search_index_free(struct ly_ctx *ctx)
+{
+    struct lys_search_index *index = ctx->search_index;
+    LY_ARRAY_COUNT_TYPE u;
+
+    if (!index) {
+        return;
+    }
+
+    free(index->cwd);
+    LY_ARRAY_FOR(index->dirs, u) {
+        free(index->dirs[u].path);
+    }
+    LY_ARRAY_FREE(index->dirs);
+    LY_ARRAY_FOR(index->files, u) {
+        free(index->files[u].path);
+    }
+    LY_ARRAY_FREE(index->files);
+    lyht_free(index->names, lys_search_index_rec_free);
+    free(index);
+
+    ctx->search_index = NULL;
+}
+
+/**
+ * @brief Get modification time of a directory.
+ *
+ * @param[in] path Directory path.
+ * @return Modification time, -1 if it cannot be learned.
+ */
+static time_t
+lys_search_index_mtime(const char *path)
+{
+    struct stat st;
 
+    if (stat(path, &st)) {
+        return -1;
+    }
+    return st.st_mtime;
+}
+
+/**
+ * @brief Add a name of a file into the search dirs index.
+ *
+ * @param[in] index Search dirs index.
+ * @param[in] name Name to add, points into the file path.
+ * @param[in] name_len Length of @p name.
+ * @param[in] file_idx Index of the file.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lys_search_index_add_name(struct lys_search_index *index, const char *name, size_t name_len, uint32_t file_idx)
+{
+    struct lys_search_index_rec rec = {0}, *match;
+    uint32_t hash, *idx_p;
+
+    rec.name = name;
+    rec.name_len = name_len;
+    hash = lyht_hash(name, name_len);
+    if (lyht_find(index->names, &rec, hash, (void **)&match)) {
+        LY_CHECK_RET(lyht_insert(index->names, &rec, hash, (void **)&match));
+    }
+
+    LY_ARRAY_NEW_RET(NULL, match->files, idx_p, LY_EMEM);
+    *idx_p = file_idx;
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Search callback adding all the directories and files into the search dirs index.
+ *
+ * Implementation of ::lys_search_localfile_clb.
+ */
+static LY_ERR
+lys_search_index_clb(const char *wd, const char *fname, LYS_INFORMAT format, void *cb_data, ly_bool *UNUSED(stop))
+{
+    struct lys_search_index *index = cb_data;
+    struct lys_search_index_dir *dir;
+    struct lys_search_index_file *file;
+    const char *ptr;
+    size_t dir_len;
+
+    if (!fname) {
+        /* remember the directory state before reading it */
+        LY_ARRAY_NEW_RET(NULL, index->dirs, dir, LY_EMEM);
+        dir->path = strdup(wd);
+        LY_CHECK_ERR_RET(!dir->path, LOGMEM(NULL), LY_EMEM);
+        dir->mtime = lys_search_index_mtime(wd);
+        return LY_SUCCESS;
+    }
+
+    LY_ARRAY_NEW_RET(NULL, index->files, file, LY_EMEM);
+    dir_len = strlen(wd);
+    if (asprintf(&file->path, "%s/%s", wd, fname) == -1) {
+        file->path = NULL;
+        LOGMEM(NULL);
+        return LY_EMEM;
+    }
+    file->dir_len = dir_len;
+    file->format = format;
+
+    /* the file is a match for every name followed by '.' or '@' */
+    fname = file->path + dir_len + 1;
+    for (ptr = fname + 1; *ptr; ++ptr) {
+        if ((*ptr == '.') || (*ptr == '@')) {
+            LY_CHECK_RET(lys_search_index_add_name(index, fname, ptr - fname, LY_ARRAY_COUNT(index->files) - 1));
+        }
+    }
+
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Check whether the search dirs index of a context is still valid.
+ *
+ * @param[in] ctx Context with the index.
+ * @param[in] cwd Current working directory to search, if any.
+ * @return Whether the index can be used.
+ */
+static ly_bool
+lys_search_index_is_valid(const struct ly_ctx *ctx, const char *cwd)
+{
+    struct lys_search_index *index = ctx->search_index;
+    LY_ARRAY_COUNT_TYPE u;
+    time_t mtime;
+
+    if (!index) {
+        return 0;
+    }
+
+    if ((!cwd != !index->cwd) || (cwd && strcmp(cwd, index->cwd))) {
+        /* different working directory */
+        return 0;
+    }
+
+    LY_ARRAY_FOR(index->dirs, u) {
+        mtime = lys_search_index_mtime(index->dirs[u].path);
+        if (mtime != index->dirs[u].mtime) {
+            /* directory modified */
+            return 0;
+        }
+        if ((mtime != -1) && (mtime >= index->built)) {
+            /* directory may have been modified in the same second it was indexed */
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+LY_ERR
+lys_search_localfile_ctx(struct ly_ctx *ctx, const char *name, const char *revision, char **localfile,
+        LYS_INFORMAT *format)
+{
+    LY_ERR ret = LY_SUCCESS;
+    struct lys_search_index *index;
+    struct lys_search_index_rec rec = {0}, *match_rec;
+    struct lys_search_index_file *file;
+    struct lys_search_localfile_match match = {0};
+    LY_ARRAY_COUNT_TYPE u;
+    ly_bool exact = 0;
+    char *cwd = NULL;
+
+    *localfile = NULL;
+
+    if (!(ctx->flags & LY_CTX_DISABLE_SEARCHDIR_CWD)) {
+        cwd = get_current_dir_name();
+        LY_CHECK_ERR_RET(!cwd, LOGMEM(ctx), LY_EMEM);
+    }
+
+    if (!lys_search_index_is_valid(ctx, cwd)) {
+        /* (re)build the index */
+        lys_search_index_free(ctx);
+        index = calloc(1, sizeof *index);
+        LY_CHECK_ERR_GOTO(!index, LOGMEM(ctx); ret = LY_EMEM, cleanup);
+        ctx->search_index = index;
+
+        index->cwd = cwd;
+        cwd = NULL;
+        index->built = time(NULL);
+        index->names = lyht_new(LYHT_MIN_SIZE, sizeof(struct lys_search_index_rec), lys_search_index_equal_cb, NULL, 1);
+        LY_CHECK_ERR_GOTO(!index->names, LOGMEM(ctx); ret = LY_EMEM, cleanup);
+
+        LOGVRB("Indexing (sub)modules in the search dirs.");
+        ret = lys_search_localfile_walk(ly_ctx_get_searchdirs(ctx), index->cwd ? 1 : 0, lys_search_index_clb, index);
+        LY_CHECK_GOTO(ret, cleanup);
+    }
+    index = ctx->search_index;
+
+    /* find all the files for the name */
+    rec.name = name;
+    rec.name_len = strlen(name);
+    if (lyht_find(index->names, &rec, lyht_hash(name, rec.name_len), (void **)&match_rec)) {
+        /* no files */
+        goto cleanup;
+    }
+
+    /* choose the best match as if searching the directories */
+    match.name = name;
+    match.len = rec.name_len;
+    match.revision = revision;
+    LY_ARRAY_FOR(match_rec->files, u) {
+        file = &index->files[match_rec->files[u]];
+        ret = lys_search_localfile_match_file(&match, file->path, file->dir_len, file->path + file->dir_len + 1,
+                file->format, &exact);
+        LY_CHECK_GOTO(ret, cleanup);
+        if (exact) {
+            break;
+        }
+    }
+
+    *localfile = match.match_name;
+    match.match_name = NULL;
+    if (format) {
+        *format = match.match_format;
+    }
+
+cleanup:
+    if (ret) {
+        /* build the index again next time */
+        lys_search_index_free(ctx);
+    }
+    free(match.match_name);
+    free(cwd);
     return ret;
 }
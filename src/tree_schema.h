@@ -639,6 +639,8 @@ struct lysp_deviation {
  *      14 LYS_IS_OUTPUT    |x|x|x|x|x|x|x| | | | | | | |
  *                          +-+-+-+-+-+-+-+-+-+-+-+-+-+-+
  *      15 LYS_IS_NOTIF     |x|x|x|x|x|x|x| | | | | | | |
+ *                          +-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ *      16 LYS_INDEXED      | | |x| |x| | | | | | | | | |
  *     ---------------------+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
  *
  */
@@ -725,6 +727,9 @@ struct lysp_deviation {
 
 #define LYS_IS_NOTIF     0x4000      /**< flag for nodes that are in the subtree of a notification statement */
 
+#define LYS_INDEXED      0x8000      /**< flag for leafs with a secondary index of their list instances and for such lists,
+                                          see ::ly_ctx_set_index() */
+
 #define LYS_FLAGS_COMPILED_MASK 0xff /**< mask for flags that maps to the compiled structures */
 /** @} snodeflags */
 
@@ -1218,6 +1223,10 @@ struct lysc_ident {
                                           It also contains references to identities located in unimplemented modules. */
     struct lysc_ext_instance *exts;  /**< list of the extension instances ([sized array](@ref sizedarrays)) */
     uint16_t flags;                  /**< [schema node flags](@ref snodeflags) - only LYS_STATUS_ values are allowed */
+    uint32_t index;                  /**< unique index of the identity in its context */
+    uint32_t *ancestors;             /**< sorted ::lysc_ident.index of all the (transitive) base identities
+                                          ([sized array](@ref sizedarrays)), allows deciding whether an identity is
+                                          derived from another without walking the derived identities */
 };
 
 /**
@@ -2139,6 +2148,8 @@ struct lys_module {
     ly_bool to_compile;              /**< flag marking a module that was changed but not (re)compiled, see
                                           ::LY_CTX_EXPLICIT_COMPILE. */
     uint8_t latest_revision;         /**< Flag to mark the latest available revision, see [latest_revision options](@ref latestrevflags). */
+    ly_bool disabled_nodes;          /**< internal flag marking a module whose compiled tree had some nodes disabled by
+                                          their if-features in the last compilation */
 };
 
 /**
@@ -153,14 +153,7 @@ lysp_check_enum_name(struct lysp_ctx *ctx, const char *name, size_t name_len)
     return LY_SUCCESS;
 }
 
-/**
- * @brief Learn built-in type from its name.
- *
- * @param[in] name Type name.
- * @param[in] len Length of @p name.
- * @return Built-in data type, ::LY_TYPE_UNKNOWN if none matches.
- */
-static LY_DATA_TYPE
+LY_DATA_TYPE
 lysp_type_str2builtin(const char *name, size_t len)
 {
     if (len >= 4) { /* otherwise it does not match any built-in type */
@@ -773,8 +766,7 @@ lys_parse_localfile(struct ly_ctx *ctx, const char *name, const char *revision,
     LY_ERR ret = LY_SUCCESS;
     struct lysp_load_module_check_data check_data = {0};
 
-    LY_CHECK_RET(lys_search_localfile(ly_ctx_get_searchdirs(ctx), !(ctx->flags & LY_CTX_DISABLE_SEARCHDIR_CWD), name,
-            revision, &filepath, &format));
+    LY_CHECK_RET(lys_search_localfile_ctx(ctx, name, revision, &filepath, &format));
     if (!filepath) {
         if (required) {
             LOGERR(ctx, LY_ENOTFOUND, "Data model \"%s%s%s\" not found in local searchdirs.", name, revision ? "@" : "",
@@ -2210,6 +2202,81 @@ lysc_data_node(const struct lysc_node *schema)
     return parent;
 }
 
+/**
+ * @brief Record of the cache of schema nodes whose data descendants may match a node test.
+ */
+struct lysc_desc_rec {
+    const struct lysc_node *schema; /**< Schema node, key of the record. */
+    ly_bool possible;               /**< Whether any data descendant of a @p schema data node may match. */
+};
+
+/**
+ * @brief Hash table value-equal callback for comparing descendant cache records.
+ */
+static ly_bool
+lysc_desc_equal_cb(void *val1_p, void *val2_p, ly_bool UNUSED(mod), void *UNUSED(cb_data))
+{
+    struct lysc_desc_rec *rec1 = val1_p, *rec2 = val2_p;
+
+    return rec1->schema == rec2->schema;
+}
+
+ly_bool
+lysc_node_desc_possible(const struct lysc_node *schema, const struct lys_module *mod, const char *name,
+        struct ly_ht **cache)
+{
+    struct lysc_desc_rec rec = {.schema = schema}, *match;
+    const struct lysc_node *children[4], *child;
+    LY_ARRAY_COUNT_TYPE u;
+    uint32_t hash, i;
+
+    hash = lyht_hash((const char *)&schema, sizeof schema);
+    if (*cache && !lyht_find(*cache, &rec, hash, (void **)&match)) {
+        return match->possible;
+    }
+
+    /* nested extension instance data can be of any schema */
+    LY_ARRAY_FOR(schema->exts, u) {
+        if (schema->exts[u].def->plugin && schema->exts[u].def->plugin->snode) {
+            rec.possible = 1;
+            goto cache;
+        }
+    }
+
+    /* all the schema children, including operation input and output, actions, and notifications */
+    if (schema->nodetype & (LYS_RPC | LYS_ACTION)) {
+        children[0] = ((struct lysc_node_action *)schema)->input.child;
+        children[1] = ((struct lysc_node_action *)schema)->output.child;
+    } else {
+        children[0] = lysc_node_child(schema);
+        children[1] = NULL;
+    }
+    children[2] = (const struct lysc_node *)lysc_node_actions(schema);
+    children[3] = (const struct lysc_node *)lysc_node_notifs(schema);
+
+    for (i = 0; (i < 4) && !rec.possible; ++i) {
+        for (child = children[i]; child && !rec.possible; child = child->next) {
+            if (!(child->nodetype & (LYS_CHOICE | LYS_CASE)) && (!mod || (child->module == mod)) &&
+                    (!name || (child->name == name))) {
+                /* matching data node */
+                rec.possible = 1;
+            } else {
+                rec.possible = lysc_node_desc_possible(child, mod, name, cache);
+            }
+        }
+    }
+
+cache:
+    if (!*cache) {
+        *cache = lyht_new(LYHT_MIN_SIZE, sizeof rec, lysc_desc_equal_cb, NULL, 1);
+    }
+    if (*cache) {
+        /* failing to cache the result only makes the following checks slower */
+        lyht_insert(*cache, &rec, hash, NULL);
+    }
+    return rec.possible;
+}
+
 ly_bool
 lys_has_recompiled(const struct lys_module *mod)
 {
@@ -608,6 +608,46 @@ lysp_node_free(struct lysf_ctx *ctx, struct lysp_node *node)
     free(node);
 }
 
+void
+lysp_module_free_stmts(struct lysf_ctx *ctx, struct lysp_module *module)
+{
+    struct lysp_node *node, *next;
+    LY_ARRAY_COUNT_TYPE u;
+
+    if (!module) {
+        return;
+    }
+
+    LY_ARRAY_FOR(module->includes, u) {
+        lysp_module_free_stmts(ctx, (struct lysp_module *)module->includes[u].submodule);
+    }
+
+    FREE_ARRAY(ctx, module->typedefs, lysp_tpdf_free);
+    module->typedefs = NULL;
+    LY_LIST_FOR_SAFE((struct lysp_node *)module->groupings, next, node) {
+        lysp_node_free(ctx, node);
+    }
+    module->groupings = NULL;
+    LY_LIST_FOR_SAFE(module->data, next, node) {
+        lysp_node_free(ctx, node);
+    }
+    module->data = NULL;
+    LY_LIST_FOR_SAFE((struct lysp_node *)module->augments, next, node) {
+        lysp_node_free(ctx, node);
+    }
+    module->augments = NULL;
+    LY_LIST_FOR_SAFE((struct lysp_node *)module->rpcs, next, node) {
+        lysp_node_free(ctx, node);
+    }
+    module->rpcs = NULL;
+    LY_LIST_FOR_SAFE((struct lysp_node *)module->notifs, next, node) {
+        lysp_node_free(ctx, node);
+    }
+    module->notifs = NULL;
+    FREE_ARRAY(ctx, module->deviations, lysp_deviation_free);
+    module->deviations = NULL;
+}
+
 void
 lysp_module_free(struct lysf_ctx *ctx, struct lysp_module *module)
 {
@@ -820,6 +860,7 @@ lysc_ident_free(struct lysf_ctx *ctx, struct lysc_ident *ident)
     lydict_remove(ctx->ctx, ident->dsc);
     lydict_remove(ctx->ctx, ident->ref);
     LY_ARRAY_FREE(ident->derived);
+    LY_ARRAY_FREE(ident->ancestors);
     FREE_ARRAY(ctx, ident->exts, lysc_ext_instance_free);
 }
 
@@ -844,7 +885,16 @@ lysc_range_free(struct lysf_ctx *ctx, struct lysc_range *range)
 void
 lysc_pattern_free(struct lysf_ctx *ctx, struct lysc_pattern **pattern)
 {
-    if (--(*pattern)->refcount) {
+    uint32_t refcount;
+
+    /* patterns are shared with the types derived from a typedef, which may be compiled in parallel */
+    /* LOCK */
+    pthread_mutex_lock(&ctx->ctx->compile_lock);
+    refcount = --(*pattern)->refcount;
+    /* UNLOCK */
+    pthread_mutex_unlock(&ctx->ctx->compile_lock);
+
+    if (refcount) {
         return;
     }
     pcre2_code_free((*pattern)->code);
@@ -108,6 +108,16 @@ void lysp_deviation_free(struct lysf_ctx *ctx, struct lysp_deviation *dev);
  */
 void lysp_node_free(struct lysf_ctx *ctx, struct lysp_node *node);
 
+/**
+ * @brief Free the parsed statements of a module and its submodules that are not needed once it is compiled.
+ *
+ * Kept are the module header, linkage, revisions, extensions, features, and identities.
+ *
+ * @param[in] ctx Free context.
+ * @param[in] module Parsed YANG schema tree structure to free the statements of.
+ */
+void lysp_module_free_stmts(struct lysf_ctx *ctx, struct lysp_module *module);
+
 /**
  * @brief Free the parsed YANG schema tree structure. Works for both modules and submodules.
  *
@@ -16,6 +16,7 @@
 #define LY_TREE_SCHEMA_INTERNAL_H_
 
 #include <stdint.h>
+#include <time.h>
 
 #include "ly_common.h"
 #include "set.h"
@@ -227,6 +228,15 @@ LY_ERR lysp_check_prefix(struct lysp_ctx *ctx, struct lysp_import *imports, cons
  */
 LY_ERR lysp_check_date(struct lysp_ctx *ctx, const char *date, size_t date_len, const char *stmt);
 
+/**
+ * @brief Learn built-in type from its name.
+ *
+ * @param[in] name Type name.
+ * @param[in] len Length of @p name.
+ * @return Built-in data type, ::LY_TYPE_UNKNOWN if none matches.
+ */
+LY_DATA_TYPE lysp_type_str2builtin(const char *name, size_t len);
+
 /**
  * @brief Find type specified type definition.
  *
@@ -531,6 +541,84 @@ void lys_unres_glob_erase(struct lys_glob_unres *unres);
 typedef LY_ERR (*lys_custom_check)(const struct ly_ctx *ctx, struct lysp_module *mod, struct lysp_submodule *submod,
         void *check_data);
 
+/**
+ * @brief Module parsed in advance, before being parsed into a context by ::lys_parse_in().
+ */
+struct lysp_preparsed {
+    char *path;                     /**< path to the YANG file of the module */
+    struct lys_module *mod;         /**< parsed module, NULL if parsing failed or it was already used */
+    struct lysp_yang_ctx *pctx;     /**< YANG parser context of @p mod */
+    struct ly_in *in;               /**< input handler used for parsing @p path */
+};
+
+/**
+ * @brief Parse all the modules in ::ly_ctx.preparsed in parallel, using at most ::ly_ctx.compile_threads threads.
+ *
+ * The modules are only parsed, they are added into the context when their file is parsed by ::lys_parse_in(). Modules failing to be parsed are skipped so that the errors are reported then.
+ * The context must not be modified by other threads while parsing.
+ *
+ * @param[in] ctx Context with the modules to parse.
+ */
+void lys_preparse(struct ly_ctx *ctx);
+
+/**
+ * @brief Free all the modules in ::ly_ctx.preparsed, including those not used.
+ *
+ * @param[in] ctx Context with the pre-parsed modules.
+ */
+void lys_preparsed_free(struct ly_ctx *ctx);
+
+/**
+ * @brief Search dir of the search dirs index.
+ */
+struct lys_search_index_dir {
+    char *path;                     /**< directory path */
+    time_t mtime;                   /**< modification time of the directory when it was indexed, -1 if unknown */
+};
+
+/**
+ * @brief (Sub)module file of the search dirs index.
+ */
+struct lys_search_index_file {
+    char *path;                     /**< file path */
+    size_t dir_len;                 /**< length of the directory part of @p path */
+    LYS_INFORMAT format;            /**< format of the file according to its suffix */
+};
+
+/**
+ * @brief Index of all the (sub)module files in the search dirs of a context.
+ */
+struct lys_search_index {
+    char *cwd;                      /**< indexed current working directory, NULL if it is not searched */
+    time_t built;                   /**< time when the index was created */
+    struct lys_search_index_dir *dirs;   /**< sized array of all the indexed directories */
+    struct lys_search_index_file *files; /**< sized array of all the indexed files in the search order */
+    struct ly_ht *names;            /**< hash table of all the (sub)module names with their files */
+};
+
+/**
+ * @brief Search for the (sub)module file in the search dirs of a context, same as ::lys_search_localfile().
+ *
+ * The search dirs are indexed once and the index is used for all the following searches until it is
+ * invalidated by a change of the search dirs or a modification of any indexed directory.
+ *
+ * @param[in] ctx Context with the search dirs and their index.
+ * @param[in] name Name of the (sub)module to find.
+ * @param[in] revision Optional revision of the (sub)module to find.
+ * @param[out] localfile Path of the found file, NULL if not found.
+ * @param[out] format Optional format of the found file.
+ * @return LY_ERR value.
+ */
+LY_ERR lys_search_localfile_ctx(struct ly_ctx *ctx, const char *name, const char *revision, char **localfile,
+        LYS_INFORMAT *format);
+
+/**
+ * @brief Free the search dirs index of a context.
+ *
+ * @param[in] ctx Context with the index.
+ */
+void lys_search_index_free(struct ly_ctx *ctx);
+
 /**
  * @brief Parse a module and add it into the context.
  *
@@ -654,6 +742,18 @@ const struct lys_module *ly_resolve_prefix(const struct ly_ctx *ctx, const void
 #define LYSP_HAS_RECOMPILED(PMOD) \
         (PMOD->data || PMOD->rpcs || PMOD->notifs || PMOD->exts)
 
+/**
+ * @brief Check whether a data node of a schema node can have a descendant matching a node test.
+ *
+ * @param[in] schema Schema node to check.
+ * @param[in] mod Module of the matching nodes, NULL for any.
+ * @param[in] name Name of the matching nodes in the dictionary, NULL for any.
+ * @param[in,out] cache Cache of the results, is created if NULL and its creation does not fail.
+ * @return Whether a matching descendant may exist.
+ */
+ly_bool lysc_node_desc_possible(const struct lysc_node *schema, const struct lys_module *mod, const char *name,
+        struct ly_ht **cache);
+
 /**
  * @brief Learn whether the module has statements that need to be recompiled or not.
  *
@@ -1287,37 +1287,43 @@ lyxml_ctx_restore(struct lyxml_ctx *xmlctx, struct lyxml_ctx *backup)
 }
 
 LY_ERR
-lyxml_dump_text(struct ly_out *out, const char *text, ly_bool attribute)
+lyxml_dump_text(struct ly_out *out, const char *text, ly_bool attribute, ly_bool ref)
 {
-    LY_ERR ret;
+    const char *entity;
+    size_t len;
 
     if (!text) {
         return 0;
     }
 
-    for (uint64_t u = 0; text[u]; u++) {
-        switch (text[u]) {
+    for ( ; *text; ++text) {
+        /* print the run of characters not needing to be replaced at once */
+        len = strcspn(text, attribute ? "&<>\"" : "&<>");
+        if (len) {
+            LY_CHECK_RET(ref ? ly_write_ref_(out, text, len) : ly_write_(out, text, len));
+            text += len;
+            if (!*text) {
+                break;
+            }
+        }
+
+        switch (*text) {
         case '&':
-            ret = ly_print_(out, "&amp;");
+            entity = "&amp;";
             break;
         case '<':
-            ret = ly_print_(out, "&lt;");
+            entity = "&lt;";
             break;
         case '>':
             /* not needed, just for readability */
-            ret = ly_print_(out, "&gt;");
+            entity = "&gt;";
             break;
-        case '"':
-            if (attribute) {
-                ret = ly_print_(out, "&quot;");
-                break;
-            }
-        /* fall through */
         default:
-            ret = ly_write_(out, &text[u], 1);
+            assert(attribute && (*text == '"'));
+            entity = "&quot;";
             break;
         }
-        LY_CHECK_RET(ret);
+        LY_CHECK_RET(ly_write_(out, entity, strlen(entity)));
     }
 
     return LY_SUCCESS;
@@ -161,9 +161,10 @@ const struct lyxml_ns *lyxml_ns_get(const struct ly_set *ns_set, const char *pre
  * @param[in] out Output structure for printing.
  * @param[in] text String to print.
  * @param[in] attribute Flag for attribute's value where a double quotes must be replaced.
+ * @param[in] ref Flag that @p text stays unchanged until the output is flushed, so that it does not have to be copied.
  * @return LY_ERR values.
  */
-LY_ERR lyxml_dump_text(struct ly_out *out, const char *text, ly_bool attribute);
+LY_ERR lyxml_dump_text(struct ly_out *out, const char *text, ly_bool attribute, ly_bool ref);
 
 /**
  * @brief Remove the allocated working memory of the context.
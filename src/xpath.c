@@ -722,6 +722,260 @@ set_values_equal_cb(void *val1_p, void *val2_p, ly_bool UNUSED(mod), void *UNUSE
     return 0;
 }
 
+/**
+ * @brief Prepare an empty set pool.
+ *
+ * @param[out] pool Pool to initialize.
+ */
+static void
+set_pool_init(struct lyxp_set_pool *pool)
+{
+    uint32_t i;
+
+    for (i = 0; i < LYXP_SET_POOL_BLOCKS; ++i) {
+        pool->free_blocks[i] = LYXP_SET_POOL_BLOCKS - i - 1;
+    }
+    pool->free_block_count = LYXP_SET_POOL_BLOCKS;
+    pool->array_count = 0;
+    pool->ht_count = 0;
+    pool->set_count = 0;
+}
+
+/**
+ * @brief Free all the memory kept in a set pool.
+ *
+ * @param[in] pool Pool to clear.
+ */
+static void
+set_pool_clear(struct lyxp_set_pool *pool)
+{
+    uint32_t i;
+
+    for (i = 0; i < pool->array_count; ++i) {
+        free(pool->arrays[i].nodes);
+    }
+    pool->array_count = 0;
+
+    for (i = 0; i < pool->ht_count; ++i) {
+        lyht_free(pool->hts[i], NULL);
+    }
+    pool->ht_count = 0;
+
+    for (i = 0; i < pool->set_count; ++i) {
+        free(pool->sets[i]);
+    }
+    pool->set_count = 0;
+}
+
+/**
+ * @brief Check whether a node array is one of the blocks stored in a set pool.
+ *
+ * @param[in] pool Set pool, may be NULL.
+ * @param[in] nodes Node array to check.
+ * @return Whether @p nodes is a pool block.
+ */
+static ly_bool
+set_nodes_is_block(const struct lyxp_set_pool *pool, const struct lyxp_set_node *nodes)
+{
+    if (!pool) {
+        return 0;
+    }
+
+    return (nodes >= pool->blocks[0]) && (nodes < (const struct lyxp_set_node *)(pool->blocks + LYXP_SET_POOL_BLOCKS));
+}
+
+/**
+ * @brief Get a new node array for a set that has none, from its pool if possible.
+ *
+ * @param[in] set Set to use.
+ * @param[in] size Minimal size of the node array.
+ * @return LY_ERR
+ */
+static LY_ERR
+set_nodes_alloc(struct lyxp_set *set, uint32_t size)
+{
+    struct lyxp_set_pool *pool = set->pool;
+    uint32_t i;
+
+    if (pool) {
+        if ((size <= LYXP_SET_SIZE_START) && pool->free_block_count) {
+            /* small array, use a pool block */
+            --pool->free_block_count;
+            set->val.nodes = pool->blocks[pool->free_blocks[pool->free_block_count]];
+            set->size = LYXP_SET_SIZE_START;
+            return LY_SUCCESS;
+        }
+
+        for (i = 0; i < pool->array_count; ++i) {
+            if (pool->arrays[i].size >= size) {
+                /* reuse a released array */
+                set->val.nodes = pool->arrays[i].nodes;
+                set->size = pool->arrays[i].size;
+
+                --pool->array_count;
+                pool->arrays[i] = pool->arrays[pool->array_count];
+                return LY_SUCCESS;
+            }
+        }
+    }
+
+    set->val.nodes = malloc(size * sizeof *set->val.nodes);
+    LY_CHECK_ERR_RET(!set->val.nodes, LOGMEM(set->ctx), LY_EMEM);
+    set->size = size;
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Release the node array of a set, into its pool if possible.
+ *
+ * @param[in] set Set to use.
+ */
+static void
+set_nodes_free(struct lyxp_set *set)
+{
+    struct lyxp_set_pool *pool = set->pool;
+
+    if (!set->val.nodes) {
+        return;
+    }
+
+    if (set_nodes_is_block(pool, set->val.nodes)) {
+        /* return the block */
+        pool->free_blocks[pool->free_block_count] = (set->val.nodes - pool->blocks[0]) / LYXP_SET_SIZE_START;
+        ++pool->free_block_count;
+    } else if (pool && (pool->array_count < LYXP_SET_POOL_CACHE)) {
+        /* keep the array for reuse */
+        pool->arrays[pool->array_count].nodes = set->val.nodes;
+        pool->arrays[pool->array_count].size = set->size;
+        ++pool->array_count;
+    } else {
+        free(set->val.nodes);
+    }
+}
+
+/**
+ * @brief Move the node array of a set out of its pool so that the set can outlive it.
+ *
+ * @param[in] set Set to detach, its pool is not used on success.
+ * @return LY_ERR
+ */
+static LY_ERR
+set_pool_detach(struct lyxp_set *set)
+{
+    struct lyxp_set_node *nodes;
+
+    if ((set->type == LYXP_SET_NODE_SET) && set_nodes_is_block(set->pool, set->val.nodes)) {
+        nodes = malloc(set->size * sizeof *nodes);
+        LY_CHECK_ERR_RET(!nodes, LOGMEM(set->ctx), LY_EMEM);
+        memcpy(nodes, set->val.nodes, set->used * sizeof *nodes);
+        set->val.nodes = nodes;
+    }
+
+    set->pool = NULL;
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Enlarge the node array of a set, keeping its nodes.
+ *
+ * @param[in] set Set to use.
+ * @param[in] size New size of the node array.
+ * @return LY_ERR
+ */
+static LY_ERR
+set_nodes_realloc(struct lyxp_set *set, uint32_t size)
+{
+    struct lyxp_set_pool *pool = set->pool;
+    struct lyxp_set_node *nodes;
+
+    assert(size > set->size);
+
+    if (set_nodes_is_block(pool, set->val.nodes)) {
+        /* move the nodes out of the pool block */
+        nodes = set->val.nodes;
+        LY_CHECK_RET(set_nodes_alloc(set, size));
+        memcpy(set->val.nodes, nodes, set->used * sizeof *nodes);
+
+        /* return the block */
+        pool->free_blocks[pool->free_block_count] = (nodes - pool->blocks[0]) / LYXP_SET_SIZE_START;
+        ++pool->free_block_count;
+        return LY_SUCCESS;
+    }
+
+    set->val.nodes = ly_realloc(set->val.nodes, size * sizeof *set->val.nodes);
+    LY_CHECK_ERR_RET(!set->val.nodes, LOGMEM(set->ctx), LY_EMEM);
+    set->size = size;
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Get a new empty set hash table, from the set pool if possible.
+ *
+ * @param[in] set Set to use.
+ * @return New hash table, NULL on error.
+ */
+static struct ly_ht *
+set_ht_new(struct lyxp_set *set)
+{
+    struct ly_ht *ht;
+
+    if (set->pool && set->pool->ht_count) {
+        /* reuse a released hash table */
+        --set->pool->ht_count;
+        ht = set->pool->hts[set->pool->ht_count];
+        lyht_clear(ht);
+        return ht;
+    }
+
+    return lyht_new(1, sizeof(struct lyxp_set_hash_node), set_values_equal_cb, NULL, 1);
+}
+
+/**
+ * @brief Duplicate a set hash table, into a table from the set pool if possible.
+ *
+ * @param[in] set Set to use.
+ * @param[in] orig Hash table to duplicate.
+ * @return Duplicated hash table, NULL on error.
+ */
+static struct ly_ht *
+set_ht_dup(struct lyxp_set *set, const struct ly_ht *orig)
+{
+    struct ly_ht *ht;
+
+    if (set->pool && set->pool->ht_count) {
+        /* reuse a released hash table */
+        ht = set->pool->hts[set->pool->ht_count - 1];
+        if (!lyht_copy(ht, orig)) {
+            --set->pool->ht_count;
+            return ht;
+        }
+    }
+
+    return lyht_dup(orig);
+}
+
+/**
+ * @brief Release the hash table of a set, into the set pool if possible.
+ *
+ * @param[in] set Set to use.
+ */
+static void
+set_ht_free(struct lyxp_set *set)
+{
+    if (!set->ht) {
+        return;
+    }
+
+    if (set->pool && (set->pool->ht_count < LYXP_SET_POOL_CACHE)) {
+        /* keep the hash table for reuse */
+        set->pool->hts[set->pool->ht_count] = set->ht;
+        ++set->pool->ht_count;
+    } else {
+        lyht_free(set->ht, NULL);
+    }
+    set->ht = NULL;
+}
+
 /**
  * @brief Insert node and its hash into set.
  *
@@ -738,7 +992,8 @@ set_insert_node_hash(struct lyxp_set *set, struct lyd_node *node, enum lyxp_node
 
     if (!set->ht && (set->used >= LYD_HT_MIN_ITEMS)) {
         /* create hash table and add all the nodes */
-        set->ht = lyht_new(1, sizeof(struct lyxp_set_hash_node), set_values_equal_cb, NULL, 1);
+        set->ht = set_ht_new(set);
+        LY_CHECK_RET(!set->ht, );
         for (i = 0; i < set->used; ++i) {
             hnode.node = set->val.nodes[i].node;
             hnode.type = set->val.nodes[i].type;
@@ -800,8 +1055,7 @@ set_remove_node_hash(struct lyxp_set *set, struct lyd_node *node, enum lyxp_node
         (void)r;
 
         if (!set->ht->used) {
-            lyht_free(set->ht, NULL);
-            set->ht = NULL;
+            set_ht_free(set);
         }
     }
 }
@@ -853,8 +1107,8 @@ lyxp_set_free_content(struct lyxp_set *set)
     }
 
     if (set->type == LYXP_SET_NODE_SET) {
-        free(set->val.nodes);
-        lyht_free(set->ht, NULL);
+        set_nodes_free(set);
+        set_ht_free(set);
     } else if (set->type == LYXP_SET_SCNODE_SET) {
         free(set->val.scnodes);
         lyht_free(set->ht, NULL);
@@ -881,12 +1135,22 @@ lyxp_set_free_content(struct lyxp_set *set)
 static void
 lyxp_set_free(struct lyxp_set *set)
 {
+    struct lyxp_set_pool *pool;
+
     if (!set) {
         return;
     }
 
     lyxp_set_free_content(set);
-    free(set);
+
+    pool = set->pool;
+    if (pool && (pool->set_count < LYXP_SET_POOL_CACHE)) {
+        /* keep the set for reuse */
+        pool->sets[pool->set_count] = set;
+        ++pool->set_count;
+    } else {
+        free(set);
+    }
 }
 
 /**
@@ -914,6 +1178,7 @@ set_init(struct lyxp_set *new, const struct lyxp_set *set)
     new->format = set->format;
     new->prefix_data = set->prefix_data;
     new->vars = set->vars;
+    new->pool = set->pool;
 }
 
 /**
@@ -932,8 +1197,14 @@ set_copy(struct lyxp_set *set)
         return NULL;
     }
 
-    ret = malloc(sizeof *ret);
-    LY_CHECK_ERR_RET(!ret, LOGMEM(set->ctx), NULL);
+    if (set->pool && set->pool->set_count) {
+        /* reuse a released set */
+        --set->pool->set_count;
+        ret = set->pool->sets[set->pool->set_count];
+    } else {
+        ret = malloc(sizeof *ret);
+        LY_CHECK_ERR_RET(!ret, LOGMEM(set->ctx), NULL);
+    }
     set_init(ret, set);
 
     if (set->type == LYXP_SET_SCNODE_SET) {
@@ -957,18 +1228,17 @@ set_copy(struct lyxp_set *set)
     } else if (set->type == LYXP_SET_NODE_SET) {
         ret->type = set->type;
         if (set->used) {
-            ret->val.nodes = malloc(set->used * sizeof *ret->val.nodes);
-            LY_CHECK_ERR_RET(!ret->val.nodes, LOGMEM(set->ctx); free(ret), NULL);
+            LY_CHECK_ERR_RET(set_nodes_alloc(ret, set->used), free(ret), NULL);
             memcpy(ret->val.nodes, set->val.nodes, set->used * sizeof *ret->val.nodes);
         } else {
             ret->val.nodes = NULL;
         }
 
-        ret->used = ret->size = set->used;
+        ret->used = set->used;
         ret->ctx_pos = set->ctx_pos;
         ret->ctx_size = set->ctx_size;
         if (set->ht) {
-            ret->ht = lyht_dup(set->ht);
+            ret->ht = set_ht_dup(ret, set->ht);
         }
     } else {
         memcpy(ret, set, sizeof *ret);
@@ -1075,20 +1345,19 @@ set_fill_set(struct lyxp_set *trg, const struct lyxp_set *src)
         assert(src->type == LYXP_SET_NODE_SET);
 
         trg->type = LYXP_SET_NODE_SET;
-        trg->used = src->used;
-        trg->size = src->used;
         trg->ctx_pos = src->ctx_pos;
         trg->ctx_size = src->ctx_size;
 
-        if (trg->size) {
-            trg->val.nodes = malloc(trg->size * sizeof *trg->val.nodes);
-            LY_CHECK_ERR_RET(!trg->val.nodes, LOGMEM(src->ctx); memset(trg, 0, sizeof *trg), );
+        if (src->used) {
+            LY_CHECK_ERR_RET(set_nodes_alloc(trg, src->used), memset(trg, 0, sizeof *trg), );
             memcpy(trg->val.nodes, src->val.nodes, src->used * sizeof *src->val.nodes);
         } else {
             trg->val.nodes = NULL;
+            trg->size = 0;
         }
+        trg->used = src->used;
         if (src->ht) {
-            trg->ht = lyht_dup(src->ht);
+            trg->ht = set_ht_dup(trg, src->ht);
         } else {
             trg->ht = NULL;
         }
@@ -1326,11 +1595,9 @@ set_insert_node(struct lyxp_set *set, const struct lyd_node *node, uint32_t pos,
             LOGINT(set->ctx);
             idx = 0;
         }
-        set->val.nodes = malloc(LYXP_SET_SIZE_START * sizeof *set->val.nodes);
-        LY_CHECK_ERR_RET(!set->val.nodes, LOGMEM(set->ctx), );
+        LY_CHECK_RET(set_nodes_alloc(set, LYXP_SET_SIZE_START), );
         set->type = LYXP_SET_NODE_SET;
         set->used = 0;
-        set->size = LYXP_SET_SIZE_START;
         set->ctx_pos = 1;
         set->ctx_size = 1;
         set->ht = NULL;
@@ -1339,9 +1606,7 @@ set_insert_node(struct lyxp_set *set, const struct lyd_node *node, uint32_t pos,
         if (set->used == set->size) {
 
             /* set is full */
-            set->val.nodes = ly_realloc(set->val.nodes, (set->size * LYXP_SET_SIZE_MUL_STEP) * sizeof *set->val.nodes);
-            LY_CHECK_ERR_RET(!set->val.nodes, LOGMEM(set->ctx), );
-            set->size *= LYXP_SET_SIZE_MUL_STEP;
+            LY_CHECK_RET(set_nodes_realloc(set, set->size * LYXP_SET_SIZE_MUL_STEP), );
         }
 
         if (idx > set->used) {
@@ -1881,10 +2146,7 @@ set_sorted_merge(struct lyxp_set *trg, struct lyxp_set *src)
     /* make memory for the merge (duplicates are not detected yet, so space
      * will likely be wasted on them, too bad) */
     if (trg->size - trg->used < src->used) {
-        trg->size = trg->used + src->used;
-
-        trg->val.nodes = ly_realloc(trg->val.nodes, trg->size * sizeof *trg->val.nodes);
-        LY_CHECK_ERR_RET(!trg->val.nodes, LOGMEM(src->ctx), LY_EMEM);
+        LY_CHECK_RET(set_nodes_realloc(trg, trg->used + src->used));
     }
 
     i = 0;
@@ -4905,11 +5167,179 @@ xpath_position(struct lyxp_set **UNUSED(args), uint32_t UNUSED(arg_count), struc
     return LY_SUCCESS;
 }
 
+/**
+ * @brief Maximum number of compiled patterns kept in the context re-match() cache.
+ */
+#define LYXP_RE_CACHE_SIZE 256
+
+/**
+ * @brief Record of the context cache of compiled re-match() patterns.
+ */
+struct lyxp_re_cache_rec {
+    char *pattern;      /**< Original XPath (XML Schema) pattern, key of the record. */
+    pcre2_code *code;   /**< Compiled pattern, JIT-compiled if supported. */
+    uint32_t last_use;  /**< Cache logical time of the last use of the record. */
+    uint32_t refs;      /**< Number of evaluations currently using @p code, the record cannot be evicted if non-zero. */
+};
+
+/**
+ * @brief Hash table value-equal callback for comparing re-match() cache records.
+ */
+static ly_bool
+lyxp_re_cache_equal_cb(void *val1_p, void *val2_p, ly_bool UNUSED(mod), void *UNUSED(cb_data))
+{
+    struct lyxp_re_cache_rec *rec1 = *(struct lyxp_re_cache_rec **)val1_p, *rec2 = *(struct lyxp_re_cache_rec **)val2_p;
+
+    return !strcmp(rec1->pattern, rec2->pattern);
+}
+
+/**
+ * @brief Free a re-match() cache record.
+ *
+ * @param[in] val_p Pointer to the record pointer.
+ */
+static void
+lyxp_re_cache_rec_free(void *val_p)
+{
+    struct lyxp_re_cache_rec *rec = *(struct lyxp_re_cache_rec **)val_p;
+
+    pcre2_code_free(rec->code);
+    free(rec->pattern);
+    free(rec);
+}
+
+void
+lyxp_re_cache_clean(struct ly_ctx_re_cache *cache)
+{
+    lyht_free(cache->ht, lyxp_re_cache_rec_free);
+    cache->ht = NULL;
+}
+
+/**
+ * @brief Evict the least recently used record not being used from a full re-match() cache.
+ *
+ * Cache lock is expected to be held.
+ *
+ * @param[in] cache Context re-match() cache.
+ */
+static void
+lyxp_re_cache_evict(struct ly_ctx_re_cache *cache)
+{
+    struct lyxp_re_cache_rec *rec, *lru = NULL;
+    struct ly_ht_rec *ht_rec;
+    uint32_t hlist_idx, rec_idx, hash;
+
+    LYHT_ITER_ALL_RECS(cache->ht, hlist_idx, rec_idx, ht_rec) {
+        rec = *(struct lyxp_re_cache_rec **)ht_rec->val;
+        if (!rec->refs && (!lru || (cache->clock - rec->last_use > cache->clock - lru->last_use))) {
+            lru = rec;
+        }
+    }
+    if (!lru) {
+        /* all the patterns are being used */
+        return;
+    }
+
+    hash = lyht_hash(lru->pattern, strlen(lru->pattern));
+    lyht_remove(cache->ht, &lru, hash);
+    lyxp_re_cache_rec_free(&lru);
+}
+
+/**
+ * @brief Get a compiled pattern from the context re-match() cache, compile and store it if not yet cached.
+ *
+ * Release the record with ::lyxp_re_cache_release() once the compiled pattern is not needed.
+ *
+ * @param[in] ctx Context with the cache.
+ * @param[in] pattern XPath pattern to get.
+ * @param[out] rec Cache record with the compiled pattern.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+lyxp_re_cache_get(struct ly_ctx *ctx, const char *pattern, struct lyxp_re_cache_rec **rec)
+{
+    struct ly_ctx_re_cache *cache = &ctx->re_cache;
+    struct lyxp_re_cache_rec key = {.pattern = (char *)pattern}, *key_p = &key, *new_rec = NULL, **match_p;
+    uint32_t hash;
+    LY_ERR rc = LY_SUCCESS;
+
+    *rec = NULL;
+    hash = lyht_hash(pattern, strlen(pattern));
+
+    pthread_mutex_lock(&cache->lock);
+
+    if (!cache->ht) {
+        cache->ht = lyht_new(LYHT_MIN_SIZE, sizeof(struct lyxp_re_cache_rec *), lyxp_re_cache_equal_cb, NULL, 1);
+        LY_CHECK_ERR_GOTO(!cache->ht, LOGMEM(ctx); rc = LY_EMEM, cleanup);
+    }
+
+    if (!lyht_find(cache->ht, &key_p, hash, (void **)&match_p)) {
+        /* cache hit */
+        ++cache->hits;
+        goto cleanup;
+    }
+    ++cache->misses;
+
+    /* compile the pattern without holding the lock */
+    pthread_mutex_unlock(&cache->lock);
+
+    new_rec = calloc(1, sizeof *new_rec);
+    LY_CHECK_ERR_RET(!new_rec, LOGMEM(ctx), LY_EMEM);
+    new_rec->pattern = strdup(pattern);
+    LY_CHECK_ERR_GOTO(!new_rec->pattern, LOGMEM(ctx); rc = LY_EMEM, cleanup_unlocked);
+    LY_CHECK_GOTO(rc = lys_compile_type_pattern_check(ctx, pattern, &new_rec->code), cleanup_unlocked);
+
+    /* JIT is optional, the interpreter is used if not supported */
+    pcre2_jit_compile(new_rec->code, PCRE2_JIT_COMPLETE);
+
+    pthread_mutex_lock(&cache->lock);
+
+    if (!lyht_find(cache->ht, &key_p, hash, (void **)&match_p)) {
+        /* compiled and stored by another thread meanwhile */
+        lyxp_re_cache_rec_free(&new_rec);
+    } else {
+        if (cache->ht->used >= LYXP_RE_CACHE_SIZE) {
+            lyxp_re_cache_evict(cache);
+        }
+        LY_CHECK_ERR_GOTO(lyht_insert(cache->ht, &new_rec, hash, (void **)&match_p),
+                lyxp_re_cache_rec_free(&new_rec); rc = LY_EMEM, cleanup);
+    }
+
+cleanup:
+    if (!rc) {
+        *rec = *match_p;
+        (*rec)->last_use = ++cache->clock;
+        ++(*rec)->refs;
+    }
+    pthread_mutex_unlock(&cache->lock);
+    return rc;
+
+cleanup_unlocked:
+    lyxp_re_cache_rec_free(&new_rec);
+    return rc;
+}
+
+/**
+ * @brief Release a record of the context re-match() cache acquired by ::lyxp_re_cache_get().
+ *
+ * @param[in] ctx Context with the cache.
+ * @param[in] rec Record to release.
+ */
+static void
+lyxp_re_cache_release(struct ly_ctx *ctx, struct lyxp_re_cache_rec *rec)
+{
+    pthread_mutex_lock(&ctx->re_cache.lock);
+    --rec->refs;
+    pthread_mutex_unlock(&ctx->re_cache.lock);
+}
+
 /**
  * @brief Execute the YANG 1.1 re-match(string, string) function. Returns LYXP_SET_BOOLEAN
  *        depending on whether the second argument regex matches the first argument string. For details refer to
  *        YANG 1.1 RFC section 10.2.1.
  *
+ * Compiled patterns are cached in the context so that a pattern is compiled only once for all the evaluations.
+ *
  * @param[in] args Array of arguments.
  * @param[in] arg_count Count of elements in @p args.
  * @param[in,out] set Context and result set at the same time.
@@ -4919,10 +5349,11 @@ xpath_position(struct lyxp_set **UNUSED(args), uint32_t UNUSED(arg_count), struc
 static LY_ERR
 xpath_re_match(struct lyxp_set **args, uint32_t UNUSED(arg_count), struct lyxp_set *set, uint32_t options)
 {
-    struct lysc_pattern **patterns = NULL, **pattern;
+    struct lyxp_re_cache_rec *rec;
     struct lysc_node_leaf *sleaf;
+    pcre2_match_data *match_data;
     LY_ERR rc = LY_SUCCESS;
-    struct ly_err_item *err;
+    int r;
 
     if (options & LYXP_SCNODE_ALL) {
         if ((args[0]->type == LYXP_SET_SCNODE_SET) && (sleaf = (struct lysc_node_leaf *)warn_get_scnode_in_ctx(args[0]))) {
@@ -4949,38 +5380,40 @@ xpath_re_match(struct lyxp_set **args, uint32_t UNUSED(arg_count), struct lyxp_s
     rc = lyxp_set_cast(args[1], LYXP_SET_STRING);
     LY_CHECK_RET(rc);
 
-    LY_ARRAY_NEW_RET(set->ctx, patterns, pattern, LY_EMEM);
-    *pattern = calloc(1, sizeof **pattern);
     if (set->cur_node) {
         LOG_LOCSET(NULL, set->cur_node);
     }
-    rc = lys_compile_type_pattern_check(set->ctx, args[1]->val.str, &(*pattern)->code);
+    rc = lyxp_re_cache_get(set->ctx, args[1]->val.str, &rec);
     if (set->cur_node) {
         LOG_LOCBACK(0, 1);
     }
-    if (rc != LY_SUCCESS) {
-        LY_ARRAY_FREE(patterns);
-        return rc;
-    }
+    LY_CHECK_RET(rc);
 
-    rc = lyplg_type_validate_patterns(patterns, args[0]->val.str, strlen(args[0]->val.str), &err);
-    pcre2_code_free((*pattern)->code);
-    free(*pattern);
-    LY_ARRAY_FREE(patterns);
-    if (rc && (rc != LY_EVALID)) {
-        ly_err_print(set->ctx, err);
-        ly_err_free(err);
-        return rc;
+    /* match_data needs to be allocated each time because of possible multi-threaded evaluation,
+     * the pattern is compiled anchored so no match options are needed, which allows JIT to be used */
+    match_data = pcre2_match_data_create_from_pattern(rec->code, NULL);
+    LY_CHECK_ERR_GOTO(!match_data, LOGMEM(set->ctx); rc = LY_EMEM, cleanup);
+    r = pcre2_match(rec->code, (PCRE2_SPTR)args[0]->val.str, PCRE2_ZERO_TERMINATED, 0, 0, match_data, NULL);
+    if (r == PCRE2_ERROR_JIT_STACKLIMIT) {
+        /* the default JIT stack is not large enough, use the interpreter */
+        r = pcre2_match(rec->code, (PCRE2_SPTR)args[0]->val.str, PCRE2_ZERO_TERMINATED, 0, PCRE2_NO_JIT, match_data, NULL);
     }
+    pcre2_match_data_free(match_data);
 
-    if (rc == LY_EVALID) {
-        ly_err_free(err);
-        set_fill_boolean(set, 0);
-    } else {
-        set_fill_boolean(set, 1);
+    if ((r != PCRE2_ERROR_NOMATCH) && (r < 0)) {
+        PCRE2_UCHAR pcre2_errmsg[LY_PCRE2_MSG_LIMIT] = {0};
+
+        pcre2_get_error_message(r, pcre2_errmsg, LY_PCRE2_MSG_LIMIT);
+        LOGERR(set->ctx, LY_ESYS, "%s", (const char *)pcre2_errmsg);
+        rc = LY_ESYS;
+        goto cleanup;
     }
 
-    return LY_SUCCESS;
+    set_fill_boolean(set, (r == PCRE2_ERROR_NOMATCH) ? 0 : 1);
+
+cleanup:
+    lyxp_re_cache_release(set->ctx, rec);
+    return rc;
 }
 
 /**
@@ -6183,7 +6616,8 @@ cleanup:
  *
  * @param[in,out] set Set to use.
  * @param[in] scnode Matching node schema.
- * @param[in] predicates If @p scnode is ::LYS_LIST or ::LYS_LEAFLIST, the predicates specifying a single instance.
+ * @param[in] predicates If @p scnode is ::LYS_LIST or ::LYS_LEAFLIST, the predicates specifying a single instance
+ * or a single value of an indexed leaf of the list.
  * @param[in] options XPath options.
  * @return LY_ERR (LY_EINCOMPLETE on unresolved when)
  */
@@ -6192,10 +6626,11 @@ moveto_node_hash_child(struct lyxp_set *set, const struct lysc_node *scnode, con
         uint32_t options)
 {
     LY_ERR ret = LY_SUCCESS, r;
-    uint32_t i;
+    uint32_t i, j;
     const struct lyd_node *siblings;
     struct lyxp_set result;
     struct lyd_node *sub, *inst = NULL;
+    struct ly_set *inst_set = NULL;
 
     assert(scnode && (!(scnode->nodetype & (LYS_LIST | LYS_LEAFLIST)) || predicates));
 
@@ -6223,7 +6658,11 @@ moveto_node_hash_child(struct lyxp_set *set, const struct lysc_node *scnode, con
     }
 
     /* create specific data instance if needed */
-    if (scnode->nodetype == LYS_LIST) {
+    if ((scnode->nodetype == LYS_LIST) && !(predicates[0].key->flags & LYS_KEY)) {
+        /* indexed leaf instance, there may be several matching list instances */
+        LY_CHECK_GOTO(ret = lyd_create_term2(predicates[0].key, &predicates[0].value, &inst), cleanup);
+        LY_CHECK_GOTO(ret = ly_set_new(&inst_set), cleanup);
+    } else if (scnode->nodetype == LYS_LIST) {
         LY_CHECK_GOTO(ret = lyd_create_list(scnode, predicates, NULL, 1, &inst), cleanup);
     } else if (scnode->nodetype == LYS_LEAFLIST) {
         LY_CHECK_GOTO(ret = lyd_create_term2(scnode, &predicates[0].value, &inst), cleanup);
@@ -6243,7 +6682,12 @@ moveto_node_hash_child(struct lyxp_set *set, const struct lysc_node *scnode, con
         }
 
         /* find the node using hashes */
-        if (inst) {
+        if (inst_set) {
+            ly_set_clean(inst_set, NULL);
+            LY_CHECK_GOTO(ret = lyd_find_sibling_index(siblings, inst, inst_set), cleanup);
+            sub = inst_set->count ? inst_set->dnodes[0] : NULL;
+            r = sub ? LY_SUCCESS : LY_ENOTFOUND;
+        } else if (inst) {
             r = lyd_find_sibling_first(siblings, inst, &sub);
         } else {
             r = lyd_find_sibling_val(siblings, scnode, NULL, 0, &sub);
@@ -6254,13 +6698,14 @@ moveto_node_hash_child(struct lyxp_set *set, const struct lysc_node *scnode, con
         }
         LY_CHECK_ERR_GOTO(r && (r != LY_ENOTFOUND), ret = r, cleanup);
 
-        /* when check */
-        if (!(options & LYXP_IGNORE_WHEN) && sub && lysc_has_when(sub->schema) && !(sub->flags & LYD_WHEN_TRUE)) {
-            ret = LY_EINCOMPLETE;
-            goto cleanup;
-        }
+        /* all the found instances */
+        for (j = 0; sub; sub = (inst_set && (++j < inst_set->count)) ? inst_set->dnodes[j] : NULL) {
+            /* when check */
+            if (!(options & LYXP_IGNORE_WHEN) && lysc_has_when(sub->schema) && !(sub->flags & LYD_WHEN_TRUE)) {
+                ret = LY_EINCOMPLETE;
+                goto cleanup;
+            }
 
-        if (sub) {
             /* pos filled later */
             set_insert_node(&result, sub, 0, LYXP_NODE_ELEM, result.used);
         }
@@ -6275,6 +6720,7 @@ moveto_node_hash_child(struct lyxp_set *set, const struct lysc_node *scnode, con
 cleanup:
     lyxp_set_free_content(&result);
     lyd_free_tree(inst);
+    ly_set_free(inst_set, NULL);
     return ret;
 }
 
@@ -6811,6 +7257,31 @@ moveto_scnode(struct lyxp_set *set, const struct lys_module *moveto_mod, const c
     return LY_SUCCESS;
 }
 
+/**
+ * @brief Check whether the children of a data node need to be traversed when looking for a descendant.
+ *
+ * @param[in] node Data node whose children to check.
+ * @param[in] set Set with general XPath context.
+ * @param[in] moveto_mod Matching node module, NULL for any.
+ * @param[in] ncname Matching node name in the dictionary, NULL for any.
+ * @param[in,out] cache Cache of the results for ::lysc_node_desc_possible().
+ * @return Whether the children may include a matching node.
+ */
+static ly_bool
+moveto_alldesc_traverse(const struct lyd_node *node, const struct lyxp_set *set, const struct lys_module *moveto_mod,
+        const char *ncname, struct ly_ht **cache)
+{
+    if (!moveto_mod && !ncname) {
+        /* any node matches */
+        return 1;
+    } else if (!node->schema || (LYD_CTX(node) != set->ctx)) {
+        /* opaque nodes and nodes from other contexts are not known by the schema */
+        return 1;
+    }
+
+    return lysc_node_desc_possible(node->schema, moveto_mod, ncname, cache);
+}
+
 /**
  * @brief Move context @p set to a child node and all its descendants. Result is LYXP_SET_NODE_SET.
  *        Context position aware.
@@ -6827,6 +7298,7 @@ moveto_node_alldesc_child(struct lyxp_set *set, const struct lys_module *moveto_
     uint32_t i;
     const struct lyd_node *next, *elem, *start;
     struct lyxp_set ret_set;
+    struct ly_ht *cache = NULL;
     LY_ERR rc;
 
     if (options & LYXP_SKIP_EXPR) {
@@ -6858,14 +7330,19 @@ moveto_node_alldesc_child(struct lyxp_set *set, const struct lys_module *moveto_
                     goto skip_children;
                 }
             } else if (rc == LY_EINCOMPLETE) {
+                lyht_free(cache, NULL);
                 return rc;
             } else if (rc == LY_EINVAL) {
                 goto skip_children;
             }
 
             /* TREE DFS NEXT ELEM */
-            /* select element for the next run - children first */
-            next = lyd_child(elem);
+            /* select element for the next run - children first, if there can be any matching nodes among them */
+            if (moveto_alldesc_traverse(elem, set, moveto_mod, ncname, &cache)) {
+                next = lyd_child(elem);
+            } else {
+                next = NULL;
+            }
             if (!next) {
 skip_children:
                 /* no children, so try siblings, but only if it's not the start,
@@ -6889,6 +7366,8 @@ skip_children:
         }
     }
 
+    lyht_free(cache, NULL);
+
     /* make the temporary set the current one */
     ret_set.ctx_pos = set->ctx_pos;
     ret_set.ctx_size = set->ctx_size;
@@ -7697,24 +8176,21 @@ eval_name_test_try_compile_predicate_key(const char *nametest, uint32_t len, con
 }
 
 /**
- * @brief Append a simple predicate for the node.
+ * @brief Evaluate a simple predicate value that does not depend on the context node instance.
  *
  * @param[in] exp Full parsed XPath expression.
- * @param[in] tok_idx Predicate start index in @p exp.
- * @param[in] end_tok_idx Predicate end index in @p exp.
+ * @param[in] tok_idx Value start index in @p exp.
+ * @param[in] end_tok_idx Value end index in @p exp.
  * @param[in] ctx_scnode Found schema node as the context for the predicate.
  * @param[in] set Context set.
- * @param[in] pred_node Node with the value referenced in the predicate.
- * @param[in,out] pred Predicate to append to.
- * @param[in,out] pred_len Length of @p pred, is updated.
+ * @param[out] value Evaluated string value.
  * @return LY_SUCCESS on success,
  * @return LY_ENOT if a predicate could not be compiled.
  * @return LY_ERR on any error.
  */
 static LY_ERR
-eval_name_test_try_compile_predicate_append(const struct lyxp_expr *exp, uint32_t tok_idx, uint32_t end_tok_idx,
-        const struct lysc_node *ctx_scnode, const struct lyxp_set *set, const struct lysc_node *pred_node, char **pred,
-        uint32_t *pred_len)
+eval_name_test_try_compile_predicate_value(const struct lyxp_expr *exp, uint32_t tok_idx, uint32_t end_tok_idx,
+        const struct lysc_node *ctx_scnode, const struct lyxp_set *set, char **value)
 {
     LY_ERR rc = LY_SUCCESS;
     uint32_t i;
@@ -7723,7 +8199,6 @@ eval_name_test_try_compile_predicate_append(const struct lyxp_expr *exp, uint32_
     const struct lysc_node *sparent, *cur_scnode;
     struct lyxp_expr *val_exp = NULL;
     struct lyxp_set set2 = {0};
-    char quot;
 
     /* duplicate the value expression */
     LY_CHECK_GOTO(rc = lyxp_expr_dup(set->ctx, exp, tok_idx, end_tok_idx, &val_exp), cleanup);
@@ -7776,11 +8251,9 @@ eval_name_test_try_compile_predicate_append(const struct lyxp_expr *exp, uint32_
     /* cast it into a string */
     LY_CHECK_GOTO(rc = lyxp_set_cast(&set2, LYXP_SET_STRING), cleanup);
 
-    /* append the JSON predicate */
-    *pred = ly_realloc(*pred, *pred_len + 1 + strlen(pred_node->name) + 2 + strlen(set2.val.str) + 3);
-    LY_CHECK_ERR_GOTO(!*pred, LOGMEM(set->ctx); rc = LY_EMEM, cleanup);
-    quot = strchr(set2.val.str, '\'') ? '\"' : '\'';
-    *pred_len += sprintf(*pred + *pred_len, "[%s=%c%s%c]", pred_node->name, quot, set2.val.str, quot);
+    /* steal the value */
+    *value = set2.val.str;
+    set2.val.str = NULL;
 
 cleanup:
     lyxp_expr_free(set->ctx, val_exp);
@@ -7788,6 +8261,148 @@ cleanup:
     return rc;
 }
 
+/**
+ * @brief Append a simple predicate for the node.
+ *
+ * @param[in] exp Full parsed XPath expression.
+ * @param[in] tok_idx Predicate start index in @p exp.
+ * @param[in] end_tok_idx Predicate end index in @p exp.
+ * @param[in] ctx_scnode Found schema node as the context for the predicate.
+ * @param[in] set Context set.
+ * @param[in] pred_node Node with the value referenced in the predicate.
+ * @param[in,out] pred Predicate to append to.
+ * @param[in,out] pred_len Length of @p pred, is updated.
+ * @return LY_SUCCESS on success,
+ * @return LY_ENOT if a predicate could not be compiled.
+ * @return LY_ERR on any error.
+ */
+static LY_ERR
+eval_name_test_try_compile_predicate_append(const struct lyxp_expr *exp, uint32_t tok_idx, uint32_t end_tok_idx,
+        const struct lysc_node *ctx_scnode, const struct lyxp_set *set, const struct lysc_node *pred_node, char **pred,
+        uint32_t *pred_len)
+{
+    LY_ERR rc = LY_SUCCESS;
+    char *value = NULL, quot;
+
+    /* evaluate the value */
+    LY_CHECK_GOTO(rc = eval_name_test_try_compile_predicate_value(exp, tok_idx, end_tok_idx, ctx_scnode, set, &value),
+            cleanup);
+
+    /* append the JSON predicate */
+    *pred = ly_realloc(*pred, *pred_len + 1 + strlen(pred_node->name) + 2 + strlen(value) + 3);
+    LY_CHECK_ERR_GOTO(!*pred, LOGMEM(set->ctx); rc = LY_EMEM, cleanup);
+    quot = strchr(value, '\'') ? '\"' : '\'';
+    *pred_len += sprintf(*pred + *pred_len, "[%s=%c%s%c]", pred_node->name, quot, value, quot);
+
+cleanup:
+    free(value);
+    return rc;
+}
+
+/**
+ * @brief Try to compile list predicate on a leaf with a secondary index to be used for hash-based instance search.
+ *
+ * @param[in] exp Full parsed XPath expression.
+ * @param[in,out] tok_idx Index in @p exp at the beginning of the predicate, is updated on success.
+ * @param[in] ctx_scnode Found list schema node as the context for the predicate.
+ * @param[in] set Context set.
+ * @param[out] predicates Parsed predicate with the indexed leaf and its value.
+ * @return LY_SUCCESS on success,
+ * @return LY_ENOT if a predicate could not be compiled.
+ * @return LY_ERR on any error.
+ */
+static LY_ERR
+eval_name_test_try_compile_predicate_index(const struct lyxp_expr *exp, uint32_t *tok_idx,
+        const struct lysc_node *ctx_scnode, const struct lyxp_set *set, struct ly_path_predicate **predicates)
+{
+    LY_ERR rc = LY_SUCCESS;
+    uint32_t e_idx, val_start_idx, nested_pred, len;
+    const char *nametest;
+    const struct lys_module *mod;
+    const struct lysc_node *leaf;
+    struct ly_path_predicate *p;
+    char *value = NULL;
+
+    assert(ctx_scnode->flags & LYS_INDEXED);
+
+    /* check for predicate "[leaf=...]" */
+    e_idx = *tok_idx;
+
+    /* '[' */
+    if (lyxp_check_token(NULL, exp, e_idx, LYXP_TOKEN_BRACK1)) {
+        return LY_ENOT;
+    }
+    ++e_idx;
+
+    if (lyxp_check_token(NULL, exp, e_idx, LYXP_TOKEN_NAMETEST)) {
+        return LY_ENOT;
+    }
+
+    /* find the leaf */
+    nametest = exp->expr + exp->tok_pos[e_idx];
+    len = exp->tok_len[e_idx];
+    LY_CHECK_RET(moveto_resolve_model(&nametest, &len, set, ctx_scnode, &mod));
+    leaf = mod ? lys_find_child(ctx_scnode, mod, nametest, len, LYS_LEAF, 0) : NULL;
+    if (!leaf || !(leaf->flags & LYS_INDEXED)) {
+        /* not an indexed leaf */
+        return LY_ENOT;
+    }
+    ++e_idx;
+
+    if (lyxp_check_token(NULL, exp, e_idx, LYXP_TOKEN_OPER_EQUAL)) {
+        /* not '=' */
+        return LY_ENOT;
+    }
+    ++e_idx;
+
+    /* value start */
+    val_start_idx = e_idx;
+
+    /* ']' */
+    nested_pred = 1;
+    do {
+        ++e_idx;
+
+        if ((nested_pred == 1) && !lyxp_check_token(NULL, exp, e_idx, LYXP_TOKEN_OPER_LOG)) {
+            /* higher priority than '=' */
+            return LY_ENOT;
+        } else if (!lyxp_check_token(NULL, exp, e_idx, LYXP_TOKEN_BRACK1)) {
+            /* nested predicate */
+            ++nested_pred;
+        } else if (!lyxp_check_token(NULL, exp, e_idx, LYXP_TOKEN_BRACK2)) {
+            /* predicate end */
+            --nested_pred;
+        }
+    } while (nested_pred);
+
+    if (!lyxp_check_token(NULL, exp, e_idx + 1, LYXP_TOKEN_BRACK1)) {
+        /* another predicate may depend on the positions of the instances */
+        return LY_ENOT;
+    }
+
+    /* try to evaluate the value */
+    LY_CHECK_GOTO(rc = eval_name_test_try_compile_predicate_value(exp, val_start_idx, e_idx - 1, ctx_scnode, set,
+            &value), cleanup);
+
+    /* store the value */
+    LY_ARRAY_NEW_GOTO(set->ctx, *predicates, p, rc, cleanup);
+    p->type = LY_PATH_PREDTYPE_LIST;
+    p->key = leaf;
+    rc = lyd_value_store(set->ctx, &p->value, ((struct lysc_node_leaf *)leaf)->type, value, strlen(value), 0, 0, NULL,
+            LY_VALUE_JSON, NULL, LYD_HINT_DATA, leaf, NULL);
+    LY_CHECK_ERR_GOTO(rc, p->value.realtype = NULL, cleanup);
+
+    /* "allocate" the type to avoid problems when freeing the value after the type was freed */
+    LY_ATOMIC_INC_BARRIER(((struct lysc_type *)p->value.realtype)->refcount);
+
+    /* success, the predicate includes all the needed information for hash-based search */
+    *tok_idx = e_idx + 1;
+
+cleanup:
+    free(value);
+    return rc;
+}
+
 /**
  * @brief Try to compile list or leaf-list predicate in the known format to be used for hash-based instance search.
  *
@@ -7815,6 +8430,15 @@ eval_name_test_try_compile_predicates(const struct lyxp_expr *exp, uint32_t *tok
     /* turn logging off */
     prev_lo = ly_temp_log_options(&temp_lo);
 
+    if ((ctx_scnode->nodetype == LYS_LIST) && (ctx_scnode->flags & LYS_INDEXED)) {
+        /* check for a predicate on an indexed leaf */
+        rc = eval_name_test_try_compile_predicate_index(exp, tok_idx, ctx_scnode, set, predicates);
+        if (rc != LY_ENOT) {
+            goto cleanup;
+        }
+        rc = LY_SUCCESS;
+    }
+
     if (ctx_scnode->nodetype == LYS_LIST) {
         /* check for predicates "[key1=...][key2=...]..." */
 
@@ -8557,7 +9181,7 @@ eval_function_call(const struct lyxp_expr *exp, uint32_t *tok_idx, struct lyxp_s
 
     LY_ERR (*xpath_func)(struct lyxp_set **, uint32_t, struct lyxp_set *, uint32_t) = NULL;
     uint32_t arg_count = 0, i;
-    struct lyxp_set **args = NULL, **args_aux;
+    struct lyxp_set *args_buf[LYXP_FUNC_ARGS_START], **args = args_buf, **args_aux;
 
     if (!(options & LYXP_SKIP_EXPR)) {
         /* FunctionName */
@@ -8691,8 +9315,6 @@ eval_function_call(const struct lyxp_expr *exp, uint32_t *tok_idx, struct lyxp_s
     /* ( Expr ( ',' Expr )* )? */
     if (exp->tokens[*tok_idx] != LYXP_TOKEN_PAR2) {
         if (!(options & LYXP_SKIP_EXPR)) {
-            args = malloc(sizeof *args);
-            LY_CHECK_ERR_GOTO(!args, LOGMEM(set->ctx); rc = LY_EMEM, cleanup);
             arg_count = 1;
             args[0] = set_copy(set);
             if (!args[0]) {
@@ -8715,9 +9337,15 @@ eval_function_call(const struct lyxp_expr *exp, uint32_t *tok_idx, struct lyxp_s
 
         if (!(options & LYXP_SKIP_EXPR)) {
             ++arg_count;
-            args_aux = realloc(args, arg_count * sizeof *args);
-            LY_CHECK_ERR_GOTO(!args_aux, arg_count--; LOGMEM(set->ctx); rc = LY_EMEM, cleanup);
-            args = args_aux;
+            if (arg_count > LYXP_FUNC_ARGS_START) {
+                /* too many arguments for the local array */
+                args_aux = realloc((args == args_buf) ? NULL : args, arg_count * sizeof *args);
+                LY_CHECK_ERR_GOTO(!args_aux, arg_count--; LOGMEM(set->ctx); rc = LY_EMEM, cleanup);
+                if (args == args_buf) {
+                    memcpy(args_aux, args_buf, sizeof args_buf);
+                }
+                args = args_aux;
+            }
             args[arg_count - 1] = set_copy(set);
             if (!args[arg_count - 1]) {
                 rc = LY_EMEM;
@@ -8743,7 +9371,7 @@ eval_function_call(const struct lyxp_expr *exp, uint32_t *tok_idx, struct lyxp_s
 
     if (!(options & LYXP_SKIP_EXPR)) {
         /* evaluate function */
-        rc = xpath_func(args, arg_count, set, options);
+        rc = xpath_func(arg_count ? args : NULL, arg_count, set, options);
 
         if (options & LYXP_SCNODE_ALL) {
             /* merge all nodes from arg evaluations */
@@ -8760,7 +9388,9 @@ cleanup:
     for (i = 0; i < arg_count; ++i) {
         lyxp_set_free(args[i]);
     }
-    free(args);
+    if (args != args_buf) {
+        free(args);
+    }
     return rc;
 }
 
@@ -9694,6 +10324,7 @@ lyxp_eval(const struct ly_ctx *ctx, const struct lyxp_expr *exp, const struct ly
 {
     uint32_t tok_idx = 0;
     LY_ERR rc;
+    struct lyxp_set_pool pool;
 
     LY_CHECK_ARG_RET(ctx, ctx, exp, set, LY_EINVAL);
     if (!cur_mod && ((format == LY_VALUE_SCHEMA) || (format == LY_VALUE_SCHEMA_RESOLVED))) {
@@ -9717,9 +10348,11 @@ lyxp_eval(const struct ly_ctx *ctx, const struct lyxp_expr *exp, const struct ly
     }
 
     /* prepare set for evaluation */
+    set_pool_init(&pool);
     memset(set, 0, sizeof *set);
     set->type = LYXP_SET_NODE_SET;
     set->root_type = lyxp_get_root_type(ctx_node, NULL, options);
+    set->pool = &pool;
     set_insert_node(set, (struct lyd_node *)ctx_node, 0, ctx_node ? LYXP_NODE_ELEM : set->root_type, 0);
 
     set->ctx = (struct ly_ctx *)ctx;
@@ -9742,9 +10375,15 @@ lyxp_eval(const struct ly_ctx *ctx, const struct lyxp_expr *exp, const struct ly
     if (!rc && set->not_found) {
         rc = LY_ENOTFOUND;
     }
+    if (!rc) {
+        /* the result must not reference the pool */
+        rc = set_pool_detach(set);
+    }
     if (rc) {
         lyxp_set_free_content(set);
     }
+    set->pool = NULL;
+    set_pool_clear(&pool);
 
     if (set->cur_node) {
         LOG_LOCBACK(0, 1);
@@ -24,6 +24,7 @@
 #include "tree_schema.h"
 
 struct ly_ctx;
+struct ly_ctx_re_cache;
 struct lyd_node;
 
 /**
@@ -86,6 +87,13 @@ struct lyd_node;
 #define LYXP_SET_SIZE_START 4
 #define LYXP_SET_SIZE_MUL_STEP 2
 
+/* XPath evaluation set storage pool */
+#define LYXP_SET_POOL_BLOCKS 32
+#define LYXP_SET_POOL_CACHE 8
+
+/* XPath function arguments without allocation */
+#define LYXP_FUNC_ARGS_START 4
+
 /* building string when casting */
 #define LYXP_STRING_CAST_SIZE_START 64
 #define LYXP_STRING_CAST_SIZE_STEP 16
@@ -315,6 +323,31 @@ struct lyxp_set {
     void *prefix_data;                      /**< Format-specific prefix data (see ::ly_resolve_prefix). */
     const struct lyxp_var *vars;            /**< XPath variables. [Sized array](@ref sizedarrays).
                                                  Set of variable bindings. */
+    struct lyxp_set_pool *pool;             /**< Storage shared by all the sets of a single evaluation, if any. */
+};
+
+/**
+ * @brief Storage of node arrays and hash tables of all the (partial) data sets of a single XPath evaluation.
+ *
+ * Small node arrays are taken from the blocks stored directly in the pool, released larger arrays, hash tables,
+ * and sets are kept and reused by the following sets, so most of the evaluation steps do not allocate any memory.
+ */
+struct lyxp_set_pool {
+    struct lyxp_set_node blocks[LYXP_SET_POOL_BLOCKS][LYXP_SET_SIZE_START]; /**< Small node arrays. */
+    uint32_t free_blocks[LYXP_SET_POOL_BLOCKS]; /**< Indexes of unused @p blocks. */
+    uint32_t free_block_count;                  /**< Number of unused @p blocks. */
+
+    struct {
+        struct lyxp_set_node *nodes;            /**< Released allocated node array. */
+        uint32_t size;                          /**< Size of @p nodes. */
+    } arrays[LYXP_SET_POOL_CACHE];              /**< Released allocated node arrays to reuse. */
+    uint32_t array_count;                       /**< Number of @p arrays. */
+
+    struct ly_ht *hts[LYXP_SET_POOL_CACHE];     /**< Released set hash tables to reuse. */
+    uint32_t ht_count;                          /**< Number of @p hts. */
+
+    struct lyxp_set *sets[LYXP_SET_POOL_CACHE]; /**< Released allocated sets to reuse. */
+    uint32_t set_count;                         /**< Number of @p sets. */
 };
 
 /**
@@ -535,4 +568,11 @@ LY_ERR lyxp_vars_find(const struct ly_ctx *ctx, const struct lyxp_var *vars, con
  */
 void lyxp_expr_free(const struct ly_ctx *ctx, struct lyxp_expr *expr);
 
+/**
+ * @brief Free all the compiled patterns in a context cache of re-match() patterns.
+ *
+ * @param[in] cache Cache to clean, can be used again afterwards.
+ */
+void lyxp_re_cache_clean(struct ly_ctx_re_cache *cache);
+
 #endif /* LY_XPATH_H */
@@ -15,10 +15,13 @@
 #define _GNU_SOURCE
 
 #include <assert.h>
+#include <fcntl.h>
 #include <inttypes.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/time.h>
 #include <time.h>
+#include <unistd.h>
 
 #include "libyang.h"
 #include "tests_config.h"
@@ -147,6 +150,191 @@ create_list_inst(const struct lys_module *mod, uint32_t offset, uint32_t count,
     return LY_SUCCESS;
 }
 
+/**
+ * @brief Create data tree with user-ordered list instances.
+ *
+ * @param[in] mod Module of the top-level node.
+ * @param[in] count Number of list instances to create.
+ * @param[in] reorder Whether to create the instances in a shuffled order instead of the increasing one.
+ * @param[out] data Created data.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+create_userord_inst(const struct lys_module *mod, uint32_t count, ly_bool reorder, struct lyd_node **data)
+{
+    LY_ERR ret;
+    uint32_t i, k;
+    char k_val[32];
+
+    if ((ret = lyd_new_inner(NULL, mod, "userord", 0, data))) {
+        return ret;
+    }
+
+    for (i = 0; i < count; ++i) {
+        if (reorder) {
+            /* every other instance from the end, the rest in the original order */
+            k = (i % 2) ? count - 1 - i / 2 : i / 2;
+        } else {
+            k = i;
+        }
+        sprintf(k_val, "%" PRIu32, k);
+
+        if ((ret = lyd_new_list(*data, NULL, "ulst", 0, NULL, k_val))) {
+            return ret;
+        }
+    }
+
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Create data tree with list instances with long string values, some characters need to be escaped.
+ *
+ * @param[in] mod Module of the top-level node.
+ * @param[in] count Number of list instances to create.
+ * @param[out] data Created data.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+create_string_inst(const struct lys_module *mod, uint32_t count, struct lyd_node **data)
+{
+    LY_ERR ret;
+    uint32_t i, j;
+    char k1_val[32], k2_val[32], l_val[512];
+    struct lyd_node *list;
+
+    if ((ret = lyd_new_inner(NULL, mod, "cont", 0, data))) {
+        return ret;
+    }
+
+    for (i = 0; i < count; ++i) {
+        sprintf(k1_val, "%" PRIu32, i);
+        sprintf(k2_val, "str%" PRIu32, i);
+
+        /* text with a quoted word and a new line every 64 characters */
+        for (j = 0; j < sizeof l_val - 1; ++j) {
+            if (j % 64 == 63) {
+                l_val[j] = '\n';
+            } else if (j % 64 == 20) {
+                l_val[j] = '"';
+            } else {
+                l_val[j] = 'a' + (i + j) % 26;
+            }
+        }
+        l_val[j] = '\0';
+
+        if ((ret = lyd_new_list(*data, NULL, "lst", 0, &list, k1_val, k2_val))) {
+            return ret;
+        }
+        if ((ret = lyd_new_term(list, NULL, "l", l_val, 0, NULL))) {
+            return ret;
+        }
+    }
+
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Create data tree with list instances with a must condition.
+ *
+ * @param[in] mod Module of the top-level node.
+ * @param[in] count Number of list instances to create.
+ * @param[out] data Created data.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+create_must_inst(const struct lys_module *mod, uint32_t count, struct lyd_node **data)
+{
+    LY_ERR ret;
+    uint32_t i;
+    char k_val[32], l_val[32];
+    struct lyd_node *list;
+
+    if ((ret = lyd_new_inner(NULL, mod, "must", 0, data))) {
+        return ret;
+    }
+
+    for (i = 0; i < count; ++i) {
+        sprintf(k_val, "%" PRIu32, i);
+        sprintf(l_val, "l%" PRIu32, i);
+
+        if ((ret = lyd_new_list(*data, NULL, "mlst", 0, &list, k_val))) {
+            return ret;
+        }
+        if ((ret = lyd_new_term(list, NULL, "l", l_val, 0, NULL))) {
+            return ret;
+        }
+    }
+
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Create data tree with leaf-list instances of a derived type.
+ *
+ * @param[in] mod Module of the top-level node.
+ * @param[in] name Name of the leaf-list, also determines the generated values.
+ * @param[in] count Number of leaf-list instances to create.
+ * @param[out] data Created data.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+create_type_inst(const struct lys_module *mod, const char *name, uint32_t count, struct lyd_node **data)
+{
+    LY_ERR ret;
+    uint32_t i;
+    char val[64];
+
+    if ((ret = lyd_new_inner(NULL, mod, "types", 0, data))) {
+        return ret;
+    }
+
+    for (i = 0; i < count; ++i) {
+        if (!strcmp(name, "date-and-time")) {
+            sprintf(val, "%04" PRIu32 "-%02" PRIu32 "-%02" PRIu32 "T%02" PRIu32 ":%02" PRIu32 ":%02" PRIu32 ".%06" PRIu32 "Z",
+                    1970 + i % 100, 1 + i % 12, 1 + i % 28, i % 24, i % 60, i / 60 % 60, i % 1000000);
+        } else if (!strcmp(name, "ipv4-address")) {
+            sprintf(val, "10.%" PRIu32 ".%" PRIu32 ".%" PRIu32, (i >> 16) & 0xff, (i >> 8) & 0xff, i & 0xff);
+        } else {
+            sprintf(val, "2001:DB8:0:%" PRIx32 "::%" PRIx32 ":%" PRIx32, i >> 16, i & 0xffff, (i * 7) & 0xffff);
+        }
+
+        if ((ret = lyd_new_term(*data, NULL, name, val, 0, NULL))) {
+            return ret;
+        }
+    }
+
+    return LY_SUCCESS;
+}
+
+/**
+ * @brief Create a context with several standard modules.
+ *
+ * @param[out] ctx Created context.
+ * @return LY_ERR value.
+ */
+static LY_ERR
+create_std_ctx(struct ly_ctx **ctx)
+{
+    LY_ERR ret;
+    const char *modules[] = {"ietf-netconf", "ietf-netconf-nmda", "ietf-netconf-acm", "ietf-ip", "ietf-restconf",
+        "notifications"};
+    const char *all_f[] = {"*", NULL};
+    uint32_t i;
+
+    if ((ret = ly_ctx_new(TESTS_DIR_MODULES_YANG, 0, ctx))) {
+        return ret;
+    }
+
+    for (i = 0; i < sizeof modules / sizeof *modules; ++i) {
+        if (!ly_ctx_load_module(*ctx, modules[i], NULL, all_f)) {
+            return LY_ENOTFOUND;
+        }
+    }
+
+    return LY_SUCCESS;
+}
+
 /**
  * @brief Execute a test.
  *
@@ -244,6 +432,86 @@ setup_data_single_tree(const struct lys_module *mod, uint32_t count, struct test
     return create_list_inst(mod, 0, count, &state->data1);
 }
 
+static LY_ERR
+setup_data_strings(const struct lys_module *mod, uint32_t count, struct test_state *state)
+{
+    state->mod = mod;
+    state->count = count;
+
+    return create_string_inst(mod, count, &state->data1);
+}
+
+static LY_ERR
+setup_data_descendant(const struct lys_module *mod, uint32_t count, struct test_state *state)
+{
+    LY_ERR ret;
+    struct lyd_node *node;
+
+    state->mod = mod;
+    state->count = count;
+
+    if ((ret = create_list_inst(mod, 0, count, &state->data1))) {
+        return ret;
+    }
+
+    /* single node in another subtree */
+    if ((ret = lyd_new_path(NULL, mod->ctx, "/perf:userord/ulst[k='1']", NULL, 0, &node))) {
+        return ret;
+    }
+    return lyd_insert_sibling(state->data1, node, NULL);
+}
+
+static LY_ERR
+setup_data_must(const struct lys_module *mod, uint32_t count, struct test_state *state)
+{
+    LY_ERR ret;
+
+    state->mod = mod;
+    state->count = count;
+
+    if ((ret = create_must_inst(mod, count, &state->data1))) {
+        return ret;
+    }
+
+    /* validate the new nodes so that only the must conditions are evaluated by the test */
+    return lyd_validate_all(&state->data1, NULL, LYD_VALIDATE_PRESENT, NULL);
+}
+
+static LY_ERR
+setup_data_index(const struct lys_module *mod, uint32_t count, struct test_state *state)
+{
+    LY_ERR ret;
+    struct lyd_node *list;
+    uint32_t i;
+    char k_val[32], l_val[32];
+
+    state->mod = mod;
+    state->count = count;
+
+    /* the index needs to exist before the data */
+    if ((ret = ly_ctx_set_index(mod->ctx, "/perf:index/ilst/l", 0))) {
+        return ret;
+    }
+
+    if ((ret = lyd_new_inner(NULL, mod, "index", 0, &state->data1))) {
+        return ret;
+    }
+
+    for (i = 0; i < count; ++i) {
+        sprintf(k_val, "%" PRIu32, i);
+        sprintf(l_val, "l%" PRIu32, i);
+
+        if ((ret = lyd_new_list(state->data1, NULL, "ilst", 0, &list, k_val))) {
+            return ret;
+        }
+        if ((ret = lyd_new_term(list, NULL, "l", l_val, 0, NULL))) {
+            return ret;
+        }
+    }
+
+    return LY_SUCCESS;
+}
+
 static LY_ERR
 setup_data_same_trees(const struct lys_module *mod, uint32_t count, struct test_state *state)
 {
@@ -298,6 +566,24 @@ setup_data_empty_and_full_trees(const struct lys_module *mod, uint32_t count, st
     return LY_SUCCESS;
 }
 
+static LY_ERR
+setup_data_userord_trees(const struct lys_module *mod, uint32_t count, struct test_state *state)
+{
+    LY_ERR ret;
+
+    state->mod = mod;
+    state->count = count;
+
+    if ((ret = create_userord_inst(mod, count, 0, &state->data1))) {
+        return ret;
+    }
+    if ((ret = create_userord_inst(mod, count, 1, &state->data2))) {
+        return ret;
+    }
+
+    return LY_SUCCESS;
+}
+
 static LY_ERR
 setup_data_offset_tree(const struct lys_module *mod, uint32_t count, struct test_state *state)
 {
@@ -367,6 +653,68 @@ test_create_new_bin(struct test_state *state, struct timespec *ts_start, struct
     return LY_SUCCESS;
 }
 
+static LY_ERR
+test_create_top_level(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    LY_ERR r;
+    struct lyd_node *data = NULL, *list;
+    uint32_t i;
+    char k_val[32];
+
+    TEST_START(ts_start);
+
+    for (i = 0; i < state->count; ++i) {
+        sprintf(k_val, "%" PRIu32, i);
+
+        if ((r = lyd_new_list(NULL, state->mod, "toplst", 0, &list, k_val))) {
+            return r;
+        }
+        if ((r = lyd_insert_sibling(data, list, &data))) {
+            return r;
+        }
+    }
+
+    TEST_END(ts_end);
+
+    lyd_free_siblings(data);
+
+    return LY_SUCCESS;
+}
+
+static LY_ERR
+test_create_unsorted(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    LY_ERR r;
+    struct lyd_node *data = NULL, *list;
+    uint32_t i, k;
+    char lfl_val[32];
+
+    TEST_START(ts_start);
+
+    if ((r = lyd_new_inner(NULL, state->mod, "cont", 0, &data))) {
+        return r;
+    }
+    if ((r = lyd_new_list(data, NULL, "lst", 0, &list, "0", "str0"))) {
+        return r;
+    }
+
+    for (i = 0; i < state->count; ++i) {
+        /* permutation of the values, 2654435761 is a prime */
+        k = (uint32_t)(((uint64_t)i * 2654435761U) % state->count);
+        sprintf(lfl_val, "%" PRIu32, k);
+
+        if ((r = lyd_new_term(list, NULL, "lfl", lfl_val, 0, NULL))) {
+            return r;
+        }
+    }
+
+    TEST_END(ts_end);
+
+    lyd_free_siblings(data);
+
+    return LY_SUCCESS;
+}
+
 static LY_ERR
 test_create_path(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
 {
@@ -510,6 +858,50 @@ test_parse_lyb_file_no_validate(struct test_state *state, struct timespec *ts_st
     return _test_parse(state, LYD_LYB, 1, 0, LYD_PARSE_STRICT | LYD_PARSE_ONLY | LYD_PARSE_ORDERED, 0, ts_start, ts_end);
 }
 
+static LY_ERR
+_test_parse_filter(struct test_state *state, LYD_FORMAT format, struct timespec *ts_start, struct timespec *ts_end)
+{
+    LY_ERR ret = LY_SUCCESS;
+    struct lyd_node *data = NULL;
+    char *buf = NULL, path[64];
+    struct ly_in *in = NULL;
+
+    sprintf(path, "/perf:cont/lst[k1=%" PRIu32 " and k2='str%" PRIu32 "']", state->count / 2, state->count / 2);
+
+    if ((ret = lyd_print_mem(&buf, state->data1, format, LYD_PRINT_SHRINK))) {
+        goto cleanup;
+    }
+    if ((ret = ly_in_new_memory(buf, &in))) {
+        goto cleanup;
+    }
+
+    TEST_START(ts_start);
+
+    if ((ret = lyd_parse_data_filter(state->mod->ctx, in, format, LYD_PARSE_STRICT, path, &data))) {
+        goto cleanup;
+    }
+
+    TEST_END(ts_end);
+
+cleanup:
+    free(buf);
+    ly_in_free(in, 0);
+    lyd_free_siblings(data);
+    return ret;
+}
+
+static LY_ERR
+test_parse_xml_filter(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    return _test_parse_filter(state, LYD_XML, ts_start, ts_end);
+}
+
+static LY_ERR
+test_parse_json_filter(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    return _test_parse_filter(state, LYD_JSON, ts_start, ts_end);
+}
+
 static LY_ERR
 _test_print(struct test_state *state, LYD_FORMAT format, uint32_t print_options, struct timespec *ts_start,
         struct timespec *ts_end)
@@ -548,6 +940,161 @@ test_print_lyb(struct test_state *state, struct timespec *ts_start, struct times
     return _test_print(state, LYD_LYB, LYD_PRINT_SHRINK, ts_start, ts_end);
 }
 
+static LY_ERR
+_test_print_fd(struct test_state *state, LYD_FORMAT format, ly_bool iov, struct timespec *ts_start,
+        struct timespec *ts_end)
+{
+    LY_ERR ret = LY_SUCCESS;
+    struct ly_out *out = NULL;
+    int fd;
+
+    if ((fd = open(TEMP_FILE, O_WRONLY | O_CREAT | O_TRUNC, 0600)) == -1) {
+        return LY_ESYS;
+    }
+    if ((ret = iov ? ly_out_new_fd_iov(fd, &out) : ly_out_new_fd(fd, &out))) {
+        close(fd);
+        return ret;
+    }
+
+    TEST_START(ts_start);
+
+    if ((ret = lyd_print_all(out, state->data1, format, LYD_PRINT_SHRINK))) {
+        goto cleanup;
+    }
+
+    TEST_END(ts_end);
+
+cleanup:
+    ly_out_free(out, NULL, 1);
+    return ret;
+}
+
+static LY_ERR
+test_print_xml_fd(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    return _test_print_fd(state, LYD_XML, 0, ts_start, ts_end);
+}
+
+static LY_ERR
+test_print_xml_fd_iov(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    return _test_print_fd(state, LYD_XML, 1, ts_start, ts_end);
+}
+
+static LY_ERR
+test_print_json_fd(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    return _test_print_fd(state, LYD_JSON, 0, ts_start, ts_end);
+}
+
+static LY_ERR
+test_print_json_fd_iov(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    return _test_print_fd(state, LYD_JSON, 1, ts_start, ts_end);
+}
+
+static LY_ERR
+_test_store_type(struct test_state *state, const char *name, struct timespec *ts_start, struct timespec *ts_end)
+{
+    LY_ERR r;
+    struct lyd_node *data = NULL;
+
+    TEST_START(ts_start);
+
+    if ((r = create_type_inst(state->mod, name, state->count, &data))) {
+        return r;
+    }
+
+    TEST_END(ts_end);
+
+    lyd_free_siblings(data);
+
+    return LY_SUCCESS;
+}
+
+static LY_ERR
+test_store_date_and_time(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    return _test_store_type(state, "date-and-time", ts_start, ts_end);
+}
+
+static LY_ERR
+test_store_ipv4_address(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    return _test_store_type(state, "ipv4-address", ts_start, ts_end);
+}
+
+static LY_ERR
+test_store_ipv6_address(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    return _test_store_type(state, "ipv6-address", ts_start, ts_end);
+}
+
+static LY_ERR
+_test_print_type(struct test_state *state, const char *name, struct timespec *ts_start, struct timespec *ts_end)
+{
+    LY_ERR ret;
+    struct lyd_node *data = NULL;
+    char *buf = NULL;
+
+    /* new data every time so that the canonical values are not cached */
+    if ((ret = create_type_inst(state->mod, name, state->count, &data))) {
+        goto cleanup;
+    }
+
+    TEST_START(ts_start);
+
+    if ((ret = lyd_print_mem(&buf, data, LYD_XML, LYD_PRINT_SHRINK))) {
+        goto cleanup;
+    }
+
+    TEST_END(ts_end);
+
+cleanup:
+    free(buf);
+    lyd_free_siblings(data);
+    return ret;
+}
+
+static LY_ERR
+test_print_date_and_time(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    return _test_print_type(state, "date-and-time", ts_start, ts_end);
+}
+
+static LY_ERR
+test_print_ipv4_address(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    return _test_print_type(state, "ipv4-address", ts_start, ts_end);
+}
+
+static LY_ERR
+test_print_ipv6_address(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    return _test_print_type(state, "ipv6-address", ts_start, ts_end);
+}
+
+static LY_ERR
+test_ctx_new_modules(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    LY_ERR ret;
+    struct ly_ctx *ctx = NULL;
+
+    (void)state;
+
+    TEST_START(ts_start);
+
+    if ((ret = create_std_ctx(&ctx))) {
+        goto cleanup;
+    }
+
+    TEST_END(ts_end);
+
+cleanup:
+    ly_ctx_destroy(ctx);
+    return ret;
+}
+
 static LY_ERR
 test_dup(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
 {
@@ -646,6 +1193,91 @@ test_xpath_find_hash(struct test_state *state, struct timespec *ts_start, struct
     return LY_SUCCESS;
 }
 
+static LY_ERR
+test_xpath_find_descendant(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    LY_ERR r;
+    struct ly_set *set;
+
+    TEST_START(ts_start);
+
+    if ((r = lyd_find_xpath(state->data1, "//perf:ulst", &set))) {
+        return r;
+    }
+
+    TEST_END(ts_end);
+
+    ly_set_free(set, NULL);
+
+    return LY_SUCCESS;
+}
+
+static LY_ERR
+test_xpath_find_leaf(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    LY_ERR r;
+    struct ly_set *set;
+    char path[64];
+
+    sprintf(path, "/perf:cont/lst[l='l%" PRIu32 "']", state->count / 2);
+
+    TEST_START(ts_start);
+
+    if ((r = lyd_find_xpath(state->data1, path, &set))) {
+        return r;
+    }
+
+    TEST_END(ts_end);
+
+    ly_set_free(set, NULL);
+
+    return LY_SUCCESS;
+}
+
+static LY_ERR
+test_xpath_find_func(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    LY_ERR r;
+    struct ly_set *set;
+    char path[96];
+
+    sprintf(path, "/perf:cont/lst[substring(l, 2) = '%" PRIu32 "' and string-length(l) > 1]", state->count / 2);
+
+    TEST_START(ts_start);
+
+    if ((r = lyd_find_xpath(state->data1, path, &set))) {
+        return r;
+    }
+
+    TEST_END(ts_end);
+
+    ly_set_free(set, NULL);
+
+    return LY_SUCCESS;
+}
+
+static LY_ERR
+test_xpath_find_index(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    LY_ERR r;
+    struct ly_set *set;
+    char path[64];
+
+    sprintf(path, "/perf:index/ilst[l='l%" PRIu32 "']", state->count / 2);
+
+    TEST_START(ts_start);
+
+    if ((r = lyd_find_xpath(state->data1, path, &set))) {
+        return r;
+    }
+
+    TEST_END(ts_end);
+
+    ly_set_free(set, NULL);
+
+    return LY_SUCCESS;
+}
+
 static LY_ERR
 test_compare_same(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
 {
@@ -700,6 +1332,25 @@ test_diff_no_same(struct test_state *state, struct timespec *ts_start, struct ti
     return LY_SUCCESS;
 }
 
+static LY_ERR
+test_diff_userord(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
+{
+    LY_ERR r;
+    struct lyd_node *diff;
+
+    TEST_START(ts_start);
+
+    if ((r = lyd_diff_siblings(state->data1, state->data2, 0, &diff))) {
+        return r;
+    }
+
+    TEST_END(ts_end);
+
+    lyd_free_siblings(diff);
+
+    return LY_SUCCESS;
+}
+
 static LY_ERR
 test_merge_same(struct test_state *state, struct timespec *ts_start, struct timespec *ts_end)
 {
@@ -766,10 +1417,14 @@ test_merge_no_same_destruct(struct test_state *state, struct timespec *ts_start,
 }
 
 struct test tests[] = {
+    {"context new modules", setup_basic, test_ctx_new_modules},
     {"create new text", setup_basic, test_create_new_text},
     {"create new bin", setup_basic, test_create_new_bin},
     {"create path", setup_basic, test_create_path},
+    {"create top-level", setup_basic, test_create_top_level},
+    {"create unsorted", setup_basic, test_create_unsorted},
     {"validate", setup_data_single_tree, test_validate},
+    {"validate must", setup_data_must, test_validate},
     {"parse xml mem validate", setup_data_single_tree, test_parse_xml_mem_validate},
     {"parse xml mem no validate", setup_data_single_tree, test_parse_xml_mem_no_validate},
     {"parse xml file no validate format", setup_data_single_tree, test_parse_xml_file_no_validate_format},
@@ -779,17 +1434,35 @@ struct test tests[] = {
     {"parse lyb mem validate", setup_data_single_tree, test_parse_lyb_mem_validate},
     {"parse lyb mem no validate", setup_data_single_tree, test_parse_lyb_mem_no_validate},
     {"parse lyb file no validate", setup_data_single_tree, test_parse_lyb_file_no_validate},
+    {"parse xml filter", setup_data_single_tree, test_parse_xml_filter},
+    {"parse json filter", setup_data_single_tree, test_parse_json_filter},
     {"print xml", setup_data_single_tree, test_print_xml},
     {"print json", setup_data_single_tree, test_print_json},
+    {"print json strings", setup_data_strings, test_print_json},
     {"print lyb", setup_data_single_tree, test_print_lyb},
+    {"print xml fd", setup_data_single_tree, test_print_xml_fd},
+    {"print xml fd iov", setup_data_single_tree, test_print_xml_fd_iov},
+    {"print json fd", setup_data_single_tree, test_print_json_fd},
+    {"print json fd iov", setup_data_single_tree, test_print_json_fd_iov},
+    {"store date-and-time", setup_basic, test_store_date_and_time},
+    {"print date-and-time", setup_basic, test_print_date_and_time},
+    {"store ipv4-address", setup_basic, test_store_ipv4_address},
+    {"print ipv4-address", setup_basic, test_print_ipv4_address},
+    {"store ipv6-address", setup_basic, test_store_ipv6_address},
+    {"print ipv6-address", setup_basic, test_print_ipv6_address},
     {"dup", setup_data_single_tree, test_dup},
     {"dup_siblings_to_empty", setup_data_empty_and_full_trees, test_dup_siblings_to_empty},
     {"free", setup_basic, test_free},
     {"xpath find", setup_data_single_tree, test_xpath_find},
     {"xpath find hash", setup_data_single_tree, test_xpath_find_hash},
+    {"xpath find descendant", setup_data_descendant, test_xpath_find_descendant},
+    {"xpath find leaf", setup_data_single_tree, test_xpath_find_leaf},
+    {"xpath find function", setup_data_single_tree, test_xpath_find_func},
+    {"xpath find index", setup_data_index, test_xpath_find_index},
     {"compare same", setup_data_same_trees, test_compare_same},
     {"diff same", setup_data_same_trees, test_diff_same},
     {"diff no same", setup_data_no_same_trees, test_diff_no_same},
+    {"diff user-ordered reordered", setup_data_userord_trees, test_diff_userord},
     {"merge same", setup_data_same_trees, test_merge_same},
     {"merge no same", setup_data_offset_tree, test_merge_no_same},
     {"merge no same destruct", setup_basic, test_merge_no_same_destruct},
@@ -15,6 +15,7 @@
 #include "utests.h"
 
 #include "context.h"
+#include "hash_table_internal.h"
 #include "in.h"
 #include "ly_common.h"
 #include "schema_compile.h"
@@ -770,6 +771,17 @@ test_ylmem(void **state)
     assert_non_null(ly_ctx_get_module(ctx_test, "ietf-netconf-acm", "2018-02-14"));
     assert_int_equal(0, ly_ctx_get_module(ctx_test, "ietf-netconf-acm", "2018-02-14")->implemented);
     assert_int_equal(LY_ENOT, lys_feature_value(ly_ctx_get_module(ctx_test, "ietf-netconf", "2011-06-01"), "url"));
+    assert_null(ctx_test->preparsed);
+    ly_ctx_destroy(ctx_test);
+    ctx_test = NULL;
+
+    /* the same into an existing context pre-parsing the modules in parallel */
+    assert_int_equal(LY_SUCCESS, ly_ctx_new(TESTS_SRC "/modules/yang/", 0, &ctx_test));
+    ly_ctx_set_compile_threads(ctx_test, 2);
+    assert_int_equal(LY_SUCCESS, ly_ctx_new_ylmem(TESTS_SRC "/modules/yang/", with_netconf, LYD_XML, 0, &ctx_test));
+    assert_int_equal(1, ly_ctx_get_module(ctx_test, "ietf-netconf", "2011-06-01")->implemented);
+    assert_int_equal(0, ly_ctx_get_module(ctx_test, "ietf-netconf-acm", "2018-02-14")->implemented);
+    assert_null(ctx_test->preparsed);
     ly_ctx_destroy(ctx_test);
     ctx_test = NULL;
 
@@ -1085,6 +1097,179 @@ test_explicit_compile(void **state)
     assert_non_null(mod);
 }
 
+static void
+test_parallel_compile(void **state)
+{
+    struct lys_module *mod;
+    const struct lysc_node *node;
+    struct lysc_type_leafref *lref;
+    const char *schema_t = "module t {namespace urn:tests:t;prefix t;"
+            "typedef str {type string {pattern '[a-z]+';}}}";
+    const char *schema_p1 = "module p1 {namespace urn:tests:p1;prefix p1;import t {prefix t;}"
+            "leaf l {type t:str;}}";
+    const char *schema_p2 = "module p2 {namespace urn:tests:p2;prefix p2;import t {prefix t;}"
+            "leaf l {type t:str;} leaf l2 {type t:str {length 1..5;}}}";
+    const char *schema_r = "module r {namespace urn:tests:r;prefix r;"
+            "container cont {leaf val {type string;}}}";
+    const char *schema_q = "module q {namespace urn:tests:q;prefix q;import r {prefix r;}"
+            "leaf ref {type leafref {path /r:cont/r:val;}}}";
+    const char *schema_e = "module e {namespace urn:tests:e;prefix e;"
+            "leaf ref {type leafref {path /e:missing;}}}";
+
+    /* use own context with all the modules compiled at once */
+    ly_ctx_destroy(UTEST_LYCTX);
+    assert_int_equal(LY_SUCCESS, ly_ctx_new(NULL, LY_CTX_EXPLICIT_COMPILE, &UTEST_LYCTX));
+    ly_ctx_set_module_imp_clb(UTEST_LYCTX, test_imp_clb, (void *)schema_r);
+
+    /* serial by default, compile in parallel even with fewer CPUs */
+    assert_int_equal(1, UTEST_LYCTX->compile_threads);
+    ly_ctx_set_compile_threads(UTEST_LYCTX, 4);
+
+    UTEST_ADD_MODULE(schema_t, LYS_IN_YANG, NULL, NULL);
+    UTEST_ADD_MODULE(schema_p1, LYS_IN_YANG, NULL, NULL);
+    UTEST_ADD_MODULE(schema_q, LYS_IN_YANG, NULL, NULL);
+    UTEST_ADD_MODULE(schema_p2, LYS_IN_YANG, NULL, NULL);
+    assert_int_equal(LY_SUCCESS, ly_ctx_compile(UTEST_LYCTX));
+
+    /* the shared typedef */
+    node = lys_find_path(UTEST_LYCTX, NULL, "/p1:l", 0);
+    assert_non_null(node);
+    assert_int_equal(LY_TYPE_STRING, ((struct lysc_node_leaf *)node)->type->basetype);
+    node = lys_find_path(UTEST_LYCTX, NULL, "/p2:l", 0);
+    assert_non_null(node);
+    assert_int_equal(1, LY_ARRAY_COUNT(((struct lysc_type_str *)((struct lysc_node_leaf *)node)->type)->patterns));
+    node = lys_find_path(UTEST_LYCTX, NULL, "/p2:l2", 0);
+    assert_non_null(node);
+    assert_non_null(((struct lysc_type_str *)((struct lysc_node_leaf *)node)->type)->length);
+
+    /* module implemented when resolving the unres */
+    mod = ly_ctx_get_module_implemented(UTEST_LYCTX, "r");
+    assert_non_null(mod);
+    assert_non_null(mod->compiled);
+    node = lys_find_path(UTEST_LYCTX, NULL, "/q:ref", 0);
+    assert_non_null(node);
+    lref = (struct lysc_type_leafref *)((struct lysc_node_leaf *)node)->type;
+    assert_int_equal(LY_TYPE_STRING, lref->realtype->basetype);
+
+    /* nothing left to compile */
+    assert_int_equal(LY_SUCCESS, ly_ctx_compile(UTEST_LYCTX));
+
+    /* errors are logged as if compiled serially and all the changes reverted */
+    UTEST_ADD_MODULE(schema_e, LYS_IN_YANG, NULL, NULL);
+    assert_int_equal(LY_EVALID, ly_ctx_compile(UTEST_LYCTX));
+    CHECK_LOG_CTX("Not found node \"missing\" in path.", "/e:ref", 0);
+    assert_null(ly_ctx_get_module_implemented(UTEST_LYCTX, "e"));
+    assert_non_null(ly_ctx_get_module_implemented(UTEST_LYCTX, "q")->compiled);
+
+    /* the error records of the compile threads are removed, only the one of this thread is left */
+    assert_int_equal(1, UTEST_LYCTX->err_ht->used);
+}
+
+static void
+test_search_index_write(const char *dir, const char *fname, const char *data)
+{
+    char path[PATH_MAX];
+    FILE *f;
+
+    snprintf(path, sizeof path, "%s/%s", dir, fname);
+    assert_non_null(f = fopen(path, "w"));
+    fputs(data, f);
+    fclose(f);
+}
+
+static void
+test_search_index_rm(const char *dir, const char *fname)
+{
+    char path[PATH_MAX];
+
+    snprintf(path, sizeof path, "%s/%s", dir, fname);
+    unlink(path);
+}
+
+static void
+test_search_index(void **UNUSED(state))
+{
+    struct ly_ctx *ctx;
+    const struct lys_module *mod;
+    char dir[] = TESTS_BIN "/utest_search_index_XXXXXX";
+
+    assert_non_null(mkdtemp(dir));
+    test_search_index_write(dir, "a@2020-01-01.yang", "module a {namespace urn:a; prefix a; revision 2020-01-01;}");
+    test_search_index_write(dir, "b.yang", "module b {namespace urn:b; prefix b; import a {prefix a;}}");
+
+    assert_int_equal(LY_SUCCESS, ly_ctx_new(dir, LY_CTX_DISABLE_SEARCHDIR_CWD, &ctx));
+
+    /* the index is created by the first search */
+    assert_non_null(ly_ctx_load_module(ctx, "b", NULL, NULL));
+    assert_non_null(ctx->search_index);
+    assert_non_null(mod = ly_ctx_get_module_latest(ctx, "a"));
+    assert_string_equal("2020-01-01", mod->revision);
+
+    /* a file added into an indexed directory is found */
+    test_search_index_write(dir, "a@2021-01-01.yang", "module a {namespace urn:a; prefix a; revision 2021-01-01;}");
+    assert_non_null(mod = ly_ctx_load_module(ctx, "a", "2021-01-01", NULL));
+    assert_string_equal("2021-01-01", mod->revision);
+
+    /* not found after removing the search dir */
+    assert_int_equal(LY_SUCCESS, ly_ctx_unset_searchdir(ctx, dir));
+    assert_null(ctx->search_index);
+    assert_null(ly_ctx_load_module(ctx, "c", NULL, NULL));
+    ly_ctx_destroy(ctx);
+
+    test_search_index_rm(dir, "a@2020-01-01.yang");
+    test_search_index_rm(dir, "a@2021-01-01.yang");
+    test_search_index_rm(dir, "b.yang");
+    rmdir(dir);
+}
+
+static void
+test_free_parsed(void **state)
+{
+    struct lys_module *mod;
+    struct lyd_node *tree;
+    char *str;
+    const char *feats[] = {"f", NULL};
+    const char *schema = "module a {namespace urn:tests:a; prefix a; yang-version 1.1; feature f;"
+            "typedef t {type uint8 {range 1..10;}} grouping g {leaf l {type t;}}"
+            "container c {uses g; leaf-list ll {type leafref {path ../l;}}}}";
+
+    UTEST_ADD_MODULE(schema, LYS_IN_YANG, feats, &mod);
+    assert_int_equal(LY_SUCCESS, ly_ctx_free_parsed(UTEST_LYCTX));
+
+    /* only the statements needed by the context remain */
+    assert_null(mod->parsed->data);
+    assert_null(mod->parsed->groupings);
+    assert_null(mod->parsed->typedefs);
+    assert_non_null(mod->parsed->features);
+    assert_int_equal(LY_SUCCESS, lys_feature_value(mod, "f"));
+
+    /* data work the same */
+    CHECK_PARSE_LYD_PARAM("<c xmlns=\"urn:tests:a\"><l>5</l><ll>5</ll></c>", LYD_XML, 0, LYD_VALIDATE_PRESENT, LY_SUCCESS, tree);
+    lyd_free_all(tree);
+    CHECK_PARSE_LYD_PARAM("<c xmlns=\"urn:tests:a\"><l>11</l></c>", LYD_XML, 0, LYD_VALIDATE_PRESENT, LY_EVALID, tree);
+    CHECK_LOG_CTX("Unsatisfied range - value \"11\" is out of the allowed range.", "/a:c/l", 1);
+    assert_int_equal(LY_SUCCESS, ly_ctx_get_yanglib_data(UTEST_LYCTX, &tree, "%u", ly_ctx_get_change_count(UTEST_LYCTX)));
+    lyd_free_all(tree);
+
+    /* but the schemas cannot be printed or changed */
+    assert_int_equal(LY_SUCCESS, lys_print_mem(&str, mod, LYS_OUT_YANG_COMPILED, 0));
+    free(str);
+    assert_int_equal(LY_EINVAL, lys_print_mem(&str, mod, LYS_OUT_YANG, 0));
+    CHECK_LOG_CTX("Module \"a\" parsed module was freed.", NULL, 0);
+    assert_int_equal(LY_EDENIED, lys_set_implemented(mod, NULL));
+    CHECK_LOG_CTX("Unable to change module \"a\" in a context with freed parsed modules.", NULL, 0);
+    assert_int_equal(LY_EDENIED, lys_parse_mem(UTEST_LYCTX, "module b {namespace urn:tests:b; prefix b;}", LYS_IN_YANG, NULL));
+    CHECK_LOG_CTX("Unable to add new modules into a context with freed parsed modules.", NULL, 0);
+
+    /* the parsed nodes cannot be referenced anymore, the context stays usable */
+    assert_int_equal(LY_EDENIED, ly_ctx_set_options(UTEST_LYCTX, LY_CTX_SET_PRIV_PARSED));
+    CHECK_LOG_CTX("Unable to set LY_CTX_SET_PRIV_PARSED in a context with freed parsed modules.", NULL, 0);
+    assert_false(ly_ctx_get_options(UTEST_LYCTX) & LY_CTX_SET_PRIV_PARSED);
+    assert_false(mod->to_compile);
+    CHECK_PARSE_LYD_PARAM("<c xmlns=\"urn:tests:a\"><l>5</l></c>", LYD_XML, 0, LYD_VALIDATE_PRESENT, LY_SUCCESS, tree);
+    lyd_free_all(tree);
+}
+
 int
 main(void)
 {
@@ -1097,6 +1282,9 @@ main(void)
         UTEST(test_ylmem),
         UTEST(test_set_priv_parsed),
         UTEST(test_explicit_compile),
+        UTEST(test_parallel_compile),
+        UTEST(test_search_index),
+        UTEST(test_free_parsed),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
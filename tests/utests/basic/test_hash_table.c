@@ -247,6 +247,36 @@ test_ht_collisions(void **UNUSED(state))
     lyht_free(ht, NULL);
 }
 
+static void
+test_ht_dup(void **UNUSED(state))
+{
+    uint32_t i;
+    struct ly_ht *ht, *dup;
+
+    assert_non_null(ht = lyht_new(8, sizeof(int), ht_equal_clb, NULL, 0));
+    for (i = 0; i < 3; ++i) {
+        assert_int_equal(lyht_insert(ht, &i, i, NULL), LY_SUCCESS);
+    }
+
+    /* the duplicate must not reuse the records that are already in use */
+    assert_non_null(dup = lyht_dup(ht));
+    for (i = 3; i < 6; ++i) {
+        assert_int_equal(lyht_insert(dup, &i, i, NULL), LY_SUCCESS);
+    }
+    assert_int_equal(dup->used, 6);
+    for (i = 0; i < 6; ++i) {
+        assert_int_equal(LY_SUCCESS, lyht_find(dup, &i, i, NULL));
+    }
+
+    /* the original is not affected */
+    for (i = 0; i < 6; ++i) {
+        assert_int_equal(i < 3 ? LY_SUCCESS : LY_ENOTFOUND, lyht_find(ht, &i, i, NULL));
+    }
+
+    lyht_free(dup, NULL);
+    lyht_free(ht, NULL);
+}
+
 int
 main(void)
 {
@@ -256,6 +286,7 @@ main(void)
         UTEST(test_ht_basic),
         UTEST(test_ht_resize),
         UTEST(test_ht_collisions),
+        UTEST(test_ht_dup),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
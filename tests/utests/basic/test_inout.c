@@ -25,6 +25,7 @@
 #include "log.h"
 #include "ly_common.h"
 #include "out.h"
+#include "out_internal.h"
 
 #define TEST_INPUT_FILE TESTS_BIN "/libyang_test_input"
 #define TEST_OUTPUT_FILE TESTS_BIN "/libyang_test_output"
@@ -388,6 +389,137 @@ test_output_clb(void **UNUSED(state))
     ly_out_free(out, close_clb, 0);
 }
 
+static void
+test_output_fd_iov(void **UNUSED(state))
+{
+    struct ly_out *out = NULL;
+    int fd1, fd2;
+    uint32_t i;
+    char buf[31] = {0}, ref[100], *big, *expected, *result;
+    size_t len;
+
+    assert_int_not_equal(-1, fd1 = open(TEST_OUTPUT_FILE, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR));
+    assert_int_not_equal(-1, fd2 = open(TEST_OUTPUT_FILE, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR));
+
+    /* manipulate with the handler */
+    assert_int_equal(LY_SUCCESS, ly_out_new_fd_iov(fd1, &out));
+    assert_int_equal(LY_OUT_FD_IOV, ly_out_type(out));
+    assert_ptr_equal(fd1, ly_out_fd(out, fd2));
+    assert_ptr_equal(fd2, ly_out_fd(out, -1));
+    assert_ptr_equal(fd2, ly_out_fd(out, fd1));
+    ly_out_free(out, NULL, 0);
+    assert_int_equal(0, close(fd2));
+    assert_int_equal(LY_SUCCESS, ly_out_new_fd_iov(fd1, &out));
+    ly_out_free(out, NULL, 1);
+
+    /* writing data */
+    assert_int_not_equal(-1, fd1 = open(TEST_OUTPUT_FILE, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR));
+    assert_int_not_equal(-1, fd2 = open(TEST_OUTPUT_FILE, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR));
+    /* truncate file to start with no data */
+    assert_int_equal(0, ftruncate(fd1, 0));
+
+    assert_int_equal(LY_SUCCESS, ly_out_new_fd_iov(fd1, &out));
+    assert_int_equal(LY_SUCCESS, ly_print(out, "test %s", "print"));
+    assert_int_equal(10, ly_out_printed(out));
+    /* nothing written before flushing */
+    assert_int_equal(0, read(fd2, buf, 30));
+    ly_print_flush(out);
+    assert_int_equal(10, read(fd2, buf, 30));
+    assert_string_equal("test print", buf);
+    assert_int_equal(0, lseek(fd2, 0, SEEK_SET));
+    assert_int_equal(LY_SUCCESS, ly_out_reset(out));
+
+    assert_int_equal(LY_SUCCESS, ly_write(out, "rewrite", 8));
+    assert_int_equal(8, ly_out_printed(out));
+    ly_print_flush(out);
+    assert_int_equal(8, read(fd2, buf, 30));
+    assert_string_equal("rewrite", buf);
+    assert_int_equal(0, lseek(fd2, 0, SEEK_SET));
+    assert_int_equal(LY_SUCCESS, ly_out_reset(out));
+
+    /* many copied and referenced chunks and a chunk too long to be copied */
+    memset(ref, 'r', sizeof ref);
+    assert_non_null(big = malloc(20000));
+    memset(big, 'b', 20000);
+    assert_non_null(expected = malloc(1000 * (2 + sizeof ref) + 20000));
+    len = 0;
+    for (i = 0; i < 1000; ++i) {
+        assert_int_equal(LY_SUCCESS, ly_write_(out, "ab", 2));
+        memcpy(expected + len, "ab", 2);
+        len += 2;
+        assert_int_equal(LY_SUCCESS, ly_write_ref_(out, ref, sizeof ref));
+        memcpy(expected + len, ref, sizeof ref);
+        len += sizeof ref;
+    }
+    assert_int_equal(LY_SUCCESS, ly_write_(out, big, 20000));
+    memcpy(expected + len, big, 20000);
+    len += 20000;
+    ly_print_flush(out);
+
+    assert_non_null(result = malloc(len + 1));
+    assert_int_equal(len, read(fd2, result, len + 1));
+    assert_int_equal(0, memcmp(expected, result, len));
+
+    free(big);
+    free(expected);
+    free(result);
+    close(fd2);
+    ly_out_free(out, NULL, 1);
+}
+
+static uint32_t writev_clb_calls;
+
+static ssize_t
+writev_clb(void *user_data, const struct iovec *iov, int iovcnt)
+{
+    ++writev_clb_calls;
+    return writev((uintptr_t)user_data, iov, iovcnt);
+}
+
+static void
+test_output_clb_iov(void **UNUSED(state))
+{
+    struct ly_out *out = NULL;
+    int fd1, fd2;
+    char buf[31] = {0};
+
+    assert_int_not_equal(-1, fd1 = open(TEST_OUTPUT_FILE, O_RDWR));
+    assert_int_not_equal(-1, fd2 = open(TEST_OUTPUT_FILE, O_RDWR));
+
+    /* manipulate with the handler */
+    assert_int_equal(LY_SUCCESS, ly_out_new_clb_iov(writev_clb, (void *)(intptr_t)fd1, &out));
+    assert_int_equal(LY_OUT_CALLBACK_IOV, ly_out_type(out));
+    assert_ptr_equal(fd1, ly_out_clb_arg(out, (void *)(intptr_t)fd2));
+    assert_ptr_equal(fd2, ly_out_clb_arg(out, NULL));
+    assert_ptr_equal(fd2, ly_out_clb_arg(out, (void *)(intptr_t)fd1));
+    ly_out_free(out, NULL, 0);
+    assert_int_equal(0, close(fd2));
+    assert_int_equal(LY_SUCCESS, ly_out_new_clb_iov(writev_clb, (void *)(intptr_t)fd1, &out));
+    ly_out_free(out, close_clb, 0);
+
+    /* writing data */
+    assert_int_not_equal(-1, fd1 = open(TEST_OUTPUT_FILE, O_RDWR));
+    assert_int_not_equal(-1, fd2 = open(TEST_OUTPUT_FILE, O_RDWR));
+    /* truncate file to start with no data */
+    assert_int_equal(0, ftruncate(fd1, 0));
+
+    writev_clb_calls = 0;
+    assert_int_equal(LY_SUCCESS, ly_out_new_clb_iov(writev_clb, (void *)(intptr_t)fd1, &out));
+    assert_int_equal(LY_SUCCESS, ly_print(out, "test %s", "print"));
+    assert_int_equal(10, ly_out_printed(out));
+    assert_int_equal(LY_SUCCESS, ly_write(out, " again", 6));
+    assert_int_equal(0, writev_clb_calls);
+
+    /* all the pending data written at once */
+    ly_print_flush(out);
+    assert_int_equal(1, writev_clb_calls);
+    assert_int_equal(16, read(fd2, buf, 30));
+    assert_string_equal("test print again", buf);
+
+    close(fd2);
+    ly_out_free(out, close_clb, 0);
+}
+
 int
 main(void)
 {
@@ -401,6 +533,8 @@ main(void)
         UTEST(test_output_file, setup_files, teardown_files),
         UTEST(test_output_filepath, setup_files, teardown_files),
         UTEST(test_output_clb, setup_files, teardown_files),
+        UTEST(test_output_fd_iov, setup_files, teardown_files),
+        UTEST(test_output_clb_iov, setup_files, teardown_files),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
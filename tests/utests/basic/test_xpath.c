@@ -661,6 +661,49 @@ test_derived_from(void **state)
     lyd_free_all(tree);
 }
 
+static void
+test_re_match(void **state)
+{
+    const char *data =
+            "<l1 xmlns=\"urn:tests:a\"><a>a1</a><b>b1</b><c>abc</c></l1>"
+            "<l1 xmlns=\"urn:tests:a\"><a>a2</a><b>b2</b><c>x9</c></l1>"
+            "<l1 xmlns=\"urn:tests:a\"><a>a3</a><b>b3</b><c>9x</c></l1>";
+    struct lyd_node *tree;
+    struct ly_set *set;
+    uint32_t hits, misses;
+
+    assert_int_equal(LY_SUCCESS, lyd_parse_data_mem(UTEST_LYCTX, data, LYD_XML, LYD_PARSE_STRICT, LYD_VALIDATE_PRESENT, &tree));
+    assert_non_null(tree);
+
+    /* pattern compiled once for all the instances */
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/a:l1[re-match(c, '[a-z]+[0-9]*')]", &set));
+    assert_int_equal(2, set->count);
+    ly_set_free(set, NULL);
+    ly_ctx_get_re_cache_stats(UTEST_LYCTX, &hits, &misses);
+    assert_int_equal(2, hits);
+    assert_int_equal(1, misses);
+
+    /* cached pattern reused by another evaluation */
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/a:l1[not(re-match(c, '[a-z]+[0-9]*'))]", &set));
+    assert_int_equal(1, set->count);
+    ly_set_free(set, NULL);
+    ly_ctx_get_re_cache_stats(UTEST_LYCTX, &hits, &misses);
+    assert_int_equal(5, hits);
+    assert_int_equal(1, misses);
+
+    /* pattern from the data */
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/a:l1[re-match(c, ../a:foo)]", &set));
+    assert_int_equal(0, set->count);
+    ly_set_free(set, NULL);
+
+    /* invalid pattern */
+    assert_int_equal(LY_EVALID, lyd_find_xpath(tree, "/a:l1[re-match(c, '[a-')]", &set));
+    CHECK_LOG_CTX("Regular expression \"[a-\" is not valid (\"\": missing terminating ] for character class).",
+            "/a:l1[a='a1'][b='b1']", 0);
+
+    lyd_free_all(tree);
+}
+
 static void
 test_augment(void **state)
 {
@@ -1096,7 +1139,7 @@ static void
 test_trim(void **state)
 {
     const char *data;
-    char *str1;
+    char *str1, *str2;
     struct lyd_node *tree;
 
     data =
@@ -1238,6 +1281,275 @@ test_trim(void **state)
 
     free(str1);
     lyd_free_all(tree);
+
+    /* trim #4, the results share parents and nothing is trimmed */
+    assert_int_equal(LY_SUCCESS, lyd_parse_data_mem(UTEST_LYCTX, data, LYD_XML, LYD_PARSE_STRICT, LYD_VALIDATE_PRESENT, &tree));
+    assert_non_null(tree);
+    lyd_print_mem(&str2, tree, LYD_XML, LYD_PRINT_WITHSIBLINGS);
+
+    assert_int_equal(LY_SUCCESS, lyd_trim_xpath(&tree, "/a:l1 | /a:foo2 | /a:c/x | /a:c/ll/ll", NULL));
+    lyd_print_mem(&str1, tree, LYD_XML, LYD_PRINT_WITHSIBLINGS);
+    assert_string_equal(str1, str2);
+
+    free(str1);
+    free(str2);
+    lyd_free_all(tree);
+}
+
+static void
+test_descendant_schema(void **state)
+{
+    const char *schema_d =
+            "module d {\n"
+            "    namespace urn:tests:d;\n"
+            "    prefix d;\n"
+            "    yang-version 1.1;\n"
+            "\n"
+            "    container top {\n"
+            "        container big {\n"
+            "            list item {\n"
+            "                key \"k\";\n"
+            "                leaf k {\n"
+            "                    type string;\n"
+            "                }\n"
+            "            }\n"
+            "        }\n"
+            "        choice ch {\n"
+            "            container inner {\n"
+            "                leaf target {\n"
+            "                    type string;\n"
+            "                }\n"
+            "            }\n"
+            "        }\n"
+            "        list ops {\n"
+            "            key \"k\";\n"
+            "            leaf k {\n"
+            "                type string;\n"
+            "            }\n"
+            "            action act {\n"
+            "                input {\n"
+            "                    leaf target {\n"
+            "                        type string;\n"
+            "                    }\n"
+            "                }\n"
+            "            }\n"
+            "        }\n"
+            "    }\n"
+            "}";
+    const char *schema_d2 =
+            "module d2 {\n"
+            "    namespace urn:tests:d2;\n"
+            "    prefix d2;\n"
+            "    yang-version 1.1;\n"
+            "\n"
+            "    import d {\n"
+            "        prefix d;\n"
+            "    }\n"
+            "\n"
+            "    augment /d:top/d:big/d:item {\n"
+            "        leaf target {\n"
+            "            type string;\n"
+            "        }\n"
+            "    }\n"
+            "}";
+    const char *data =
+            "<top xmlns=\"urn:tests:d\">\n"
+            "  <big>\n"
+            "    <item><k>a</k></item>\n"
+            "    <item><k>b</k><target xmlns=\"urn:tests:d2\">x</target></item>\n"
+            "    <item><k>c</k><target xmlns=\"urn:tests:d2\">y</target></item>\n"
+            "  </big>\n"
+            "  <inner>\n"
+            "    <target>z</target>\n"
+            "  </inner>\n"
+            "</top>\n";
+    struct lyd_node *tree, *op;
+    struct ly_set *set;
+
+    UTEST_ADD_MODULE(schema_d, LYS_IN_YANG, NULL, NULL);
+    UTEST_ADD_MODULE(schema_d2, LYS_IN_YANG, NULL, NULL);
+
+    assert_int_equal(LY_SUCCESS, lyd_parse_data_mem(UTEST_LYCTX, data, LYD_XML, LYD_PARSE_STRICT, LYD_VALIDATE_PRESENT, &tree));
+    assert_non_null(tree);
+
+    /* the node in a choice is found, augmented nodes of the same name are not */
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "//d:target", &set));
+    assert_int_equal(1, set->count);
+    assert_string_equal("z", lyd_get_value(set->dnodes[0]));
+    ly_set_free(set, NULL);
+
+    /* augmented nodes */
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "//d2:target", &set));
+    assert_int_equal(2, set->count);
+    ly_set_free(set, NULL);
+
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "//d2:*", &set));
+    assert_int_equal(2, set->count);
+    ly_set_free(set, NULL);
+
+    /* no matching schema node */
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/d:top/d:big//d:inner", &set));
+    assert_int_equal(0, set->count);
+    ly_set_free(set, NULL);
+
+    lyd_free_all(tree);
+
+    /* action input */
+    assert_int_equal(LY_SUCCESS, lyd_new_path(NULL, UTEST_LYCTX, "/d:top/ops[k='a']/act/target", "t", 0, &op));
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(op, "//d:target", &set));
+    assert_int_equal(1, set->count);
+    assert_string_equal("t", lyd_get_value(set->dnodes[0]));
+    ly_set_free(set, NULL);
+    lyd_free_all(op);
+}
+
+static void
+test_set_pool(void **state)
+{
+    const struct lys_module *mod;
+    struct lyd_node *tree;
+    struct ly_set *set;
+    char buf[16];
+    int i;
+
+    mod = ly_ctx_get_module_implemented(UTEST_LYCTX, "a");
+    assert_int_equal(LY_SUCCESS, lyd_new_inner(NULL, mod, "c", 0, &tree));
+    assert_int_equal(LY_SUCCESS, lyd_new_term(tree, NULL, "x", "val", 0, NULL));
+    for (i = 0; i < 40; ++i) {
+        sprintf(buf, "v%d", i);
+        assert_int_equal(LY_SUCCESS, lyd_new_term(tree, NULL, "ll2", buf, 0, NULL));
+    }
+
+    /* sets outgrowing the small pool storage */
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/a:c/ll2", &set));
+    assert_int_equal(40, set->count);
+    ly_set_free(set, NULL);
+
+    /* small and large sets in predicates reused for every instance */
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/a:c/ll2[position() mod 2 = 0][. != 'v9']", &set));
+    assert_int_equal(19, set->count);
+    ly_set_free(set, NULL);
+
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/a:c/ll2[count(../ll2) = 40][count(../ll2[. = 'v3'] | ../x) = 2]",
+            &set));
+    assert_int_equal(40, set->count);
+    ly_set_free(set, NULL);
+
+    /* unions of sets with hash tables */
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/a:c/ll2 | /a:c/x | /a:c/ll2[last()] | /a:c/ll2", &set));
+    assert_int_equal(41, set->count);
+    ly_set_free(set, NULL);
+
+    /* more function arguments than stored locally */
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/a:c/ll2[concat(., '-', ., '-', ., '-', .) = 'v7-v7-v7-v7']", &set));
+    assert_int_equal(1, set->count);
+    assert_string_equal(lyd_get_value(set->dnodes[0]), "v7");
+    ly_set_free(set, NULL);
+
+    lyd_free_all(tree);
+}
+
+static void
+test_parse_filter(void **state)
+{
+    const char *data =
+            "<l1 xmlns=\"urn:tests:a\"><a>a1</a><b>b1</b><c>c1</c></l1>"
+            "<l1 xmlns=\"urn:tests:a\"><a>a2</a><b>b2</b><c>c2</c></l1>"
+            "<foo2 xmlns=\"urn:tests:a\">50</foo2>"
+            "<c xmlns=\"urn:tests:a\">"
+            "  <x>key2</x>"
+            "  <ll><a>key1</a><ll><a>key11</a><b>val11</b></ll><ll><a>key12</a><b>val12</b></ll></ll>"
+            "  <ll><a>key2</a><ll><a>key21</a><b>val21</b></ll><ll><a>key22</a><b>val22</b></ll></ll>"
+            "  <ll2>v1</ll2><ll2>v2</ll2>"
+            "</c>";
+    const char *xpaths[] = {
+        "/a:c/ll/ll[a='key11']",
+        "/a:c/ll[a='key2']/ll/b",
+        "/a:c/ll/ll[b='val12' and a='key12'] | /a:foo2",
+        "/a:c//b",
+        "//a:ll[a='key21']",
+        "/a:l1[c='c2']/a:b",
+        "/a:c/ll2[.='v2']",
+        "/a:c/x | /a:c/ll2",
+        "/a:c/*/ll/a",
+        "/a:c/ll/ll[contains(.,'2')]",
+        "/a:c/ll[1]",
+        "/a:c/ll/ll[a=b] | /a:c/ll[a='key1']/ll[b=a or a='key12']",
+        "/a:c[ll2=ll2]/x | /a:c[x=ll2]/ll2 | /a:c/ll2[.=../ll2]",
+        "/a:c[ll2=ll2 and ll2='v2']/ll[ll/a=a]",
+        "/a:foo2[.='50'] | /a:foo2[.=50.0]",
+        "/a:foo"
+    };
+    struct lyd_node *tree;
+    struct ly_in *in;
+    char *json, *str1, *str2;
+    uint32_t i;
+
+    assert_int_equal(LY_SUCCESS, lyd_parse_data_mem(UTEST_LYCTX, data, LYD_XML, LYD_PARSE_ONLY, 0, &tree));
+    assert_int_equal(LY_SUCCESS, lyd_print_mem(&json, tree, LYD_JSON, LYD_PRINT_WITHSIBLINGS));
+    lyd_free_all(tree);
+
+    for (i = 0; i < sizeof xpaths / sizeof *xpaths; ++i) {
+        /* same results as parsing everything and trimming */
+        assert_int_equal(LY_SUCCESS, lyd_parse_data_mem(UTEST_LYCTX, data, LYD_XML, LYD_PARSE_ONLY, 0, &tree));
+        assert_int_equal(LY_SUCCESS, lyd_trim_xpath(&tree, xpaths[i], NULL));
+        assert_int_equal(LY_SUCCESS, lyd_print_mem(&str1, tree, LYD_XML, LYD_PRINT_WITHSIBLINGS));
+        lyd_free_all(tree);
+
+        assert_int_equal(LY_SUCCESS, ly_in_new_memory(data, &in));
+        assert_int_equal(LY_SUCCESS, lyd_parse_data_filter(UTEST_LYCTX, in, LYD_XML, 0, xpaths[i], &tree));
+        ly_in_free(in, 0);
+        CHECK_LOG_CTX(NULL, NULL, 0);
+        assert_int_equal(LY_SUCCESS, lyd_print_mem(&str2, tree, LYD_XML, LYD_PRINT_WITHSIBLINGS));
+        lyd_free_all(tree);
+        assert_string_equal(str1, str2);
+        free(str2);
+
+        assert_int_equal(LY_SUCCESS, ly_in_new_memory(json, &in));
+        assert_int_equal(LY_SUCCESS, lyd_parse_data_filter(UTEST_LYCTX, in, LYD_JSON, 0, xpaths[i], &tree));
+        ly_in_free(in, 0);
+        CHECK_LOG_CTX(NULL, NULL, 0);
+        assert_int_equal(LY_SUCCESS, lyd_print_mem(&str2, tree, LYD_XML, LYD_PRINT_WITHSIBLINGS));
+        lyd_free_all(tree);
+        assert_string_equal(str1, str2);
+        free(str2);
+
+        free(str1);
+    }
+    free(json);
+
+    /* invalid value in a skipped subtree is not parsed at all */
+    data = "<foo2 xmlns=\"urn:tests:a\">500</foo2><c xmlns=\"urn:tests:a\"><x>val</x></c>";
+    assert_int_equal(LY_SUCCESS, ly_in_new_memory(data, &in));
+    assert_int_equal(LY_SUCCESS, lyd_parse_data_filter(UTEST_LYCTX, in, LYD_XML, 0, "/a:c/x", &tree));
+    ly_in_free(in, 0);
+    CHECK_LYD_STRING_PARAM(tree,
+            "<c xmlns=\"urn:tests:a\">\n"
+            "  <x>val</x>\n"
+            "</c>\n", LYD_XML, LYD_PRINT_WITHSIBLINGS);
+    lyd_free_all(tree);
+
+    assert_int_equal(LY_SUCCESS, ly_in_new_memory(data, &in));
+    assert_int_equal(LY_EVALID, lyd_parse_data_filter(UTEST_LYCTX, in, LYD_XML, 0, "/a:c/x | //a:foo2", &tree));
+    ly_in_free(in, 0);
+    assert_null(tree);
+    CHECK_LOG_CTX("Value \"500\" is out of type uint8 min/max bounds.", "/a:foo2", 1);
+
+    data = "{\"a:foo2\":500,\"a:c\":{\"x\":\"val\"}}";
+    assert_int_equal(LY_SUCCESS, ly_in_new_memory(data, &in));
+    assert_int_equal(LY_SUCCESS, lyd_parse_data_filter(UTEST_LYCTX, in, LYD_JSON, 0, "/a:c/x", &tree));
+    ly_in_free(in, 0);
+    CHECK_LYD_STRING_PARAM(tree,
+            "<c xmlns=\"urn:tests:a\">\n"
+            "  <x>val</x>\n"
+            "</c>\n", LYD_XML, LYD_PRINT_WITHSIBLINGS);
+    lyd_free_all(tree);
+
+    /* invalid filter */
+    assert_int_equal(LY_SUCCESS, ly_in_new_memory(data, &in));
+    assert_int_equal(LY_EVALID, lyd_parse_data_filter(UTEST_LYCTX, in, LYD_XML, 0, "/a:c/x[", &tree));
+    ly_in_free(in, 0);
+    UTEST_LOG_CTX_CLEAN;
 }
 
 int
@@ -1253,10 +1565,14 @@ main(void)
         UTEST(test_atomize, setup),
         UTEST(test_canonize, setup),
         UTEST(test_derived_from, setup),
+        UTEST(test_re_match, setup),
         UTEST(test_augment, setup),
         UTEST(test_variables, setup),
         UTEST(test_axes, setup),
         UTEST(test_trim, setup),
+        UTEST(test_descendant_schema, setup),
+        UTEST(test_set_pool, setup),
+        UTEST(test_parse_filter, setup),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
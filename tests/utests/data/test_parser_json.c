@@ -123,6 +123,13 @@ test_leaf(void **state)
     CHECK_LYD_STRING(tree, LYD_PRINT_SHRINK | LYD_PRINT_WITHSIBLINGS | LYD_PRINT_WD_ALL_TAG, data);
     lyd_free_all(tree);
 
+    /* escaped characters among longer runs of characters */
+    assert_int_equal(LY_SUCCESS, lyd_new_term(NULL, ly_ctx_get_module_implemented(UTEST_LYCTX, "a"), "foo",
+            "\"quoted\" value\twith\\escaped characters\r\n among the rest\x7F", 0, &tree));
+    CHECK_LYD_STRING(tree, LYD_PRINT_SHRINK,
+            "{\"a:foo\":\"\\\"quoted\\\" value\\twith\\\\escaped characters\\r\\u000A among the rest\\u007F\"}");
+    lyd_free_all(tree);
+
     /* skip leaf */
     data = "{\"a:cp\":{\"x\":\"val\",\"y\":\"valy\",\"z\":5}}";
     CHECK_PARSE_LYD(data, 0, LYD_VALIDATE_PRESENT, tree);
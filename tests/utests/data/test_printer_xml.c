@@ -247,6 +247,45 @@ test_defaults(void **state)
     lyd_free_all(tree);
 }
 
+static void
+test_size(void **state)
+{
+    struct lyd_node *tree;
+    struct ly_out *out;
+    char *str, *buf;
+    size_t size;
+    LYD_FORMAT format;
+    const char *data =
+            "<int8 xmlns=\"urn:tests:types\">15</int8>"
+            "<str-norestr xmlns=\"urn:tests:types\">&lt;x&amp;y&gt;</str-norestr>"
+            "<list xmlns=\"urn:tests:types\"><id>a\"b</id><value>c</value></list>";
+
+    CHECK_PARSE_LYD(data, LYD_PARSE_ONLY, 0, tree);
+
+    for (format = LYD_XML; format <= LYD_LYB; ++format) {
+        assert_int_equal(LY_SUCCESS, lyd_print_size(tree, format, LYD_PRINT_WITHSIBLINGS, &size));
+        assert_true(size > 0);
+
+        /* pre-sized memory is not reallocated */
+        buf = malloc(size + 1);
+        assert_non_null(buf);
+        assert_int_equal(LY_SUCCESS, ly_out_new_memory(&buf, size + 1, &out));
+        str = buf;
+        assert_int_equal(LY_SUCCESS, lyd_print_all(out, tree, format, 0));
+        assert_int_equal(size, ly_out_printed(out));
+        assert_ptr_equal(str, buf);
+        if (format != LYD_LYB) {
+            assert_int_equal(size, strlen(buf));
+        }
+        ly_out_free(out, NULL, 1);
+    }
+
+    assert_int_equal(LY_EINVAL, lyd_print_size(tree, LYD_XML, 0, NULL));
+    CHECK_LOG_LASTMSG("Invalid argument size (lyd_print_size()).");
+
+    lyd_free_all(tree);
+}
+
 #if 0
 
 static void
@@ -338,6 +377,7 @@ main(void)
     const struct CMUnitTest tests[] = {
         UTEST(test_anydata, setup),
         UTEST(test_defaults, setup),
+        UTEST(test_size, setup),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
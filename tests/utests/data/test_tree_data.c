@@ -17,6 +17,7 @@
 #include "libyang.h"
 #include "ly_common.h"
 #include "path.h"
+#include "tree_data_internal.h"
 #include "xpath.h"
 
 static int
@@ -479,6 +480,45 @@ test_first_sibling(void **state)
     lyd_free_all(tree);
 }
 
+static void
+test_insert_top(void **state)
+{
+    struct lyd_node *tree = NULL, *node;
+    const struct lys_module *mod_a, *mod_b;
+    const char *names[] = {"bar", "foo", "c", "l2", "any", "op"};
+    uint32_t i;
+
+    mod_a = ly_ctx_get_module_implemented(UTEST_LYCTX, "a");
+    mod_b = ly_ctx_get_module_implemented(UTEST_LYCTX, "b");
+
+    /* appended */
+    assert_int_equal(LY_SUCCESS, lyd_new_term(NULL, mod_a, "foo", "x", 0, &tree));
+    assert_int_equal(LY_SUCCESS, lyd_new_opaq(NULL, UTEST_LYCTX, "op", "x", NULL, "a", &node));
+    assert_int_equal(LY_SUCCESS, lyd_insert_sibling(tree, node, &tree));
+    assert_int_equal(LY_SUCCESS, lyd_new_any(NULL, mod_b, "any", NULL, LYD_ANYDATA_STRING, 0, &node));
+    assert_int_equal(LY_SUCCESS, lyd_insert_sibling(tree, node, &tree));
+
+    /* preceding module data */
+    assert_int_equal(LY_SUCCESS, lyd_new_inner(NULL, mod_a, "c", 0, &node));
+    assert_int_equal(LY_SUCCESS, lyd_insert_sibling(tree, node, &tree));
+
+    /* preceding schema node */
+    assert_int_equal(LY_SUCCESS, lyd_new_list(NULL, mod_b, "l2", 0, &node));
+    assert_int_equal(LY_SUCCESS, lyd_insert_sibling(tree, node, &tree));
+    assert_int_equal(LY_SUCCESS, lyd_new_term(NULL, mod_a, "bar", "x", 0, &node));
+    assert_int_equal(LY_SUCCESS, lyd_insert_sibling(tree, node, &tree));
+
+    i = 0;
+    LY_LIST_FOR(tree, node) {
+        assert_true(i < sizeof names / sizeof *names);
+        assert_string_equal(names[i], LYD_NAME(node));
+        ++i;
+    }
+    assert_int_equal(sizeof names / sizeof *names, i);
+
+    lyd_free_all(tree);
+}
+
 static void
 test_find_path(void **state)
 {
@@ -542,6 +582,347 @@ test_data_hash(void **state)
     lyd_free_all(tree);
 }
 
+static void
+test_data_hash_top(void **state)
+{
+    struct lyd_node *tree = NULL, *node, *match;
+    struct lyd_top_ht *top_ht;
+    const struct lys_module *mod;
+    char key[8], pred[32];
+    uint32_t i;
+
+    mod = ly_ctx_get_module_implemented(UTEST_LYCTX, "a");
+
+    assert_int_equal(LY_SUCCESS, lyd_new_list(NULL, mod, "l1", 0, &tree, "0", "0"));
+    for (i = 1; i < 64; ++i) {
+        sprintf(key, "%" PRIu32, i);
+        assert_int_equal(LY_SUCCESS, lyd_new_list(NULL, mod, "l1", 0, &node, key, key));
+        assert_int_equal(LY_SUCCESS, lyd_insert_sibling(tree, node, &tree));
+    }
+    assert_int_equal(LY_SUCCESS, lyd_new_opaq(NULL, UTEST_LYCTX, "op", "x", NULL, "a", &node));
+    assert_int_equal(LY_SUCCESS, lyd_insert_sibling(tree, node, &tree));
+    assert_int_equal(LY_SUCCESS, lyd_new_term(NULL, mod, "foo", "x", 0, &node));
+    assert_int_equal(LY_SUCCESS, lyd_insert_sibling(tree, node, &tree));
+
+    /* hash table created from any sibling */
+    assert_int_equal(LY_EINVAL, lyd_top_ht_new(lyd_child(tree), &top_ht));
+    CHECK_LOG_LASTMSG("Invalid argument !siblings->parent (lyd_top_ht_new()).");
+    assert_int_equal(LY_SUCCESS, lyd_top_ht_new(tree->prev, &top_ht));
+    assert_non_null(top_ht->ht);
+    assert_ptr_equal(tree, top_ht->first);
+
+    for (i = 0; i < 64; ++i) {
+        sprintf(pred, "[a='%" PRIu32 "'][b='%" PRIu32 "']", i, i);
+        assert_int_equal(LY_SUCCESS, lyd_top_ht_find_val(top_ht, tree->schema, pred, 0, &match));
+        sprintf(key, "%" PRIu32, i);
+        assert_string_equal(key, lyd_get_value(lyd_child(match)));
+    }
+    assert_int_equal(LY_ENOTFOUND, lyd_top_ht_find_val(top_ht, tree->schema, "[a='64'][b='64']", 0, &match));
+    assert_null(match);
+    assert_int_equal(LY_SUCCESS, lyd_top_ht_find_val(top_ht, tree->schema, NULL, 0, &match));
+    assert_ptr_equal(tree, match);
+    assert_int_equal(LY_SUCCESS, lyd_top_ht_find_val(top_ht, tree->prev->prev->schema, NULL, 0, &match));
+    assert_string_equal("foo", LYD_NAME(match));
+    assert_int_equal(LY_SUCCESS, lyd_top_ht_find_first(top_ht, tree->next->next, &match));
+    assert_ptr_equal(tree->next->next, match);
+
+    /* the same results as the linear search */
+    assert_int_equal(LY_SUCCESS, lyd_find_sibling_val(tree->prev, tree->schema, "[a='40'][b='40']", 0, &node));
+    assert_int_equal(LY_SUCCESS, lyd_top_ht_find_val(top_ht, tree->schema, "[a='40'][b='40']", 0, &match));
+    assert_ptr_equal(node, match);
+    lyd_top_ht_free(top_ht);
+
+    lyd_free_all(tree);
+}
+
+static void
+test_data_index(void **state)
+{
+    struct lyd_node *tree, *node;
+    struct ly_set *set;
+    const struct lysc_node *nh, *metric;
+    const char *schema, *data, *feats[] = {"f", NULL};
+
+    schema =
+            "module test-data-index {"
+            "  yang-version 1.1;"
+            "  namespace \"urn:tests:tdi\";"
+            "  prefix t;"
+            "  container routes {"
+            "    list route {"
+            "      key \"prefix\";"
+            "      leaf prefix {"
+            "        type string;"
+            "      }"
+            "      leaf next-hop {"
+            "        type string;"
+            "      }"
+            "      leaf metric {"
+            "        type uint32;"
+            "      }"
+            "    }"
+            "    list pair {"
+            "      key \"k1 k2\";"
+            "      leaf k1 {"
+            "        type string;"
+            "      }"
+            "      leaf k2 {"
+            "        type string;"
+            "      }"
+            "    }"
+            "  }"
+            "  feature f;"
+            "}";
+
+    UTEST_ADD_MODULE(schema, LYS_IN_YANG, NULL, NULL);
+
+    assert_int_equal(LY_ENOTFOUND, ly_ctx_set_index(UTEST_LYCTX, "/test-data-index:routes/none", 0));
+    CHECK_LOG_CTX("Not found node \"none\" in path.", NULL, 0);
+    assert_int_equal(LY_EINVAL, ly_ctx_set_index(UTEST_LYCTX, "/test-data-index:routes", 0));
+    CHECK_LOG_CTX("Node \"routes\" is not a leaf.", NULL, 0);
+    assert_int_equal(LY_EINVAL, ly_ctx_set_index(UTEST_LYCTX, "/test-data-index:routes/pair/k1", 0));
+    CHECK_LOG_CTX("Leaf \"k1\" is a list key, list instances are always found by their keys.", NULL, 0);
+
+    /* the module is recompiled */
+    assert_int_equal(LY_SUCCESS, ly_ctx_set_index(UTEST_LYCTX, "/test-data-index:routes/route/next-hop", 0));
+    nh = lys_find_path(UTEST_LYCTX, NULL, "/test-data-index:routes/route/next-hop", 0);
+    assert_true(nh->flags & LYS_INDEXED);
+    assert_true(nh->parent->flags & LYS_INDEXED);
+    assert_int_equal(LY_EEXIST, ly_ctx_set_index(UTEST_LYCTX, "/test-data-index:routes/route/next-hop", 0));
+    assert_int_equal(LY_EEXIST, ly_ctx_set_index(UTEST_LYCTX, "/test-data-index:routes/test-data-index:route/next-hop",
+            0));
+
+    /* and remains indexed after another recompilation */
+    assert_int_equal(LY_SUCCESS, lys_set_implemented(nh->module, feats));
+    nh = lys_find_path(UTEST_LYCTX, NULL, "/test-data-index:routes/route/next-hop", 0);
+    metric = lys_find_path(UTEST_LYCTX, NULL, "/test-data-index:routes/route/metric", 0);
+    assert_true(nh->flags & LYS_INDEXED);
+    assert_false(metric->flags & LYS_INDEXED);
+
+    data =
+            "<routes xmlns='urn:tests:tdi'>"
+            "  <route><prefix>r1</prefix><next-hop>a</next-hop><metric>5</metric></route>"
+            "  <route><prefix>r2</prefix><next-hop>b</next-hop><metric>5</metric></route>"
+            "  <route><prefix>r3</prefix><next-hop>a</next-hop></route>"
+            "  <route><prefix>r4</prefix><next-hop>c</next-hop></route>"
+            "  <route><prefix>r5</prefix><next-hop>a</next-hop></route>"
+            "</routes>";
+    CHECK_PARSE_LYD_PARAM(data, LYD_XML, 0, LYD_VALIDATE_PRESENT, LY_SUCCESS, tree);
+
+    /* indexed leaf, in the data order */
+    assert_int_equal(LY_SUCCESS, lyd_find_sibling_leaf_val(lyd_child(tree), nh, "a", 0, &set));
+    assert_int_equal(3, set->count);
+    assert_string_equal("r1", lyd_get_value(lyd_child(set->dnodes[0])));
+    assert_string_equal("r3", lyd_get_value(lyd_child(set->dnodes[1])));
+    assert_string_equal("r5", lyd_get_value(lyd_child(set->dnodes[2])));
+    ly_set_free(set, NULL);
+
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/test-data-index:routes/route[next-hop='a']", &set));
+    assert_int_equal(3, set->count);
+    assert_string_equal("r1", lyd_get_value(lyd_child(set->dnodes[0])));
+    assert_string_equal("r5", lyd_get_value(lyd_child(set->dnodes[2])));
+    ly_set_free(set, NULL);
+
+    assert_int_equal(LY_ENOTFOUND, lyd_find_sibling_leaf_val(lyd_child(tree), nh, "d", 0, &set));
+    assert_int_equal(0, set->count);
+    ly_set_free(set, NULL);
+
+    /* value change */
+    assert_int_equal(LY_SUCCESS, lyd_find_path(tree, "route[prefix='r3']/next-hop", 0, &node));
+    assert_int_equal(LY_SUCCESS, lyd_change_term(node, "d"));
+    assert_int_equal(LY_SUCCESS, lyd_find_sibling_leaf_val(lyd_child(tree), nh, "d", 0, &set));
+    assert_int_equal(1, set->count);
+    assert_ptr_equal(lyd_parent(node), set->dnodes[0]);
+    ly_set_free(set, NULL);
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/test-data-index:routes/route[next-hop='a']", &set));
+    assert_int_equal(2, set->count);
+    ly_set_free(set, NULL);
+
+    /* removed instance and leaf */
+    assert_int_equal(LY_SUCCESS, lyd_find_path(tree, "route[prefix='r1']", 0, &node));
+    lyd_free_tree(node);
+    assert_int_equal(LY_SUCCESS, lyd_find_path(tree, "route[prefix='r4']/next-hop", 0, &node));
+    lyd_free_tree(node);
+    assert_int_equal(LY_ENOTFOUND, lyd_find_sibling_leaf_val(lyd_child(tree), nh, "c", 0, &set));
+    ly_set_free(set, NULL);
+    assert_int_equal(LY_SUCCESS, lyd_find_sibling_leaf_val(lyd_child(tree), nh, "a", 0, &set));
+    assert_int_equal(1, set->count);
+    assert_string_equal("r5", lyd_get_value(lyd_child(set->dnodes[0])));
+    ly_set_free(set, NULL);
+
+    /* new instance */
+    assert_int_equal(LY_SUCCESS, lyd_new_path(tree, NULL, "route[prefix='r0']/next-hop", "a", 0, NULL));
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/test-data-index:routes/route[next-hop='a']", &set));
+    assert_int_equal(2, set->count);
+    ly_set_free(set, NULL);
+
+    /* leaf without an index */
+    assert_int_equal(LY_SUCCESS, lyd_find_sibling_leaf_val(lyd_child(tree), metric, "5", 0, &set));
+    assert_int_equal(1, set->count);
+    assert_string_equal("r2", lyd_get_value(lyd_child(set->dnodes[0])));
+    ly_set_free(set, NULL);
+
+    lyd_free_all(tree);
+
+    /* a part of the keys, found without the index */
+    data =
+            "<routes xmlns='urn:tests:tdi'>"
+            "  <pair><k1>a</k1><k2>1</k2></pair>"
+            "  <pair><k1>a</k1><k2>2</k2></pair>"
+            "  <pair><k1>b</k1><k2>1</k2></pair>"
+            "  <pair><k1>a</k1><k2>3</k2></pair>"
+            "  <pair><k1>b</k1><k2>2</k2></pair>"
+            "</routes>";
+    CHECK_PARSE_LYD_PARAM(data, LYD_XML, 0, LYD_VALIDATE_PRESENT, LY_SUCCESS, tree);
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/test-data-index:routes/pair[k1='a']", &set));
+    assert_int_equal(3, set->count);
+    ly_set_free(set, NULL);
+    lyd_free_all(tree);
+}
+
+static void
+test_data_index_collision(void **state)
+{
+    struct lyd_node *tree, *node;
+    struct ly_set *set;
+    const struct lysc_node *nh;
+    const char *schema, *data;
+    uint32_t hash;
+
+    schema = "module test-data-index {yang-version 1.1; namespace urn:tests:tdi; prefix t;"
+            "container routes {list route {key prefix; leaf prefix {type string;} leaf next-hop {type string;}}}}";
+    UTEST_ADD_MODULE(schema, LYS_IN_YANG, NULL, NULL);
+    assert_int_equal(LY_SUCCESS, ly_ctx_set_index(UTEST_LYCTX, "/test-data-index:routes/route/next-hop", 0));
+    nh = lys_find_path(UTEST_LYCTX, NULL, "/test-data-index:routes/route/next-hop", 0);
+
+    /* the index hash of next-hop "n170970" is the hash of route "p605046",
+     * the index hash of next-hop "fe10b119" is the hash of the first route instance */
+    data =
+            "<routes xmlns='urn:tests:tdi'>"
+            "  <route><prefix>p605046</prefix><next-hop>n170970</next-hop></route>"
+            "  <route><prefix>r1</prefix><next-hop>fe10b119</next-hop></route>"
+            "  <route><prefix>r2</prefix><next-hop>n170970</next-hop></route>"
+            "  <route><prefix>r3</prefix><next-hop>fe10b119</next-hop></route>"
+            "</routes>";
+    CHECK_PARSE_LYD_PARAM(data, LYD_XML, 0, LYD_VALIDATE_PRESENT, LY_SUCCESS, tree);
+    assert_non_null(((struct lyd_node_inner *)tree)->children_ht);
+
+    hash = lyht_hash_multi(0, "test-data-index", 15);
+    hash = lyht_hash_multi(hash, "route", 5);
+    hash = lyht_hash_multi(hash, "test-data-index", 15);
+    hash = lyht_hash_multi(hash, "next-hop", 8);
+    assert_int_equal(lyd_child(tree)->hash, lyht_hash_multi(lyht_hash_multi(hash, "n170970", 7), NULL, 0));
+    assert_int_equal(lyht_hash_multi(lyht_hash_multi(lyht_hash_multi(0, "test-data-index", 15), "route", 5), NULL, 0),
+            lyht_hash_multi(lyht_hash_multi(hash, "fe10b119", 8), NULL, 0));
+
+    /* all the instances are found */
+    assert_int_equal(LY_SUCCESS, lyd_find_sibling_leaf_val(lyd_child(tree), nh, "n170970", 0, &set));
+    assert_int_equal(2, set->count);
+    assert_string_equal("p605046", lyd_get_value(lyd_child(set->dnodes[0])));
+    assert_string_equal("r2", lyd_get_value(lyd_child(set->dnodes[1])));
+    ly_set_free(set, NULL);
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/test-data-index:routes/route[next-hop='fe10b119']", &set));
+    assert_int_equal(2, set->count);
+    assert_string_equal("r1", lyd_get_value(lyd_child(set->dnodes[0])));
+    assert_string_equal("r3", lyd_get_value(lyd_child(set->dnodes[1])));
+    ly_set_free(set, NULL);
+
+    /* the colliding hashes are still correct after changes */
+    assert_int_equal(LY_SUCCESS, lyd_find_path(tree, "route[prefix='r3']/next-hop", 0, &node));
+    assert_int_equal(LY_SUCCESS, lyd_change_term(node, "n170970"));
+    lyd_free_tree(lyd_child(tree));
+    assert_int_equal(LY_SUCCESS, lyd_find_sibling_val(lyd_child(tree), lysc_data_parent(nh), "[prefix='r1']", 0, NULL));
+    assert_int_equal(LY_SUCCESS, lyd_find_sibling_leaf_val(lyd_child(tree), nh, "n170970", 0, &set));
+    assert_int_equal(2, set->count);
+    assert_string_equal("r2", lyd_get_value(lyd_child(set->dnodes[0])));
+    assert_string_equal("r3", lyd_get_value(lyd_child(set->dnodes[1])));
+    ly_set_free(set, NULL);
+    assert_int_equal(LY_SUCCESS, lyd_find_sibling_leaf_val(lyd_child(tree), nh, "fe10b119", 0, &set));
+    assert_int_equal(1, set->count);
+    ly_set_free(set, NULL);
+
+    lyd_free_all(tree);
+}
+
+static void
+test_data_index_top(void **state)
+{
+    struct lyd_node *tree = NULL, *node;
+    struct ly_set *set;
+    const struct lys_module *mod;
+    const struct lysc_node *leaf;
+    const char *schema;
+    char key[16];
+    uint32_t i;
+
+    schema = "module test-data-index3 {namespace urn:tests:tdi3; prefix t; yang-version 1.1;"
+            "list l {key k; leaf k {type uint32;} leaf v {type string;}}}";
+    UTEST_ADD_MODULE(schema, LYS_IN_YANG, NULL, NULL);
+    assert_int_equal(LY_SUCCESS, ly_ctx_set_index(UTEST_LYCTX, "/test-data-index3:l/v", 0));
+    leaf = lys_find_path(UTEST_LYCTX, NULL, "/test-data-index3:l/v", 0);
+    mod = leaf->module;
+
+    /* top-level instances have no hash table with the index */
+    for (i = 0; i < 32; ++i) {
+        sprintf(key, "%" PRIu32, i);
+        assert_int_equal(LY_SUCCESS, lyd_new_list(NULL, mod, "l", 0, &node, key));
+        assert_int_equal(LY_SUCCESS, lyd_new_term(node, NULL, "v", (i % 2) ? "odd" : "even", 0, NULL));
+        assert_int_equal(LY_SUCCESS, lyd_insert_sibling(tree, node, &tree));
+    }
+    assert_null(lyd_sibling_ht(tree));
+
+    assert_int_equal(LY_SUCCESS, lyd_find_sibling_leaf_val(tree->prev, leaf, "odd", 0, &set));
+    assert_int_equal(16, set->count);
+    assert_string_equal("1", lyd_get_value(lyd_child(set->dnodes[0])));
+    ly_set_free(set, NULL);
+
+    /* value change of an instance */
+    assert_int_equal(LY_SUCCESS, lyd_change_term(lyd_child(tree)->next, "odd"));
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/test-data-index3:l[v='odd']", &set));
+    assert_int_equal(17, set->count);
+    assert_string_equal("0", lyd_get_value(lyd_child(set->dnodes[0])));
+    ly_set_free(set, NULL);
+
+    lyd_free_all(tree);
+}
+
+static void
+test_data_index_compile(void **state)
+{
+    struct lyd_node *tree;
+    struct ly_set *set;
+    const struct lysc_node *leaf;
+    const char *schema;
+
+    schema = "module test-data-index2 {namespace urn:tests:tdi2; prefix t; yang-version 1.1;"
+            "container c {list l {key k; leaf k {type string;} leaf v {type string;} leaf w {type string;}}}}";
+    UTEST_ADD_MODULE(schema, LYS_IN_YANG, NULL, NULL);
+
+    /* the index is applied only once the context is compiled */
+    assert_int_equal(LY_SUCCESS, ly_ctx_set_options(UTEST_LYCTX, LY_CTX_EXPLICIT_COMPILE));
+    assert_int_equal(LY_SUCCESS, ly_ctx_set_index(UTEST_LYCTX, "/test-data-index2:c/l/v", 0));
+    assert_int_equal(LY_EEXIST, ly_ctx_set_index(UTEST_LYCTX, "/test-data-index2:c/l/v", 0));
+    leaf = lys_find_path(UTEST_LYCTX, NULL, "/test-data-index2:c/l/v", 0);
+    assert_false(leaf->flags & LYS_INDEXED);
+    assert_int_equal(LY_SUCCESS, ly_ctx_compile(UTEST_LYCTX));
+    leaf = lys_find_path(UTEST_LYCTX, NULL, "/test-data-index2:c/l/v", 0);
+    assert_true(leaf->flags & LYS_INDEXED);
+    assert_int_equal(LY_SUCCESS, ly_ctx_unset_options(UTEST_LYCTX, LY_CTX_EXPLICIT_COMPILE));
+
+    CHECK_PARSE_LYD_PARAM("<c xmlns=\"urn:tests:tdi2\"><l><k>1</k><v>x</v></l><l><k>2</k><v>y</v></l>"
+            "<l><k>3</k><v>x</v></l><l><k>4</k></l><l><k>5</k><v>x</v></l></c>", LYD_XML, 0, LYD_VALIDATE_PRESENT,
+            LY_SUCCESS, tree);
+    assert_int_equal(LY_SUCCESS, lyd_find_xpath(tree, "/test-data-index2:c/l[v='x']", &set));
+    assert_int_equal(3, set->count);
+    ly_set_free(set, NULL);
+    lyd_free_all(tree);
+
+    /* the schema cannot change anymore */
+    assert_int_equal(LY_SUCCESS, ly_ctx_free_parsed(UTEST_LYCTX));
+    assert_int_equal(LY_EDENIED, ly_ctx_set_index(UTEST_LYCTX, "/test-data-index2:c/l/w", 0));
+    CHECK_LOG_CTX("Unable to change module \"test-data-index2\" in a context with freed parsed modules.", NULL, 0);
+}
+
 static void
 test_lyxp_vars(void **UNUSED(state))
 {
@@ -811,8 +1192,14 @@ main(void)
         UTEST(test_target, setup),
         UTEST(test_list_pos, setup),
         UTEST(test_first_sibling, setup),
+        UTEST(test_insert_top, setup),
         UTEST(test_find_path, setup),
         UTEST(test_data_hash, setup),
+        UTEST(test_data_hash_top, setup),
+        UTEST(test_data_index, setup),
+        UTEST(test_data_index_collision, setup),
+        UTEST(test_data_index_top, setup),
+        UTEST(test_data_index_compile, setup),
         UTEST(test_lyxp_vars),
         UTEST(test_data_leafref_nodes),
         UTEST(test_data_leafref_nodes2),
@@ -1125,6 +1125,10 @@ test_must(void **state)
             "            }\n"
             "            type string;\n"
             "        }\n"
+            "        leaf l4 {\n"
+            "            must \"string-length(../i:l) < 6 and ../i:l != 12.5\";\n"
+            "            type string;\n"
+            "        }\n"
             "    }\n"
             "}";
 
@@ -1147,6 +1151,27 @@ test_must(void **state)
             "  <l3>val</l3>\n"
             "</cont>\n", LYD_XML, 0, LYD_VALIDATE_PRESENT, LY_EVALID, tree);
     CHECK_LOG_CTX_APPTAG("l leaf is not left", "/i:cont/l3", 0, "not-left");
+
+    /* compiled functions, numbers, and prefixes */
+    LYD_TREE_CREATE("<cont xmlns=\"urn:tests:i\">\n"
+            "  <l>right</l>\n"
+            "  <l4>val</l4>\n"
+            "</cont>\n", tree);
+    lyd_free_all(tree);
+
+    CHECK_PARSE_LYD_PARAM("<cont xmlns=\"urn:tests:i\">\n"
+            "  <l>12.50</l>\n"
+            "  <l4>val</l4>\n"
+            "</cont>\n", LYD_XML, 0, LYD_VALIDATE_PRESENT, LY_EVALID, tree);
+    CHECK_LOG_CTX_APPTAG("Must condition \"string-length(../i:l) < 6 and ../i:l != 12.5\" not satisfied.", "/i:cont/l4",
+            0, "must-violation");
+
+    CHECK_PARSE_LYD_PARAM("<cont xmlns=\"urn:tests:i\">\n"
+            "  <l>too long</l>\n"
+            "  <l4>val</l4>\n"
+            "</cont>\n", LYD_XML, 0, LYD_VALIDATE_PRESENT, LY_EVALID, tree);
+    CHECK_LOG_CTX_APPTAG("Must condition \"string-length(../i:l) < 6 and ../i:l != 12.5\" not satisfied.", "/i:cont/l4",
+            0, "must-violation");
 }
 
 static void
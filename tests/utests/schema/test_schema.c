@@ -1414,6 +1414,49 @@ test_feature(void **state)
      */
 }
 
+static void
+test_feature_recompile(void **state)
+{
+    struct lys_module *base, *x, *y, *z;
+    int marker;
+
+    UTEST_ADD_MODULE("module base {namespace urn:base; prefix b; yang-version 1.1; feature bf;"
+            "container c {leaf l {type string;} leaf bl {if-feature bf; type string;}}}", LYS_IN_YANG, NULL, &base);
+    UTEST_ADD_MODULE("module x {namespace urn:x; prefix x; import base {prefix b;} feature xf;"
+            "leaf xl {if-feature xf; type leafref {path /b:c/b:l;}}}", LYS_IN_YANG, NULL, &x);
+    UTEST_ADD_MODULE("module y {namespace urn:y; prefix y; import base {prefix b;}"
+            "leaf yl {type leafref {path /b:c/b:l;}}}", LYS_IN_YANG, NULL, &y);
+
+    /* mark the compiled nodes to learn whether they were recompiled */
+    base->compiled->data->priv = &marker;
+    y->compiled->data->priv = &marker;
+
+    /* only the changed module is recompiled */
+    assert_int_equal(LY_SUCCESS, lys_set_implemented(x, (const char *[]){"xf", NULL}));
+    assert_non_null(lys_find_path(UTEST_LYCTX, NULL, "/x:xl", 0));
+    assert_ptr_equal(&marker, base->compiled->data->priv);
+    assert_ptr_equal(&marker, y->compiled->data->priv);
+
+    /* disabled leafref to a disabled node, the imported module needs to be recompiled to resolve it */
+    UTEST_ADD_MODULE("module z {namespace urn:z; prefix z; import base {prefix b;} feature zf; feature zf2;"
+            "leaf zl {if-feature zf; type leafref {path /b:c/b:bl;}} leaf zl2 {if-feature zf2; type string;}}",
+            LYS_IN_YANG, NULL, &z);
+    base->compiled->data->priv = &marker;
+    y->compiled->data->priv = &marker;
+    assert_int_equal(LY_SUCCESS, lys_set_implemented(z, (const char *[]){"zf2", NULL}));
+    assert_non_null(lys_find_path(UTEST_LYCTX, NULL, "/z:zl2", 0));
+    assert_null(base->compiled->data->priv);
+    assert_null(y->compiled->data->priv);
+
+    /* importers are recompiled with the imported module */
+    x->compiled->data->priv = &marker;
+    y->compiled->data->priv = &marker;
+    assert_int_equal(LY_SUCCESS, lys_set_implemented(base, (const char *[]){"bf", NULL}));
+    assert_non_null(lys_find_path(UTEST_LYCTX, NULL, "/base:c/bl", 0));
+    assert_null(x->compiled->data->priv);
+    assert_null(y->compiled->data->priv);
+}
+
 static void
 test_extension_argument(void **state)
 {
@@ -1883,6 +1926,7 @@ main(void)
         UTEST(test_disabled_enum),
         UTEST(test_identity),
         UTEST(test_feature),
+        UTEST(test_feature_recompile),
         UTEST(test_extension_argument),
         UTEST(test_extension_argument_element),
         UTEST(test_extension_compile),
@@ -1612,6 +1612,60 @@ test_identity(void **state)
 #undef RESET_CTX
 }
 
+static const struct lysc_ident *
+get_identity(const struct lys_module *mod, const char *name)
+{
+    LY_ARRAY_COUNT_TYPE u;
+
+    LY_ARRAY_FOR(mod->identities, u) {
+        if (!strcmp(mod->identities[u].name, name)) {
+            return &mod->identities[u];
+        }
+    }
+    return NULL;
+}
+
+static void
+test_identity_derivation(void **state)
+{
+    struct lys_module *mod_a, *mod_b;
+    const struct lysc_ident *base, *id1, *id2, *id3, *id4, *other;
+
+    /* identity derived from identities defined later in the module, with a diamond */
+    assert_int_equal(LY_SUCCESS, lys_parse_mem(UTEST_LYCTX, "module a {yang-version 1.1; namespace urn:a; prefix a;"
+            "identity id3 {base id1; base id2;}"
+            "identity id1 {base base;}"
+            "identity id2 {base base;}"
+            "identity base;"
+            "identity other;}", LYS_IN_YANG, &mod_a));
+    base = get_identity(mod_a, "base");
+    id1 = get_identity(mod_a, "id1");
+    id2 = get_identity(mod_a, "id2");
+    id3 = get_identity(mod_a, "id3");
+    other = get_identity(mod_a, "other");
+
+    assert_int_equal(LY_SUCCESS, lyplg_type_identity_isderived(base, id1));
+    assert_int_equal(LY_SUCCESS, lyplg_type_identity_isderived(base, id3));
+    assert_int_equal(LY_SUCCESS, lyplg_type_identity_isderived(id1, id3));
+    assert_int_equal(LY_SUCCESS, lyplg_type_identity_isderived(id2, id3));
+    assert_int_equal(LY_ENOTFOUND, lyplg_type_identity_isderived(id1, id2));
+    assert_int_equal(LY_ENOTFOUND, lyplg_type_identity_isderived(id3, id1));
+    assert_int_equal(LY_ENOTFOUND, lyplg_type_identity_isderived(base, base));
+    assert_int_equal(LY_ENOTFOUND, lyplg_type_identity_isderived(other, id3));
+    assert_int_equal(LY_ENOTFOUND, lyplg_type_identity_isderived(base, other));
+
+    /* identity in another module */
+    assert_int_equal(LY_SUCCESS, lys_parse_mem(UTEST_LYCTX, "module b {namespace urn:b; prefix b; import a {prefix a;}"
+            "identity id4 {base a:id3;}}", LYS_IN_YANG, &mod_b));
+    id4 = get_identity(mod_b, "id4");
+
+    assert_int_equal(LY_SUCCESS, lyplg_type_identity_isderived(base, id4));
+    assert_int_equal(LY_SUCCESS, lyplg_type_identity_isderived(id2, id4));
+    assert_int_equal(LY_SUCCESS, lyplg_type_identity_isderived(id3, id4));
+    assert_int_equal(LY_ENOTFOUND, lyplg_type_identity_isderived(id4, id3));
+    assert_int_equal(LY_ENOTFOUND, lyplg_type_identity_isderived(other, id4));
+}
+
 static void
 test_type_identityref(void **state)
 {
@@ -4082,6 +4136,7 @@ main(void)
         UTEST(test_type_dec64, setup),
         UTEST(test_type_instanceid, setup),
         UTEST(test_identity, setup),
+        UTEST(test_identity_derivation),
         UTEST(test_type_identityref, setup),
         UTEST(test_type_leafref, setup),
         UTEST(test_type_empty, setup),
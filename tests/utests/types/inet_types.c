@@ -114,6 +114,11 @@ test_data_xml(void **state)
 
     /* ipv6-address */
     TEST_SUCCESS_XML("a", "l2", "FAAC:21:011:Da85::87:daaF%1", STRING, "faac:21:11:da85::87:daaf%1");
+    TEST_SUCCESS_XML("a", "l2", "::FFFF:10.1.2.3", STRING, "::ffff:10.1.2.3");
+    TEST_SUCCESS_XML("a", "l2", "1:0:0:2:0:0:0:3%eth0", STRING, "1:0:0:2::3%eth0");
+    TEST_SUCCESS_XML("a", "l2", "0:0:1:0:0:0:0:0", STRING, "0:0:1::");
+    TEST_ERROR_XML("a", "l2", "::1.2.3.04");
+    CHECK_LOG_CTX("Failed to convert IPv6 address \"::1.2.3.04\".", "/a:l2", 1);
 
     /* ip-address-no-zone */
     TEST_SUCCESS_XML("a", "l3", "127.0.0.1", UNION, "127.0.0.1", STRING, "127.0.0.1");
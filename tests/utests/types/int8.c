@@ -1650,10 +1650,15 @@ test_plugin_print(void **state)
         assert_int_equal(LY_SUCCESS, ly_ret);
     }
 
+    /* canonical value is generated only when first printed */
+    assert_null(values[0]._canonical);
+
     /* print value */
     ly_bool dynamic = 0;
 
     assert_string_equal("32", type->print(UTEST_LYCTX, &(values[0]), LY_VALUE_XML, NULL, &dynamic, NULL));
+    assert_string_equal("32", values[0]._canonical);
+    assert_ptr_equal(values[0]._canonical, type->print(UTEST_LYCTX, &(values[0]), LY_VALUE_CANON, NULL, &dynamic, NULL));
     assert_string_equal("74", type->print(UTEST_LYCTX, &(values[1]), LY_VALUE_XML, NULL, &dynamic, NULL));
     assert_string_equal("-15", type->print(UTEST_LYCTX, &(values[2]), LY_VALUE_XML, NULL, &dynamic, NULL));
     assert_string_equal("0", type->print(UTEST_LYCTX, &(values[3]), LY_VALUE_XML, NULL, &dynamic, NULL));
@@ -103,6 +103,8 @@ test_data_xml(void **state)
 
     /* canonize */
     TEST_SUCCESS_XML("a", "l", "2005-02-29T23:15:15-02:00", STRING, "2005-03-01T23:15:15-02:00");
+    TEST_SUCCESS_XML("a", "l", "2000-02-29T23:15:15-02:00", STRING, "2000-02-29T23:15:15-02:00");
+    TEST_SUCCESS_XML("a", "l", "2100-02-29T23:15:15-02:00", STRING, "2100-03-01T23:15:15-02:00");
 
     /* fractional hours */
     TEST_SUCCESS_XML("a", "l", "2005-05-25T23:15:15.88888+04:30", STRING, "2005-05-25T16:45:15.88888-02:00");
@@ -110,6 +112,7 @@ test_data_xml(void **state)
     /* unknown timezone -- timezone conversion MUST NOT happen */
     TEST_SUCCESS_XML("a", "l", "2017-02-01T00:00:00-00:00", STRING, "2017-02-01T00:00:00-00:00");
     TEST_SUCCESS_XML("a", "l", "2021-02-29T00:00:00-00:00", STRING, "2021-03-01T00:00:00-00:00");
+    TEST_SUCCESS_XML("a", "l", "1900-12-31T23:59:60.5-00:00", STRING, "1901-01-01T00:00:00.5-00:00");
 
     TEST_ERROR_XML("a", "l", "2005-05-31T23:15:15.-08:00", LY_EVALID);
     CHECK_LOG_CTX("Unsatisfied pattern - \"2005-05-31T23:15:15.-08:00\" does not conform to "
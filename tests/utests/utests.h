@@ -936,7 +936,7 @@ struct utest_context {
  */
 #define CHECK_LYD_VALUE_EMPTY(NODE, CANNONICAL_VAL) \
     assert_non_null((NODE).realtype->plugin->print(UTEST_LYCTX, &(NODE), LY_VALUE_CANON, NULL, NULL, NULL)); \
-    assert_string_equal((NODE)._canonical, CANNONICAL_VAL); \
+    assert_string_equal(lyd_value_get_canonical(UTEST_LYCTX, &(NODE)), CANNONICAL_VAL); \
     assert_non_null((NODE).realtype); \
     assert_int_equal((NODE).realtype->basetype, LY_TYPE_EMPTY);
 
@@ -954,7 +954,7 @@ struct utest_context {
  */
 #define CHECK_LYD_VALUE_UNION(NODE, CANNONICAL_VAL, TYPE_VAL, ...) \
     assert_non_null((NODE).realtype->plugin->print(UTEST_LYCTX, &(NODE), LY_VALUE_CANON, NULL, NULL, NULL)); \
-    assert_string_equal((NODE)._canonical, CANNONICAL_VAL); \
+    assert_string_equal(lyd_value_get_canonical(UTEST_LYCTX, &(NODE)), CANNONICAL_VAL); \
     assert_non_null((NODE).realtype); \
     assert_int_equal(LY_TYPE_UNION, (NODE).realtype->basetype); \
     assert_non_null((NODE).subvalue); \
@@ -976,7 +976,7 @@ struct utest_context {
  */
 #define CHECK_LYD_VALUE_BITS(NODE, ...) \
     assert_non_null((NODE).realtype->plugin->print(UTEST_LYCTX, &(NODE), LY_VALUE_CANON, NULL, NULL, NULL)); \
-    assert_string_equal((NODE)._canonical, _GETARG1(__VA_ARGS__, DUMMY)); \
+    assert_string_equal(lyd_value_get_canonical(UTEST_LYCTX, &(NODE)), _GETARG1(__VA_ARGS__, DUMMY)); \
     assert_non_null((NODE).realtype); \
     assert_int_equal(LY_TYPE_BITS, (NODE).realtype->basetype); \
     { \
@@ -1000,7 +1000,7 @@ struct utest_context {
  */
 #define CHECK_LYD_VALUE_INST(NODE, CANNONICAL_VAL, VALUE) \
     assert_non_null((NODE).realtype->plugin->print(UTEST_LYCTX, &(NODE), LY_VALUE_CANON, NULL, NULL, NULL)); \
-    assert_string_equal((NODE)._canonical, CANNONICAL_VAL); \
+    assert_string_equal(lyd_value_get_canonical(UTEST_LYCTX, &(NODE)), CANNONICAL_VAL); \
     assert_non_null((NODE).realtype); \
     assert_int_equal(LY_TYPE_INST, (NODE).realtype->basetype); \
     { \
@@ -1023,7 +1023,7 @@ struct utest_context {
  */
 #define CHECK_LYD_VALUE_ENUM(NODE, CANNONICAL_VAL, VALUE) \
     assert_non_null((NODE).realtype->plugin->print(UTEST_LYCTX, &(NODE), LY_VALUE_CANON, NULL, NULL, NULL)); \
-    assert_string_equal((NODE)._canonical, CANNONICAL_VAL); \
+    assert_string_equal(lyd_value_get_canonical(UTEST_LYCTX, &(NODE)), CANNONICAL_VAL); \
     assert_non_null((NODE).realtype); \
     assert_int_equal(LY_TYPE_ENUM, (NODE).realtype->basetype); \
     assert_string_equal(VALUE, (NODE).enum_item->name);
@@ -1038,7 +1038,7 @@ struct utest_context {
  */
 #define CHECK_LYD_VALUE_INT8(NODE, CANNONICAL_VAL, VALUE) \
     assert_non_null((NODE).realtype->plugin->print(UTEST_LYCTX, &(NODE), LY_VALUE_CANON, NULL, NULL, NULL)); \
-    assert_string_equal((NODE)._canonical, CANNONICAL_VAL); \
+    assert_string_equal(lyd_value_get_canonical(UTEST_LYCTX, &(NODE)), CANNONICAL_VAL); \
     assert_non_null((NODE).realtype); \
     assert_int_equal(LY_TYPE_INT8, (NODE).realtype->basetype); \
     assert_int_equal(VALUE, (NODE).int8);
@@ -1053,7 +1053,7 @@ struct utest_context {
  */
 #define CHECK_LYD_VALUE_INT16(NODE, CANNONICAL_VAL, VALUE) \
     assert_non_null((NODE).realtype->plugin->print(UTEST_LYCTX, &(NODE), LY_VALUE_CANON, NULL, NULL, NULL)); \
-    assert_string_equal((NODE)._canonical, CANNONICAL_VAL); \
+    assert_string_equal(lyd_value_get_canonical(UTEST_LYCTX, &(NODE)), CANNONICAL_VAL); \
     assert_non_null((NODE).realtype); \
     assert_int_equal(LY_TYPE_INT16, (NODE).realtype->basetype); \
     assert_int_equal(VALUE, (NODE).int16);
@@ -1068,7 +1068,7 @@ struct utest_context {
  */
 #define CHECK_LYD_VALUE_UINT8(NODE, CANNONICAL_VAL, VALUE) \
     assert_non_null((NODE).realtype->plugin->print(UTEST_LYCTX, &(NODE), LY_VALUE_CANON, NULL, NULL, NULL)); \
-    assert_string_equal((NODE)._canonical, CANNONICAL_VAL); \
+    assert_string_equal(lyd_value_get_canonical(UTEST_LYCTX, &(NODE)), CANNONICAL_VAL); \
     assert_non_null((NODE).realtype); \
     assert_int_equal(LY_TYPE_UINT8, (NODE).realtype->basetype); \
     assert_int_equal(VALUE, (NODE).uint8);
@@ -1083,7 +1083,7 @@ struct utest_context {
  */
 #define CHECK_LYD_VALUE_UINT32(NODE, CANNONICAL_VAL, VALUE) \
     assert_non_null((NODE).realtype->plugin->print(UTEST_LYCTX, &(NODE), LY_VALUE_CANON, NULL, NULL, NULL)); \
-    assert_string_equal((NODE)._canonical, CANNONICAL_VAL); \
+    assert_string_equal(lyd_value_get_canonical(UTEST_LYCTX, &(NODE)), CANNONICAL_VAL); \
     assert_non_null((NODE).realtype); \
     assert_int_equal(LY_TYPE_UINT32, (NODE).realtype->basetype); \
     assert_int_equal(VALUE, (NODE).uint32);
@@ -1097,7 +1097,7 @@ struct utest_context {
  */
 #define CHECK_LYD_VALUE_STRING(NODE, CANNONICAL_VAL) \
     assert_non_null((NODE).realtype->plugin->print(UTEST_LYCTX, &(NODE), LY_VALUE_CANON, NULL, NULL, NULL)); \
-    assert_string_equal((NODE)._canonical, CANNONICAL_VAL); \
+    assert_string_equal(lyd_value_get_canonical(UTEST_LYCTX, &(NODE)), CANNONICAL_VAL); \
     assert_non_null((NODE).realtype); \
     assert_int_equal(LY_TYPE_STRING, (NODE).realtype->basetype);
 
@@ -1110,7 +1110,7 @@ struct utest_context {
  */
 #define CHECK_LYD_VALUE_LEAFREF(NODE, CANNONICAL_VAL) \
     assert_non_null((NODE).realtype->plugin->print(UTEST_LYCTX, &(NODE), LY_VALUE_CANON, NULL, NULL, NULL)); \
-    assert_string_equal((NODE)._canonical, CANNONICAL_VAL); \
+    assert_string_equal(lyd_value_get_canonical(UTEST_LYCTX, &(NODE)), CANNONICAL_VAL); \
     assert_non_null((NODE).realtype); \
     assert_int_equal(LY_TYPE_LEAFREF, (NODE).realtype->basetype); \
     assert_non_null((NODE).ptr)
@@ -1125,7 +1125,7 @@ struct utest_context {
 */
 #define CHECK_LYD_VALUE_DEC64(NODE, CANNONICAL_VAL, VALUE) \
     assert_non_null((NODE).realtype->plugin->print(UTEST_LYCTX, &(NODE), LY_VALUE_CANON, NULL, NULL, NULL)); \
-    assert_string_equal((NODE)._canonical, CANNONICAL_VAL); \
+    assert_string_equal(lyd_value_get_canonical(UTEST_LYCTX, &(NODE)), CANNONICAL_VAL); \
     assert_non_null((NODE).realtype); \
     assert_int_equal(LY_TYPE_DEC64, (NODE).realtype->basetype); \
     assert_int_equal(VALUE, (NODE).dec64);
@@ -1146,7 +1146,7 @@ struct utest_context {
         assert_int_equal(_val->size, SIZE); \
         assert_int_equal(0, memcmp(_val->data, VALUE, SIZE)); \
         assert_non_null((NODE).realtype->plugin->print(UTEST_LYCTX, &(NODE), LY_VALUE_CANON, NULL, NULL, NULL)); \
-        assert_string_equal((NODE)._canonical, CANNONICAL_VAL); \
+        assert_string_equal(lyd_value_get_canonical(UTEST_LYCTX, &(NODE)), CANNONICAL_VAL); \
         assert_non_null((NODE).realtype); \
         assert_int_equal(LY_TYPE_BINARY, (NODE).realtype->basetype); \
     }
@@ -1161,7 +1161,7 @@ struct utest_context {
 */
 #define CHECK_LYD_VALUE_BOOL(NODE, CANNONICAL_VAL, VALUE) \
     assert_non_null((NODE).realtype->plugin->print(UTEST_LYCTX, &(NODE), LY_VALUE_CANON, NULL, NULL, NULL)); \
-    assert_string_equal((NODE)._canonical, CANNONICAL_VAL); \
+    assert_string_equal(lyd_value_get_canonical(UTEST_LYCTX, &(NODE)), CANNONICAL_VAL); \
     assert_non_null((NODE).realtype); \
     assert_int_equal(LY_TYPE_BOOL, (NODE).realtype->basetype); \
     assert_int_equal(VALUE, (NODE).boolean);
@@ -1176,7 +1176,7 @@ struct utest_context {
 */
 #define CHECK_LYD_VALUE_IDENT(NODE, CANNONICAL_VAL, VALUE) \
     assert_non_null((NODE).realtype->plugin->print(UTEST_LYCTX, &(NODE), LY_VALUE_CANON, NULL, NULL, NULL)); \
-    assert_string_equal((NODE)._canonical, CANNONICAL_VAL); \
+    assert_string_equal(lyd_value_get_canonical(UTEST_LYCTX, &(NODE)), CANNONICAL_VAL); \
     assert_non_null((NODE).realtype); \
     assert_int_equal(LY_TYPE_IDENT, (NODE).realtype->basetype); \
     assert_string_equal(VALUE, (NODE).ident->name);